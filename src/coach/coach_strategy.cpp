@@ -99,7 +99,7 @@ CoachStrategy::init()
     // check role availability
     //
 
-    if ( M_formation_factory.allFormationMap().empty() )
+    if ( M_formation_factory.roleNameMap().empty() )
     {
         std::cerr << __FILE__ << ":(init) no formation" << std::endl;
         return false;
@@ -323,7 +323,7 @@ CoachStrategy::updateFormation( const CoachWorldModel & wm )
                   ball_step );
 
     std::vector< Vector2D > positions;
-    f->getPositions( ball_pos, positions );
+    M_formation_factory.getPositions( f, ball_pos, positions );
 
     if ( positions.size() != 11 )
     {
@@ -30,8 +30,10 @@
 
 #include "ball_move_model.h"
 
+#include "shared_data_store.h"
 #include "std_normal_dist.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <cmath>
@@ -41,6 +43,9 @@
 
 */
 BallMoveModel::BallMoveModel()
+    : M_table( static_cast< const double * >( 0 ) ),
+      M_speed_size( 0 ),
+      M_step_size( 0 )
 {
     StdNormalDist::i();
 }
@@ -68,11 +73,68 @@ BallMoveModel::init( const std::string & filepath )
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+bool
+BallMoveModel::attach( const SharedDataStore & store )
+{
+    size_t shape_size = 0;
+    const double * shape = store.table( "ball_move_model.shape", &shape_size );
+    size_t size = 0;
+    const double * table = store.table( "ball_move_model.stddev", &size );
+
+    if ( ! shape
+         || ! table
+         || shape_size != 2
+         || shape[0] < 1.0
+         || shape[1] < 1.0
+         || static_cast< size_t >( shape[0] * shape[1] ) != size )
+    {
+        return false;
+    }
+
+    M_standard_deviations.clear();
+    M_values.clear();
+
+    M_table = table;
+    M_speed_size = static_cast< size_t >( shape[0] );
+    M_step_size = static_cast< size_t >( shape[1] );
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+BallMoveModel::publish( SharedDataStore & store ) const
+{
+    if ( ! M_table )
+    {
+        return;
+    }
+
+    std::vector< double > shape;
+    shape.push_back( static_cast< double >( M_speed_size ) );
+    shape.push_back( static_cast< double >( M_step_size ) );
+
+    store.addTable( "ball_move_model.shape", shape );
+    store.addTable( "ball_move_model.stddev",
+                    std::vector< double >( M_table, M_table + M_speed_size * M_step_size ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 bool
 BallMoveModel::read( std::istream & is )
 {
     M_standard_deviations.clear();
+    M_values.clear();
+    M_table = static_cast< const double * >( 0 );
+    M_speed_size = 0;
+    M_step_size = 0;
 
     if ( ! readHeader( is ) )
     {
@@ -84,6 +146,39 @@ BallMoveModel::read( std::istream & is )
         return false;
     }
 
+    //
+    // flatten the table. all rows have the same size.
+    //
+    if ( ! M_standard_deviations.empty() )
+    {
+        M_speed_size = M_standard_deviations.size();
+        M_step_size = M_standard_deviations.front().size();
+
+        for ( std::vector< StdDev >::const_iterator it = M_standard_deviations.begin();
+              it != M_standard_deviations.end();
+              ++it )
+        {
+            if ( it->size() != M_step_size )
+            {
+                std::cerr << __FILE__ << ' ' << __LINE__
+                          << ": ERROR illegal table size." << std::endl;
+                M_values.clear();
+                M_speed_size = 0;
+                M_step_size = 0;
+                return false;
+            }
+
+            M_values.insert( M_values.end(), it->begin(), it->end() );
+        }
+
+        std::vector< StdDev >().swap( M_standard_deviations );
+
+        if ( ! M_values.empty() )
+        {
+            M_table = &M_values[0];
+        }
+    }
+
     return true;
 }
 
@@ -232,24 +327,34 @@ BallMoveModel::readBody( std::istream & is )
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+inline
+double
+BallMoveModel::standardDeviation( const double first_speed,
+                                  const int step ) const
+{
+    const size_t speed_idx = std::min( static_cast< size_t >( std::ceil( first_speed * 100.0 ) ) - 1,
+                                       M_speed_size - 1 );
+    const size_t step_idx = std::min( static_cast< size_t >( step ) - 1,
+                                      M_step_size - 1 );
+
+    return M_table[speed_idx * M_step_size + step_idx];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 double
 BallMoveModel::probability( const double first_speed,
                             const int step,
                             const double error_dist ) const
 {
-    if ( M_standard_deviations.empty() )
+    if ( ! M_table
+         || M_step_size == 0 )
     {
         return 0.0;
     }
 
-    size_t speed_idx = std::min( static_cast< size_t >( std::ceil( first_speed * 100.0 ) ) - 1,
-                                 M_standard_deviations.size() - 1 );
-
-    const StdDev & stddev = M_standard_deviations[speed_idx];
-
-    size_t step_idx = std::min( static_cast< size_t >( step ) - 1,
-                                stddev.size() - 1 );
-
-    return 1.0 - StdNormalDist::i().cdf( stddev[step_idx], error_dist );
+    return 1.0 - StdNormalDist::i().cdf( standardDeviation( first_speed, step ), error_dist );
 }
@@ -30,6 +30,8 @@
 #include <string>
 #include <vector>
 
+class SharedDataStore;
+
 /*!
   \class BallMoveModel
   \brief ball movement model
@@ -40,9 +42,17 @@ private:
     //! standard deviation table
     typedef std::vector< double > StdDev;
 
-    //! table for each first speed
+    //! table for each first speed. used only while reading the file.
     std::vector< StdDev > M_standard_deviations;
 
+    //! flat table read from the file. index = speed_index * step_size + step_index
+    std::vector< double > M_values;
+
+    //! the table in use. points to M_values or the shared memory.
+    const double * M_table;
+    size_t M_speed_size; //!< the number of speed rows
+    size_t M_step_size; //!< the number of steps in each row
+
 public:
 
     /*!
@@ -58,6 +68,19 @@ public:
      */
     bool init( const std::string & filepath );
 
+    /*!
+      \brief use the table in the shared memory
+      \param store attached data store
+      \return true if the table is found in the store.
+     */
+    bool attach( const SharedDataStore & store );
+
+    /*!
+      \brief register the table to the data store to be published
+      \param store data store
+     */
+    void publish( SharedDataStore & store ) const;
+
 private:
 
     /*!
@@ -90,6 +113,16 @@ private:
     bool readTable( std::istream & is,
                     const double first_speed );
 
+    /*!
+      \brief get the standard deviation in the table.
+      the table must be available.
+      \param first_speed ball first speed
+      \param step considered step value
+      \return standard deviation value
+     */
+    double standardDeviation( const double first_speed,
+                              const int step ) const;
+
 public:
 
     /*!
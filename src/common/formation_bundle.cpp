@@ -0,0 +1,369 @@
+// -*-c++-*-
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "formation_bundle.h"
+
+#include <fstream>
+#include <iostream>
+#include <cstring>
+
+#include <sys/types.h> // open, fstat
+#include <sys/stat.h> // open, fstat
+#include <sys/mman.h> // mmap, munmap
+#include <fcntl.h> // open
+#include <unistd.h> // close
+
+namespace {
+
+const char MAGIC[4] = { 'H', 'F', 'B', 'N' };
+
+//! the number of role names in each entry
+const size_t ROLE_SIZE = 11;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief sequential reader of the mapped image
+ */
+class ImageReader {
+private:
+    const char * M_ptr;
+    const char * M_end;
+    bool M_ok;
+
+public:
+    ImageReader( const char * begin,
+                 const char * end )
+        : M_ptr( begin ),
+          M_end( end ),
+          M_ok( true )
+      { }
+
+    bool ok() const
+      {
+          return M_ok;
+      }
+
+    const char * ptr() const
+      {
+          return M_ptr;
+      }
+
+    boost::uint32_t readInt()
+      {
+          if ( ! M_ok
+               || M_end - M_ptr < 4 )
+          {
+              M_ok = false;
+              return 0;
+          }
+
+          const unsigned char * p = reinterpret_cast< const unsigned char * >( M_ptr );
+          M_ptr += 4;
+          return ( static_cast< boost::uint32_t >( p[0] )
+                   | ( static_cast< boost::uint32_t >( p[1] ) << 8 )
+                   | ( static_cast< boost::uint32_t >( p[2] ) << 16 )
+                   | ( static_cast< boost::uint32_t >( p[3] ) << 24 ) );
+      }
+
+    std::string readString()
+      {
+          const boost::uint32_t len = readInt();
+          if ( ! M_ok
+               || static_cast< size_t >( M_end - M_ptr ) < len )
+          {
+              M_ok = false;
+              return std::string();
+          }
+
+          std::string str( M_ptr, len );
+          M_ptr += len;
+          return str;
+      }
+};
+
+/*-------------------------------------------------------------------*/
+void
+write_int( std::ostream & os,
+           const boost::uint32_t value )
+{
+    const char buf[4] = { static_cast< char >( value & 0xff ),
+                          static_cast< char >( ( value >> 8 ) & 0xff ),
+                          static_cast< char >( ( value >> 16 ) & 0xff ),
+                          static_cast< char >( ( value >> 24 ) & 0xff ) };
+    os.write( buf, 4 );
+}
+
+/*-------------------------------------------------------------------*/
+void
+write_string( std::ostream & os,
+              const std::string & str )
+{
+    write_int( os, static_cast< boost::uint32_t >( str.length() ) );
+    os.write( str.data(), str.length() );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+FormationBundle::FormationBundle()
+    : M_fd( -1 ),
+      M_data( static_cast< const char * >( 0 ) ),
+      M_size( 0 ),
+      M_text( static_cast< const char * >( 0 ) ),
+      M_text_size( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+FormationBundle::~FormationBundle()
+{
+    close();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+FormationBundle::open( const std::string & filepath )
+{
+    close();
+
+    M_fd = ::open( filepath.c_str(), O_RDONLY );
+    if ( M_fd < 0 )
+    {
+        std::cerr << __FILE__ << ": (open) could not open the file ["
+                  << filepath << "]" << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    if ( ::fstat( M_fd, &st ) != 0
+         || st.st_size <= 0 )
+    {
+        std::cerr << __FILE__ << ": (open) illegal file size ["
+                  << filepath << "]" << std::endl;
+        close();
+        return false;
+    }
+
+    void * addr = ::mmap( 0, st.st_size, PROT_READ, MAP_PRIVATE, M_fd, 0 );
+    if ( addr == MAP_FAILED )
+    {
+        std::cerr << __FILE__ << ": (open) could not map the file ["
+                  << filepath << "]" << std::endl;
+        close();
+        return false;
+    }
+
+    M_data = static_cast< const char * >( addr );
+    M_size = static_cast< size_t >( st.st_size );
+
+    // the mapping is still valid after the file is closed.
+    ::close( M_fd );
+    M_fd = -1;
+
+    //
+    // header
+    //
+    if ( M_size < sizeof( MAGIC )
+         || std::memcmp( M_data, MAGIC, sizeof( MAGIC ) ) != 0 )
+    {
+        std::cerr << __FILE__ << ": (open) not a formation bundle ["
+                  << filepath << "]" << std::endl;
+        close();
+        return false;
+    }
+
+    ImageReader reader( M_data + sizeof( MAGIC ), M_data + M_size );
+
+    const boost::uint32_t version = reader.readInt();
+    if ( ! reader.ok()
+         || version != VERSION )
+    {
+        std::cerr << __FILE__ << ": (open) unsupported version " << version
+                  << " [" << filepath << "]" << std::endl;
+        close();
+        return false;
+    }
+
+    //
+    // index
+    //
+    const boost::uint32_t entry_size = reader.readInt();
+    for ( boost::uint32_t i = 0; reader.ok() && i < entry_size; ++i )
+    {
+        Entry e;
+        e.name_ = reader.readString();
+        e.role_names_.resize( ROLE_SIZE );
+        for ( size_t r = 0; r < ROLE_SIZE; ++r )
+        {
+            e.role_names_[r] = reader.readString();
+        }
+        e.offset_ = reader.readInt();
+        e.size_ = reader.readInt();
+
+        if ( reader.ok() )
+        {
+            M_entries[e.name_] = e;
+        }
+    }
+
+    if ( ! reader.ok() )
+    {
+        std::cerr << __FILE__ << ": (open) broken index ["
+                  << filepath << "]" << std::endl;
+        close();
+        return false;
+    }
+
+    M_text = reader.ptr();
+    M_text_size = static_cast< size_t >( M_data + M_size - M_text );
+
+    for ( Map::const_iterator it = M_entries.begin(), end = M_entries.end();
+          it != end;
+          ++it )
+    {
+        if ( static_cast< size_t >( it->second.offset_ ) + it->second.size_ > M_text_size )
+        {
+            std::cerr << __FILE__ << ": (open) broken data [" << it->first
+                      << "] in [" << filepath << "]" << std::endl;
+            close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+FormationBundle::close()
+{
+    if ( M_data )
+    {
+        ::munmap( const_cast< char * >( M_data ), M_size );
+    }
+
+    if ( M_fd >= 0 )
+    {
+        ::close( M_fd );
+    }
+
+    M_fd = -1;
+    M_data = static_cast< const char * >( 0 );
+    M_size = 0;
+    M_text = static_cast< const char * >( 0 );
+    M_text_size = 0;
+    M_entries.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+FormationBundle::getText( const std::string & name,
+                          std::string * text ) const
+{
+    Map::const_iterator it = M_entries.find( name );
+    if ( it == M_entries.end() )
+    {
+        return false;
+    }
+
+    text->assign( M_text + it->second.offset_, it->second.size_ );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+FormationBundle::write( const std::string & filepath,
+                        const std::vector< Entry > & entries,
+                        const std::vector< std::string > & texts )
+{
+    if ( entries.size() != texts.size() )
+    {
+        std::cerr << __FILE__ << ": (write) size mismatch" << std::endl;
+        return false;
+    }
+
+    std::ofstream fout( filepath.c_str(), std::ios_base::out | std::ios_base::binary );
+    if ( ! fout.is_open() )
+    {
+        std::cerr << __FILE__ << ": (write) could not open the file ["
+                  << filepath << "]" << std::endl;
+        return false;
+    }
+
+    fout.write( MAGIC, sizeof( MAGIC ) );
+    write_int( fout, VERSION );
+    write_int( fout, static_cast< boost::uint32_t >( entries.size() ) );
+
+    boost::uint32_t offset = 0;
+    for ( size_t i = 0; i < entries.size(); ++i )
+    {
+        write_string( fout, entries[i].name_ );
+        for ( size_t r = 0; r < ROLE_SIZE; ++r )
+        {
+            write_string( fout,
+                          ( r < entries[i].role_names_.size()
+                            ? entries[i].role_names_[r]
+                            : std::string() ) );
+        }
+        write_int( fout, offset );
+        write_int( fout, static_cast< boost::uint32_t >( texts[i].length() ) );
+
+        offset += static_cast< boost::uint32_t >( texts[i].length() );
+    }
+
+    for ( size_t i = 0; i < texts.size(); ++i )
+    {
+        fout.write( texts[i].data(), texts[i].length() );
+    }
+
+    fout.flush();
+    return fout.good();
+}
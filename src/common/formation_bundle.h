@@ -0,0 +1,139 @@
+// -*-c++-*-
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef FORMATION_BUNDLE_H
+#define FORMATION_BUNDLE_H
+
+#include <boost/cstdint.hpp>
+
+#include <map>
+#include <vector>
+#include <string>
+#include <cstddef>
+
+/*!
+  \class FormationBundle
+  \brief read only view of the formation bundle file.
+
+  The bundle packs all formation files into one file. It is created
+  by the formation_bundle_compiler tool, which reads each formation by
+  rcsc::Formation to validate it. The file layout is:
+
+    magic "HFBN", version, entry size,
+    entries: name, role names of unum 1-11, data offset, data size
+    data: the original text of each formation file
+
+  All integers are 32 bit little endian. The file is mapped to memory,
+  and the text of each formation is read only when it is requested.
+*/
+class FormationBundle {
+public:
+
+    enum {
+        VERSION = 1
+    };
+
+    /*!
+      \struct Entry
+      \brief index of one formation
+     */
+    struct Entry {
+        std::string name_; //!< file name. e.g. normal-formation-433.conf
+        std::vector< std::string > role_names_; //!< role names of unum 1-11
+        boost::uint32_t offset_; //!< text offset from the start of the data area
+        boost::uint32_t size_; //!< text size
+    };
+
+    //! key: file name
+    typedef std::map< std::string, Entry > Map;
+
+private:
+
+    int M_fd;
+    const char * M_data; //!< mapped file image
+    size_t M_size; //!< mapped size
+
+    const char * M_text; //!< start of the data area
+    size_t M_text_size; //!< size of the data area
+
+    Map M_entries;
+
+    // not used
+    FormationBundle( const FormationBundle & );
+    FormationBundle & operator=( const FormationBundle & );
+
+public:
+
+    FormationBundle();
+    ~FormationBundle();
+
+    /*!
+      \brief map the bundle file and read the index
+      \param filepath bundle file path
+      \return true if the file is a valid bundle
+     */
+    bool open( const std::string & filepath );
+
+    /*!
+      \brief unmap the file
+     */
+    void close();
+
+    bool isOpen() const
+      {
+          return M_data != static_cast< const char * >( 0 );
+      }
+
+    const Map & entries() const
+      {
+          return M_entries;
+      }
+
+    /*!
+      \brief get the formation text
+      \param name formation file name
+      \param text pointer to the result variable
+      \return true if the formation exists
+     */
+    bool getText( const std::string & name,
+                  std::string * text ) const;
+
+    /*!
+      \brief write the bundle file
+      \param filepath bundle file path
+      \param entries index of formations. offset_ and size_ are ignored.
+      \param texts texts of formations. same order as entries.
+      \return true if the file is written
+     */
+    static
+    bool write( const std::string & filepath,
+                const std::vector< Entry > & entries,
+                const std::vector< std::string > & texts );
+};
+
+#endif
@@ -89,9 +89,21 @@ FormationFactory::~FormationFactory()
 bool
 FormationFactory::init()
 {
-    if ( ! readAllFormations( Options::instance().formationConfDir() ) )
+    const std::string & bundle_file = Options::instance().formationBundleFile();
+    if ( bundle_file.empty()
+         || ! readBundle( bundle_file ) )
     {
-        return false;
+        if ( ! bundle_file.empty() )
+        {
+            std::cerr << __FILE__ << ": (init) "
+                      << "read the formation files from ["
+                      << Options::instance().formationConfDir() << "]" << std::endl;
+        }
+
+        if ( ! readAllFormations( Options::instance().formationConfDir() ) )
+        {
+            return false;
+        }
     }
 
     //
@@ -153,6 +165,81 @@ FormationFactory::init()
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the grid of the formation used by the strategy.
+  all grids are created in init() so that no grid is built during the game.
+ */
+void
+FormationFactory::createGrid( const std::string & filename,
+                              const Formation::ConstPtr & f )
+{
+    const double resolution = Options::instance().formationGridResolution();
+    if ( resolution <= 0.0
+         || ! f
+         || M_grid_map.find( f.get() ) != M_grid_map.end() )
+    {
+        return;
+    }
+
+    FormationGrid::ConstPtr grid( new FormationGrid( f, resolution ) );
+    if ( ! grid->isValid() )
+    {
+        std::cerr << __FILE__ << ": (createGrid) "
+                  << "could not create the grid [" << filename << "]" << std::endl;
+        return;
+    }
+
+    M_grid_map[f.get()] = grid;
+
+    if ( Options::instance().formationGridValidation() )
+    {
+        double average = 0.0;
+        const double max_error = grid->validate( 10000, &average );
+        std::cerr << "(FormationFactory::createGrid) " << filename
+                  << " nodes=" << grid->size()
+                  << " max_error=" << max_error
+                  << " average_error=" << average << std::endl;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+FormationFactory::getPositions( const Formation::ConstPtr & f,
+                                const Vector2D & ball_pos,
+                                std::vector< Vector2D > & positions ) const
+{
+    std::map< const Formation *, FormationGrid::ConstPtr >::const_iterator it = M_grid_map.find( f.get() );
+    if ( it != M_grid_map.end() )
+    {
+        it->second->getPositions( ball_pos, positions );
+        return;
+    }
+
+    f->getPositions( ball_pos, positions );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Vector2D
+FormationFactory::getPosition( const Formation::ConstPtr & f,
+                               const int unum,
+                               const Vector2D & ball_pos ) const
+{
+    std::map< const Formation *, FormationGrid::ConstPtr >::const_iterator it = M_grid_map.find( f.get() );
+    if ( it != M_grid_map.end() )
+    {
+        return it->second->getPosition( unum, ball_pos );
+    }
+
+    return f->getPosition( unum, ball_pos );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -196,9 +283,31 @@ FormationFactory::createFormation( const std::string & filepath )
     //
     // check goalie number
     //
+    std::vector< std::string > role_names;
     for ( int unum = 1; unum <= 11; ++unum )
     {
-        const std::string role_name = f->getRoleName( unum );
+        role_names.push_back( f->getRoleName( unum ) );
+    }
+
+    if ( ! checkGoalieUnum( role_names ) )
+    {
+        f.reset();
+        return f;
+    }
+
+    return f;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+FormationFactory::checkGoalieUnum( const std::vector< std::string > & role_names )
+{
+    for ( int unum = 1; unum <= static_cast< int >( role_names.size() ); ++unum )
+    {
+        const std::string & role_name = role_names[unum - 1];
         if ( role_name == "Savior"
              || role_name == "Goalie" )
         {
@@ -214,13 +323,12 @@ FormationFactory::createFormation( const std::string & filepath )
                           << " read unum=" << unum
                           << " expected=" << M_goalie_unum
                           << std::endl;
-                f.reset();
-                return f;
+                return false;
             }
         }
     }
 
-    return f;
+    return true;
 }
 
 /*-------------------------------------------------------------------*/
@@ -228,14 +336,57 @@ FormationFactory::createFormation( const std::string & filepath )
 
  */
 Formation::ConstPtr
-FormationFactory::getFormation( const std::string & filename ) const
+FormationFactory::findFormation( const std::string & filename ) const
 {
-    std::map< std::string, rcsc::Formation::ConstPtr >::const_iterator it = M_all_formation_map.find( filename );
+    Map::const_iterator it = M_all_formation_map.find( filename );
     if ( it != M_all_formation_map.end() )
     {
         return it->second;
     }
 
+    Formation::Ptr f;
+
+    std::string text;
+    if ( ! M_bundle.isOpen()
+         || ! M_bundle.getText( filename, &text ) )
+    {
+        return f;
+    }
+
+    //
+    // create the formation from the bundle when it is requested first.
+    // the text has been validated by the bundle compiler.
+    //
+    std::istringstream istr( text );
+
+    f = Formation::create( istr );
+    if ( ! f
+         || ! f->read( istr ) )
+    {
+        std::cerr << __FILE__ << ':' << __LINE__ << ':'
+                  << " ***ERROR*** failed to read formation [" << filename << "]"
+                  << " from the bundle" << std::endl;
+        f.reset();
+        return f;
+    }
+
+    M_all_formation_map[filename] = f;
+    return f;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Formation::ConstPtr
+FormationFactory::getFormation( const std::string & filename ) const
+{
+    Formation::ConstPtr f = findFormation( filename );
+    if ( f )
+    {
+        return f;
+    }
+
     std::cerr << "formation [" << filename << "] not found." << std::endl;
     return Formation::ConstPtr();
 }
@@ -465,6 +616,12 @@ FormationFactory::readAllFormations( const std::string & formation_dir )
                 //std::cerr << "OK read formation [" << filename << "]"
                 //          << std::endl;
                 M_all_formation_map[filename] = f;
+
+                std::vector< std::string > & role_names = M_role_name_map[filename];
+                for ( int unum = 1; unum <= 11; ++unum )
+                {
+                    role_names.push_back( f->getRoleName( unum ) );
+                }
             }
         }
     }
@@ -474,6 +631,47 @@ FormationFactory::readAllFormations( const std::string & formation_dir )
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+FormationFactory::readBundle( const std::string & filepath )
+{
+    if ( ! M_bundle.open( filepath ) )
+    {
+        std::cerr << __FILE__ << ": (readBundle) "
+                  << "*** ERROR *** could not read the formation bundle"
+                  << " [" << filepath << "]" << std::endl;
+        return false;
+    }
+
+    //
+    // only the index is read here.
+    // the formations are created in findFormation().
+    //
+    for ( FormationBundle::Map::const_iterator it = M_bundle.entries().begin(),
+              end = M_bundle.entries().end();
+          it != end;
+          ++it )
+    {
+        if ( ! checkGoalieUnum( it->second.role_names_ ) )
+        {
+            std::cerr << __FILE__ << ": (readBundle) "
+                      << "*** ERROR *** illegal formation in the bundle"
+                      << " [" << it->first << "]" << std::endl;
+            M_bundle.close();
+            M_role_name_map.clear();
+            M_goalie_unum = Unum_Unknown;
+            return false;
+        }
+
+        M_role_name_map[it->first] = it->second.role_names_;
+    }
+
+    return true;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -482,15 +680,16 @@ bool
 FormationFactory::setFormationFromAllMap( const std::string & filename,
                                           rcsc::Formation::ConstPtr * ptr )
 {
-    Map::iterator it = M_all_formation_map.find( filename );
-    if ( it == M_all_formation_map.end() )
+    Formation::ConstPtr f = findFormation( filename );
+    if ( ! f )
     {
         std::cerr << "ERROR: [" << filename << "]"
                   << " has not been registered." << std::endl;
         return false;
     }
 
-    *ptr = it->second;
+    *ptr = f;
+    createGrid( filename, f );
     return true;
 }
 
@@ -654,8 +853,8 @@ FormationFactory::assignFormation( const std::string & team_name,
 
     const std::string filename = basename + "-" + type_name + ".conf";
 
-    Map::iterator it = M_all_formation_map.find( filename );
-    if ( it == M_all_formation_map.end() )
+    Formation::ConstPtr f = findFormation( filename );
+    if ( ! f )
     {
         std::cerr <<  __FILE__ << ':'
                   << "(assignFormation)"
@@ -663,7 +862,8 @@ FormationFactory::assignFormation( const std::string & team_name,
         return false;
     }
 
-    target_formation_map[team_name] = it->second;
+    target_formation_map[team_name] = f;
+    createGrid( filename, f );
     return true;
 }
 
@@ -891,8 +1091,8 @@ FormationFactory::overwriteFormation( const std::string & team_name,
 
     const std::string filename = basename + "-" + type_name + ".conf";
 
-    Map::iterator it = M_all_formation_map.find( filename );
-    if ( it == M_all_formation_map.end() )
+    Formation::ConstPtr f = findFormation( filename );
+    if ( ! f )
     {
         //std::cerr <<  __FILE__ << ':'
         //           << "(overwriteFormation)"
@@ -905,7 +1105,8 @@ FormationFactory::overwriteFormation( const std::string & team_name,
     //           << " " << basename
     //           << std::endl;
 
-    target_formation_map[team_name] = it->second;
+    target_formation_map[team_name] = f;
+    createGrid( filename, f );
     return true;
 }
 
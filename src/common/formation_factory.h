@@ -27,6 +27,8 @@
 #ifndef FORMATION_FACTORY_H
 #define FORMATION_FACTORY_H
 
+#include "formation_bundle.h"
+#include "formation_grid.h"
 #include "types.h"
 
 #include <rcsc/formation/formation.h>
@@ -44,6 +46,9 @@ public:
     //! key: filename or teamname
     typedef std::map< std::string , rcsc::Formation::ConstPtr > Map;
 
+    //! key: filename, value: role names of unum 1-11
+    typedef std::map< std::string, std::vector< std::string > > RoleNameMap;
+
 private:
 
     //
@@ -74,7 +79,18 @@ private:
 
     rcsc::Formation::ConstPtr M_goalie_position;
 
-    Map M_all_formation_map; //! key: filename
+    //! key: filename. if the bundle is used, only the formations already requested are stored.
+    mutable Map M_all_formation_map;
+
+    //! key: filename
+    RoleNameMap M_role_name_map;
+
+    //! formation bundle. the formations are created when they are requested first.
+    FormationBundle M_bundle;
+
+    //! key: formation object. the grid is created when the formation is assigned in init(),
+    //! only if the grid resolution is positive.
+    std::map< const rcsc::Formation *, FormationGrid::ConstPtr > M_grid_map;
 
     //
 
@@ -124,6 +140,16 @@ public:
           return M_all_formation_map;
       }
 
+    /*!
+      \brief get the role names of all available formations.
+      this map is always complete even if the formations are not created yet.
+      \return role name map
+     */
+    const RoleNameMap & roleNameMap() const
+      {
+          return M_role_name_map;
+      }
+
     rcsc::Formation::ConstPtr getFormation( const rcsc::SideID our_side,
                                             const std::string & their_team_name,
                                             const rcsc::GameMode & game_mode,
@@ -133,6 +159,29 @@ public:
 
     rcsc::Formation::ConstPtr getFormation( const std::string & filename ) const;
 
+    /*!
+      \brief get the positions of all players. the precomputed grid is
+      used if it has been created for the formation.
+      \param f formation object
+      \param ball_pos ball position
+      \param positions reference to the result variable
+     */
+    void getPositions( const rcsc::Formation::ConstPtr & f,
+                       const rcsc::Vector2D & ball_pos,
+                       std::vector< rcsc::Vector2D > & positions ) const;
+
+    /*!
+      \brief get the position of the player. the precomputed grid is
+      used if it has been created for the formation.
+      \param f formation object
+      \param unum uniform number
+      \param ball_pos ball position
+      \return the position of the player
+     */
+    rcsc::Vector2D getPosition( const rcsc::Formation::ConstPtr & f,
+                                const int unum,
+                                const rcsc::Vector2D & ball_pos ) const;
+
     //
     // default formations
     //
@@ -219,6 +268,12 @@ private:
     rcsc::Formation::ConstPtr createFormation( const std::string & filepath );
 
     bool readAllFormations( const std::string & formation_dir );
+    bool readBundle( const std::string & filepath );
+    bool checkGoalieUnum( const std::vector< std::string > & role_names );
+    rcsc::Formation::ConstPtr findFormation( const std::string & filename ) const;
+
+    void createGrid( const std::string & filename,
+                     const rcsc::Formation::ConstPtr & f );
     bool setFormationFromAllMap( const std::string & filename,
                                  rcsc::Formation::ConstPtr * ptr );
 
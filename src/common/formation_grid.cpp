@@ -0,0 +1,273 @@
+// -*-c++-*-
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "formation_grid.h"
+
+#include <rcsc/common/server_param.h>
+
+#include <boost/random.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace rcsc;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+FormationGrid::FormationGrid( Formation::ConstPtr formation,
+                              const double resolution )
+    : M_formation( formation ),
+      M_min_x( 0.0 ),
+      M_min_y( 0.0 ),
+      M_max_x( 0.0 ),
+      M_max_y( 0.0 ),
+      M_step_x( 0.0 ),
+      M_step_y( 0.0 ),
+      M_x_size( 0 ),
+      M_y_size( 0 )
+{
+    if ( ! formation
+         || resolution <= 0.0 )
+    {
+        return;
+    }
+
+    const ServerParam & SP = ServerParam::i();
+
+    M_min_x = -SP.pitchHalfLength();
+    M_max_x = +SP.pitchHalfLength();
+    M_min_y = -SP.pitchHalfWidth();
+    M_max_y = +SP.pitchHalfWidth();
+
+    // the last nodes are placed on the pitch edges.
+    M_x_size = std::max( 2, static_cast< int >( std::ceil( ( M_max_x - M_min_x ) / resolution ) ) + 1 );
+    M_y_size = std::max( 2, static_cast< int >( std::ceil( ( M_max_y - M_min_y ) / resolution ) ) + 1 );
+    M_step_x = ( M_max_x - M_min_x ) / ( M_x_size - 1 );
+    M_step_y = ( M_max_y - M_min_y ) / ( M_y_size - 1 );
+
+    M_positions.resize( static_cast< size_t >( M_x_size ) * M_y_size * PLAYER_SIZE * 2 );
+
+    std::vector< Vector2D > positions;
+    std::vector< float >::iterator out = M_positions.begin();
+
+    for ( int ix = 0; ix < M_x_size; ++ix )
+    {
+        const double x = ( ix == M_x_size - 1 ? M_max_x : M_min_x + M_step_x * ix );
+        for ( int iy = 0; iy < M_y_size; ++iy )
+        {
+            const double y = ( iy == M_y_size - 1 ? M_max_y : M_min_y + M_step_y * iy );
+
+            positions.clear();
+            formation->getPositions( Vector2D( x, y ), positions );
+            if ( positions.size() != PLAYER_SIZE )
+            {
+                // the formation is always used directly.
+                M_positions.clear();
+                return;
+            }
+
+            for ( int i = 0; i < PLAYER_SIZE; ++i )
+            {
+                *out++ = static_cast< float >( positions[i].x );
+                *out++ = static_cast< float >( positions[i].y );
+            }
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+FormationGrid::getCell( const Vector2D & ball_pos,
+                        double * tx,
+                        double * ty ) const
+{
+    const double fx = ( ball_pos.x - M_min_x ) / M_step_x;
+    const double fy = ( ball_pos.y - M_min_y ) / M_step_y;
+
+    const int ix = std::min( M_x_size - 2, std::max( 0, static_cast< int >( fx ) ) );
+    const int iy = std::min( M_y_size - 2, std::max( 0, static_cast< int >( fy ) ) );
+
+    *tx = fx - ix;
+    *ty = fy - iy;
+
+    return ix * M_y_size + iy;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+FormationGrid::getPositions( const Vector2D & ball_pos,
+                             std::vector< Vector2D > & positions ) const
+{
+    if ( ! isValid()
+         || ! contains( ball_pos ) )
+    {
+        M_formation->getPositions( ball_pos, positions );
+        return;
+    }
+
+    double tx, ty;
+    const int cell = getCell( ball_pos, &tx, &ty );
+
+    const double w00 = ( 1.0 - tx ) * ( 1.0 - ty );
+    const double w01 = ( 1.0 - tx ) * ty;
+    const double w10 = tx * ( 1.0 - ty );
+    const double w11 = tx * ty;
+
+    const float * p00 = &M_positions[static_cast< size_t >( cell ) * PLAYER_SIZE * 2];
+    const float * p01 = p00 + PLAYER_SIZE * 2;
+    const float * p10 = p00 + static_cast< size_t >( M_y_size ) * PLAYER_SIZE * 2;
+    const float * p11 = p10 + PLAYER_SIZE * 2;
+
+    positions.resize( PLAYER_SIZE );
+    for ( int i = 0; i < PLAYER_SIZE * 2; i += 2 )
+    {
+        positions[i / 2].assign( w00 * p00[i] + w01 * p01[i] + w10 * p10[i] + w11 * p11[i],
+                                 w00 * p00[i + 1] + w01 * p01[i + 1] + w10 * p10[i + 1] + w11 * p11[i + 1] );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Vector2D
+FormationGrid::getPosition( const int unum,
+                            const Vector2D & ball_pos ) const
+{
+    if ( ! isValid()
+         || ! contains( ball_pos )
+         || unum < 1 || PLAYER_SIZE < unum )
+    {
+        return M_formation->getPosition( unum, ball_pos );
+    }
+
+    double tx, ty;
+    const int cell = getCell( ball_pos, &tx, &ty );
+
+    const size_t offset = ( static_cast< size_t >( cell ) * PLAYER_SIZE + unum - 1 ) * 2;
+    const float * p00 = &M_positions[offset];
+    const float * p01 = p00 + PLAYER_SIZE * 2;
+    const float * p10 = p00 + static_cast< size_t >( M_y_size ) * PLAYER_SIZE * 2;
+    const float * p11 = p10 + PLAYER_SIZE * 2;
+
+    return Vector2D( ( 1.0 - tx ) * ( ( 1.0 - ty ) * p00[0] + ty * p01[0] )
+                     + tx * ( ( 1.0 - ty ) * p10[0] + ty * p11[0] ),
+                     ( 1.0 - tx ) * ( ( 1.0 - ty ) * p00[1] + ty * p01[1] )
+                     + tx * ( ( 1.0 - ty ) * p10[1] + ty * p11[1] ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+FormationGrid::validate( const int n_samples,
+                         double * average ) const
+{
+    if ( average )
+    {
+        *average = 0.0;
+    }
+
+    if ( ! isValid() )
+    {
+        return 0.0;
+    }
+
+    std::vector< Vector2D > samples;
+
+    //
+    // the cell centers are the farthest points from the nodes.
+    //
+    for ( int ix = 0; ix < M_x_size - 1; ++ix )
+    {
+        for ( int iy = 0; iy < M_y_size - 1; ++iy )
+        {
+            samples.push_back( Vector2D( M_min_x + M_step_x * ( ix + 0.5 ),
+                                         M_min_y + M_step_y * ( iy + 0.5 ) ) );
+        }
+    }
+
+    boost::mt19937 gen( 19937 );
+    boost::uniform_real<> x_dst( M_min_x, M_max_x );
+    boost::uniform_real<> y_dst( M_min_y, M_max_y );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > x_rng( gen, x_dst );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > y_rng( gen, y_dst );
+
+    for ( int i = 0; i < n_samples; ++i )
+    {
+        samples.push_back( Vector2D( x_rng(), y_rng() ) );
+    }
+
+    double max_error = 0.0;
+    double sum_error = 0.0;
+    int count = 0;
+
+    std::vector< Vector2D > exact;
+    std::vector< Vector2D > approx;
+
+    for ( std::vector< Vector2D >::const_iterator p = samples.begin(), end = samples.end();
+          p != end;
+          ++p )
+    {
+        exact.clear();
+        M_formation->getPositions( *p, exact );
+        getPositions( *p, approx );
+
+        if ( exact.size() != approx.size() )
+        {
+            continue;
+        }
+
+        for ( size_t i = 0; i < exact.size(); ++i )
+        {
+            const double err = exact[i].dist( approx[i] );
+            max_error = std::max( max_error, err );
+            sum_error += err;
+            ++count;
+        }
+    }
+
+    if ( average
+         && count > 0 )
+    {
+        *average = sum_error / count;
+    }
+
+    return max_error;
+}
@@ -0,0 +1,159 @@
+// -*-c++-*-
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef FORMATION_GRID_H
+#define FORMATION_GRID_H
+
+#include <rcsc/formation/formation.h>
+#include <rcsc/geom/vector_2d.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+
+/*!
+  \class FormationGrid
+  \brief precomputed positions of one formation on the regular grid of the ball position.
+
+  The positions of all players are computed by the formation for each
+  grid node on the pitch when the grid is created. The query returns
+  the bilinear interpolation of the four nodes around the ball
+  position. If the ball position is out of the pitch, the formation is
+  used directly.
+
+  The interpolation is not exact, because the formation interpolates
+  the samples in each Delaunay triangle. validate() measures the
+  deviation from the formation.
+*/
+class FormationGrid {
+public:
+
+    typedef boost::shared_ptr< FormationGrid > Ptr;
+    typedef boost::shared_ptr< const FormationGrid > ConstPtr;
+
+    enum {
+        PLAYER_SIZE = 11
+    };
+
+private:
+
+    rcsc::Formation::ConstPtr M_formation;
+
+    double M_min_x; //!< x coordinate of the first node
+    double M_min_y; //!< y coordinate of the first node
+    double M_max_x; //!< x coordinate of the last node
+    double M_max_y; //!< y coordinate of the last node
+    double M_step_x; //!< node interval
+    double M_step_y; //!< node interval
+    int M_x_size; //!< the number of nodes along the x axis
+    int M_y_size; //!< the number of nodes along the y axis
+
+    //! node positions. index = ( ( ix * y_size + iy ) * PLAYER_SIZE + unum - 1 ) * 2 + {0:x,1:y}
+    std::vector< float > M_positions;
+
+    // not used
+    FormationGrid( const FormationGrid & );
+    FormationGrid & operator=( const FormationGrid & );
+
+public:
+
+    /*!
+      \brief create the grid
+      \param formation formation object
+      \param resolution the maximum node interval [m]
+     */
+    FormationGrid( rcsc::Formation::ConstPtr formation,
+                   const double resolution );
+
+    /*!
+      \brief check if the grid has been created
+      \return true if the grid can be used.
+     */
+    bool isValid() const
+      {
+          return ! M_positions.empty();
+      }
+
+    const rcsc::Formation::ConstPtr & formation() const
+      {
+          return M_formation;
+      }
+
+    /*!
+      \brief get the number of grid nodes
+      \return the number of nodes
+     */
+    int size() const
+      {
+          return M_x_size * M_y_size;
+      }
+
+    /*!
+      \brief get the positions of all players
+      \param ball_pos ball position
+      \param positions reference to the result variable
+     */
+    void getPositions( const rcsc::Vector2D & ball_pos,
+                       std::vector< rcsc::Vector2D > & positions ) const;
+
+    /*!
+      \brief get the position of the player
+      \param unum uniform number
+      \param ball_pos ball position
+      \return the position of the player
+     */
+    rcsc::Vector2D getPosition( const int unum,
+                                const rcsc::Vector2D & ball_pos ) const;
+
+    /*!
+      \brief compare the interpolated positions with the formation at
+      the center of each cell and the random ball positions
+      \param n_samples the number of random samples
+      \param average pointer to the variable to store the average deviation. may be NULL.
+      \return the maximum deviation [m]
+     */
+    double validate( const int n_samples,
+                     double * average ) const;
+
+private:
+
+    bool contains( const rcsc::Vector2D & ball_pos ) const
+      {
+          return ( M_min_x <= ball_pos.x && ball_pos.x <= M_max_x
+                   && M_min_y <= ball_pos.y && ball_pos.y <= M_max_y );
+      }
+
+    /*!
+      \brief get the cell and the interpolation weights
+      \return the index of the lower left node
+     */
+    int getCell( const rcsc::Vector2D & ball_pos,
+                 double * tx,
+                 double * ty ) const;
+
+};
+
+#endif
@@ -0,0 +1,89 @@
+// -*-c++-*-
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "linear_rank_scorer.h"
+
+#include <svmrank/svm_struct_api.h>
+
+#include <iostream>
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+LinearRankScorer::LinearRankScorer()
+    : M_bias( 0.0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+LinearRankScorer::assign( const svmrank::MODEL * model,
+                          const size_t feature_size )
+{
+    clear();
+
+    if ( ! model
+         || model->kernel_parm.kernel_type != svmrank::LINEAR )
+    {
+        return false;
+    }
+
+    if ( ! model->lin_weights )
+    {
+        std::cerr << "(LinearRankScorer) no weight vector." << std::endl;
+        return false;
+    }
+
+    //
+    // lin_weights is indexed by the feature number (1-origin).
+    // the features that do not appear in the model have no weight.
+    //
+    const size_t size = ( feature_size > 0
+                          ? feature_size
+                          : static_cast< size_t >( model->totwords ) );
+    if ( size == 0 )
+    {
+        return false;
+    }
+
+    M_weights.assign( size, 0.0 );
+    for ( long i = 1; i <= model->totwords && static_cast< size_t >( i ) <= size; ++i )
+    {
+        M_weights[i - 1] = model->lin_weights[i];
+    }
+    M_bias = model->b;
+
+    return true;
+}
@@ -0,0 +1,131 @@
+// -*-c++-*-
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+
+#ifndef LINEAR_RANK_SCORER_H
+#define LINEAR_RANK_SCORER_H
+
+#include <svmrank/svm_struct_api_types.h>
+
+#include <boost/cstdint.hpp>
+
+#include <vector>
+#include <cstddef>
+
+/*!
+  \class LinearRankScorer
+  \brief allocation-free scorer of the linear svmrank model.
+
+  The weight vector of the model is copied into the dense array. The
+  feature values are given to svmrank as float, and the scorer keeps
+  the same precision, so that the score is equal to the value of the
+  generic classifier of svmrank.
+*/
+class LinearRankScorer {
+private:
+
+    //! dense weight vector. index = feature number - 1
+    std::vector< double > M_weights;
+    double M_bias;
+
+public:
+
+    LinearRankScorer();
+
+    /*!
+      \brief copy the weight vector of the model.
+      add_weight_vector_to_linear_model() must have been called.
+      \param model svmrank model
+      \param feature_size the number of the input features. if 0, the number of the model features is used.
+      \return true if the model has the linear kernel.
+     */
+    bool assign( const svmrank::MODEL * model,
+                 const size_t feature_size );
+
+    void clear()
+      {
+          M_weights.clear();
+          M_bias = 0.0;
+      }
+
+    bool isValid() const
+      {
+          return ! M_weights.empty();
+      }
+
+    size_t featureSize() const
+      {
+          return M_weights.size();
+      }
+
+    /*!
+      \brief compute the score of the dense feature vector
+      \param features featureSize() values. features[i] is the value of the feature number (i + 1).
+      \return score value
+     */
+    double score( const double * features ) const
+      {
+          const double * w = &M_weights[0];
+          const size_t size = M_weights.size();
+
+          double sum = 0.0;
+          for ( size_t i = 0; i < size; ++i )
+          {
+              sum += w[i] * static_cast< float >( features[i] );
+          }
+
+          return sum - M_bias;
+      }
+
+    /*!
+      \brief compute the score of the sparse feature vector
+      \param ids feature numbers (1-origin) in ascending order
+      \param values feature values
+      \param size the number of features
+      \return score value. the features out of range are ignored.
+     */
+    double score( const boost::uint32_t * ids,
+                  const float * values,
+                  const size_t size ) const
+      {
+          const double * w = &M_weights[0];
+          const size_t w_size = M_weights.size();
+
+          double sum = 0.0;
+          for ( size_t i = 0; i < size; ++i )
+          {
+              if ( 1 <= ids[i] && ids[i] <= w_size )
+              {
+                  sum += w[ids[i] - 1] * values[i];
+              }
+          }
+
+          return sum - M_bias;
+      }
+
+};
+
+#endif
@@ -74,6 +74,9 @@ Options::instance()
 Options::Options()
     : M_log_dir( "/tmp/" ),
       M_formation_conf_dir( "./data/formations/" ),
+      M_formation_bundle_file(),
+      M_formation_grid_resolution( 0.0 ),
+      M_formation_grid_validation( false ),
       M_kick_conf_file(), //( "./data/kick.conf" ),
       M_formation_conf_file( "./data/formation.conf"),
       M_overwrite_formation_conf_file( "./data/overwrite_formation.conf"),
@@ -81,16 +84,29 @@ Options::Options()
       M_ball_table_file( "./data/ball_table.dat" ),
       M_chain_search_method( "BestFirstSearch" ),
       M_evaluator_name( "Default" ),
+      M_intercept_evaluator_name( "2013" ),
       M_max_chain_length( 4 ),
       M_max_evaluate_size( 1000 ),
+      M_chain_search_budget_msec( 0.0 ),
+      M_chain_search_benchmark( false ),
+      M_chain_search_warm_start( false ),
+      M_chain_search_warm_start_margin( 20.0 ),
+      M_chain_search_threads( 1 ),
+      M_chain_search_transposition_grid( 0.0 ),
+      M_pass_generator_threads( 1 ),
+      M_pass_intercept_probability( false ),
       M_sirm_evaluator_param_dir( "./data/sirm_evaluator" ),
       M_svmrank_evaluator_model( "./data/svmrank_evaluator/model" ),
       M_center_forward_free_move_model( "./data/center_forward_free_move/model" ),
       M_intercept_conf_dir( "./data/intercept_probability/" ),
+      M_shared_data_name(),
       M_goalie_position_dir( "./data/goalie_position/" ),
       M_opponent_data_dir( "./data/opponent_data/" ),
       M_test_setplay_dir( "./data/test_setplay/" ),
-      M_statistic_logging( false )
+      M_statistic_logging( false ),
+      M_stage_profile( false ),
+      M_stage_profile_trace( false ),
+      M_reach_cycle_table_validation( false )
 {
 
 }
@@ -108,6 +124,9 @@ Options::init( CmdLineParser & cmd_parser )
         // ( "log-dir", "", &M_log_dir, "the directory where log files are stored." )
         //
         ( "formation-conf-dir", "", &M_formation_conf_dir, "the directory where formation files exist." )
+        ( "formation-bundle", "", &M_formation_bundle_file, "formation bundle file path. (empty means the formation files are read from formation-conf-dir)" )
+        ( "formation-grid-resolution", "", &M_formation_grid_resolution, "node interval [m] of the precomputed formation position grid. (<= 0 means disabled)" )
+        ( "formation-grid-validation", "", BoolSwitch( &M_formation_grid_validation ), "compare the formation position grid with the formation and print the maximum deviation." )
         //
         ( "kick-conf", "", &M_kick_conf_file, "kick configuration file path." )
         ( "formation-conf", "", &M_formation_conf_file, "formation assignment file." )
@@ -117,8 +136,17 @@ Options::init( CmdLineParser & cmd_parser )
         //
         ( "chain-search-method", "", &M_chain_search_method, "the name of action chain search algorithm." )
         ( "evaluator-name", "", &M_evaluator_name, "field evaluator name." )
+        ( "intercept-evaluator-name", "", &M_intercept_evaluator_name, "intercept evaluator name. (2013 or 2015)" )
         ( "max-chain-length", "", &M_max_chain_length, "maximum action chain length." )
         ( "max-evaluate-size", "", &M_max_evaluate_size, "maximum evaluation size for action search." )
+        ( "chain-search-budget-ms", "", &M_chain_search_budget_msec, "time budget [ms] for action search. (<= 0 means unlimited)" )
+        ( "chain-search-benchmark", "", BoolSwitch( &M_chain_search_benchmark ), "compare all action search algorithms every cycle." )
+        ( "chain-search-warm-start", "", BoolSwitch( &M_chain_search_warm_start ), "re-evaluate the last best chain first in the best first search, and penalize the change of the receiver." )
+        ( "chain-search-warm-start-margin", "", &M_chain_search_warm_start_margin, "prune margin for the warm started search. (< 0 means no pruning)" )
+        ( "chain-search-threads", "", &M_chain_search_threads, "the number of threads for the best first search." )
+        ( "chain-search-transposition-grid", "", &M_chain_search_transposition_grid, "ball position resolution of the transposition table for action search. (<= 0 means disabled)" )
+        ( "pass-generator-threads", "", &M_pass_generator_threads, "the number of threads for the pass course generation." )
+        ( "pass-intercept-probability", "", BoolSwitch( &M_pass_intercept_probability ), "(experimental) evaluate the pass safety by the intercept probability tables." )
         //
         ( "sirm-evaluator-param-dir", "", &M_sirm_evaluator_param_dir, "parameter directory for the SIRM field evaluator." )
         ( "svmrank-evaluator-model", "", &M_svmrank_evaluator_model, "SVMRank field evaluator model file." )
@@ -126,11 +154,16 @@ Options::init( CmdLineParser & cmd_parser )
         //
         ( "intercept-conf-dir", "", &M_intercept_conf_dir, "the directory where intercept conf files exist." )
         //
+        ( "shared-data-name", "", &M_shared_data_name, "POSIX shared memory name for the read only data tables. e.g. /helios_data (empty means each process loads its own tables)" )
+        //
         ( "goalie-position-dir", "", &M_goalie_position_dir, "the directory where goalie position data files exist." )
         //
         ( "opponent-data-dir", "", &M_opponent_data_dir, "the directory where analyzed opponent data files exist." )
         //
         ( "statistic-logging", "", BoolSwitch( &M_statistic_logging ), "record statistic log" )
+        ( "stage-profile", "", BoolSwitch( &M_stage_profile ), "measure the elapsed time of each decision stage and print the summary at exit." )
+        ( "stage-profile-trace", "", BoolSwitch( &M_stage_profile_trace ), "write the elapsed time of each decision stage into the binary trace file in the log directory." )
+        ( "reach-cycle-table-validation", "", BoolSwitch( &M_reach_cycle_table_validation ), "compare the turn cycle table with the exact simulation over random samples." )
         ;
 
 
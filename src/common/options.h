@@ -64,6 +64,9 @@ private:
     std::string M_log_dir;
 
     std::string M_formation_conf_dir;
+    std::string M_formation_bundle_file;
+    double M_formation_grid_resolution;
+    bool M_formation_grid_validation;
     std::string M_kick_conf_file;
     std::string M_formation_conf_file;
     std::string M_overwrite_formation_conf_file;
@@ -72,8 +75,17 @@ private:
 
     std::string M_chain_search_method;
     std::string M_evaluator_name;
+    std::string M_intercept_evaluator_name;
     size_t M_max_chain_length;
     size_t M_max_evaluate_size;
+    double M_chain_search_budget_msec;
+    bool M_chain_search_benchmark;
+    bool M_chain_search_warm_start;
+    double M_chain_search_warm_start_margin;
+    int M_chain_search_threads;
+    double M_chain_search_transposition_grid;
+    int M_pass_generator_threads;
+    bool M_pass_intercept_probability;
 
     std::string M_sirm_evaluator_param_dir;
     std::string M_svmrank_evaluator_model;
@@ -81,6 +93,8 @@ private:
 
     std::string M_intercept_conf_dir;
 
+    std::string M_shared_data_name;
+
     std::string M_goalie_position_dir;
 
     std::string M_opponent_data_dir;
@@ -88,6 +102,9 @@ private:
     std::string M_test_setplay_dir;
 
     bool M_statistic_logging;
+    bool M_stage_profile;
+    bool M_stage_profile_trace;
+    bool M_reach_cycle_table_validation;
 
     //
     //
@@ -120,6 +137,9 @@ public:
     const std::string & logDir() const { return M_log_dir; }
 
     const std::string & formationConfDir() const { return M_formation_conf_dir; }
+    const std::string & formationBundleFile() const { return M_formation_bundle_file; }
+    double formationGridResolution() const { return M_formation_grid_resolution; }
+    bool formationGridValidation() const { return M_formation_grid_validation; }
     const std::string & kickConfFile() const { return M_kick_conf_file; }
     const std::string & formationConfFile() const { return M_formation_conf_file; }
     const std::string & overwriteFormationConfFile() const { return M_overwrite_formation_conf_file; }
@@ -128,8 +148,17 @@ public:
 
     const std::string & chainSearchMethod() const { return M_chain_search_method; }
     const std::string & evaluatorName() const { return M_evaluator_name; }
+    const std::string & interceptEvaluatorName() const { return M_intercept_evaluator_name; }
     size_t maxChainLength() const { return M_max_chain_length; }
     size_t maxEvaluateSize() const { return M_max_evaluate_size; }
+    double chainSearchBudgetMSec() const { return M_chain_search_budget_msec; }
+    bool chainSearchBenchmark() const { return M_chain_search_benchmark; }
+    bool chainSearchWarmStart() const { return M_chain_search_warm_start; }
+    double chainSearchWarmStartMargin() const { return M_chain_search_warm_start_margin; }
+    int chainSearchThreads() const { return M_chain_search_threads; }
+    double chainSearchTranspositionGrid() const { return M_chain_search_transposition_grid; }
+    int passGeneratorThreads() const { return M_pass_generator_threads; }
+    bool passInterceptProbability() const { return M_pass_intercept_probability; }
 
     const std::string & sirmEvaluatorParamDir() const { return M_sirm_evaluator_param_dir; }
     const std::string & svmrankEvaluatorModel() const { return M_svmrank_evaluator_model; }
@@ -137,6 +166,8 @@ public:
 
     const std::string & interceptConfDir() const { return M_intercept_conf_dir; }
 
+    const std::string & sharedDataName() const { return M_shared_data_name; }
+
     const std::string & goaliePositionDir() const { return M_goalie_position_dir; }
 
     const std::string & opponentDataDir() const { return M_opponent_data_dir; }
@@ -144,6 +175,9 @@ public:
     const std::string & TestSetplayDir() const { return M_test_setplay_dir; }
 
     bool statisticLogging() const { return M_statistic_logging; }
+    bool stageProfile() const { return M_stage_profile; }
+    bool stageProfileTrace() const { return M_stage_profile_trace; }
+    bool reachCycleTableValidation() const { return M_reach_cycle_table_validation; }
 
 };
 
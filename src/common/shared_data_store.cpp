@@ -0,0 +1,597 @@
+// -*-c++-*-
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "shared_data_store.h"
+
+#include <boost/cstdint.hpp>
+
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+
+#include <sys/types.h> // fstat, stat
+#include <sys/stat.h> // fstat, stat
+#include <sys/mman.h> // shm_open, shm_unlink, mmap, munmap
+#include <sys/file.h> // flock
+#include <fcntl.h> // O_* constants
+#include <unistd.h> // close, ftruncate, getpid
+
+namespace {
+
+const char MAGIC[4] = { 'H', 'T', 'D', 'S' };
+
+//! the maximum length of the table name including the terminating null
+const size_t NAME_SIZE = 56;
+
+/*!
+  \brief segment header
+ */
+struct Header {
+    char magic_[4];
+    boost::uint32_t version_;
+    boost::uint32_t ready_; //!< set to 1 after all tables are written
+    boost::uint32_t table_size_;
+    boost::uint64_t total_size_;
+    boost::uint64_t key_size_;
+    boost::int32_t creator_pid_; //!< process id of the creator
+    boost::uint32_t padding_;
+};
+
+/*!
+  \brief table index
+ */
+struct TableEntry {
+    char name_[NAME_SIZE];
+    boost::uint64_t offset_; //!< byte offset from the start of the segment
+    boost::uint64_t size_; //!< the number of values
+};
+
+/*!
+  \brief segment status
+ */
+enum Status {
+    SEGMENT_OK,
+    SEGMENT_NOT_READY, //!< being created by another process, or left by the crashed creator
+    SEGMENT_STALE, //!< created from the other version or the other files
+    SEGMENT_BROKEN //!< unknown format. never replaced
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+inline
+const char *
+status_name( const Status status )
+{
+    switch ( status ) {
+    case SEGMENT_OK:
+        return "ok";
+    case SEGMENT_NOT_READY:
+        return "not ready";
+    case SEGMENT_STALE:
+        return "stale";
+    default:
+        break;
+    }
+    return "broken";
+}
+
+inline
+size_t
+align8( const size_t n )
+{
+    return ( n + 7 ) & ~static_cast< size_t >( 7 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check the mapped segment
+  \param data mapped segment
+  \param size mapped size
+  \param key expected key
+  \param tables pointer to the result table index. may be NULL.
+  \return segment status
+ */
+template < typename TableMap >
+Status
+validate( const char * data,
+          const size_t size,
+          const std::string & key,
+          TableMap * tables )
+{
+    //
+    // the creator resizes the segment and writes the magic after shm_open().
+    // an empty segment or a zero magic means that the creator is still working.
+    //
+    if ( size < sizeof( Header ) )
+    {
+        return SEGMENT_NOT_READY;
+    }
+
+    const Header * header = reinterpret_cast< const Header * >( data );
+
+    const char zero_magic[sizeof( MAGIC )] = { 0, 0, 0, 0 };
+    if ( std::memcmp( header->magic_, zero_magic, sizeof( MAGIC ) ) == 0 )
+    {
+        return SEGMENT_NOT_READY;
+    }
+
+    if ( std::memcmp( header->magic_, MAGIC, sizeof( MAGIC ) ) != 0 )
+    {
+        return SEGMENT_BROKEN;
+    }
+
+    if ( header->version_ != SharedDataStore::VERSION )
+    {
+        return SEGMENT_STALE;
+    }
+
+    if ( *static_cast< const volatile boost::uint32_t * >( &header->ready_ ) != 1 )
+    {
+        return SEGMENT_NOT_READY;
+    }
+    // the tables are read after the ready flag.
+    __sync_synchronize();
+
+    const size_t key_offset = sizeof( Header );
+    const size_t index_offset = key_offset + align8( header->key_size_ );
+    const size_t data_offset = index_offset + sizeof( TableEntry ) * header->table_size_;
+
+    if ( header->total_size_ != size
+         || header->key_size_ > size
+         || header->table_size_ > size / sizeof( TableEntry )
+         || data_offset > size )
+    {
+        return SEGMENT_BROKEN;
+    }
+
+    if ( header->key_size_ != key.length()
+         || std::memcmp( data + key_offset, key.data(), key.length() ) != 0 )
+    {
+        return SEGMENT_STALE;
+    }
+
+    const TableEntry * entries = reinterpret_cast< const TableEntry * >( data + index_offset );
+    for ( boost::uint32_t i = 0; i < header->table_size_; ++i )
+    {
+        const TableEntry & e = entries[i];
+        if ( std::memchr( e.name_, '\0', NAME_SIZE ) == 0
+             || e.offset_ < data_offset
+             || e.offset_ % sizeof( double ) != 0
+             || e.offset_ > size
+             || e.size_ > ( size - e.offset_ ) / sizeof( double ) )
+        {
+            return SEGMENT_BROKEN;
+        }
+
+        if ( tables )
+        {
+            typename TableMap::mapped_type t;
+            t.data_ = reinterpret_cast< const double * >( data + e.offset_ );
+            t.size_ = static_cast< size_t >( e.size_ );
+            (*tables)[e.name_] = t;
+        }
+    }
+
+    return SEGMENT_OK;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief map the existing segment read-only
+  \return mapped address. NULL if not available.
+ */
+const char *
+map_segment( const std::string & name,
+             size_t * size )
+{
+    int fd = ::shm_open( name.c_str(), O_RDONLY, 0 );
+    if ( fd < 0 )
+    {
+        return static_cast< const char * >( 0 );
+    }
+
+    struct stat st;
+    if ( ::fstat( fd, &st ) != 0
+         || st.st_size <= 0 )
+    {
+        ::close( fd );
+        return static_cast< const char * >( 0 );
+    }
+
+    void * addr = ::mmap( 0, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+    // the mapping is still valid after the descriptor is closed.
+    ::close( fd );
+
+    if ( addr == MAP_FAILED )
+    {
+        return static_cast< const char * >( 0 );
+    }
+
+    *size = static_cast< size_t >( st.st_size );
+    return static_cast< const char * >( addr );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief exclusive lock to serialize the segment creation.
+  The lock object "<name>.lock" is never removed. The lock is released
+  by the destructor, or by the kernel if the process crashes.
+ */
+class CreationLock {
+private:
+    int M_fd;
+
+    // not used
+    CreationLock( const CreationLock & );
+    CreationLock & operator=( const CreationLock & );
+
+public:
+
+    explicit
+    CreationLock( const std::string & name )
+        : M_fd( ::shm_open( ( name + ".lock" ).c_str(), O_RDWR | O_CREAT, 0644 ) )
+      {
+          if ( M_fd >= 0 )
+          {
+              int ret = 0;
+              do
+              {
+                  ret = ::flock( M_fd, LOCK_EX );
+              }
+              while ( ret != 0 && errno == EINTR );
+
+              if ( ret != 0 )
+              {
+                  ::close( M_fd );
+                  M_fd = -1;
+              }
+          }
+      }
+
+    ~CreationLock()
+      {
+          if ( M_fd >= 0 )
+          {
+              ::flock( M_fd, LOCK_UN );
+              ::close( M_fd );
+          }
+      }
+
+    bool isLocked() const
+      {
+          return M_fd >= 0;
+      }
+};
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+SharedDataStore::SharedDataStore()
+    : M_data( static_cast< const char * >( 0 ) ),
+      M_size( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+SharedDataStore::~SharedDataStore()
+{
+    detach();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+SharedDataStore &
+SharedDataStore::instance()
+{
+    static SharedDataStore s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::string
+SharedDataStore::make_key( const std::vector< std::string > & filepaths )
+{
+    std::ostringstream os;
+
+    for ( std::vector< std::string >::const_iterator p = filepaths.begin(), end = filepaths.end();
+          p != end;
+          ++p )
+    {
+        struct stat st;
+        if ( ::stat( p->c_str(), &st ) != 0 )
+        {
+            os << *p << ":none;";
+            continue;
+        }
+
+        os << *p << ':' << st.st_size << ':' << st.st_mtime << ';';
+    }
+
+    return os.str();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+SharedDataStore::attach( const std::string & name,
+                         const std::string & key )
+{
+    detach();
+
+    size_t size = 0;
+    const char * data = map_segment( name, &size );
+    if ( ! data )
+    {
+        return false;
+    }
+
+    const Status status = validate( data, size, key, &M_tables );
+    if ( status != SEGMENT_OK )
+    {
+        std::cerr << __FILE__ << ": (attach) "
+                  << status_name( status )
+                  << " segment [" << name << "]" << std::endl;
+        ::munmap( const_cast< char * >( data ), size );
+        M_tables.clear();
+        return false;
+    }
+
+    M_name = name;
+    M_data = data;
+    M_size = size;
+    M_pending.clear();
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SharedDataStore::detach()
+{
+    if ( M_data )
+    {
+        ::munmap( const_cast< char * >( M_data ), M_size );
+    }
+
+    M_name.clear();
+    M_data = static_cast< const char * >( 0 );
+    M_size = 0;
+    M_tables.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const double *
+SharedDataStore::table( const std::string & name,
+                        size_t * size ) const
+{
+    std::map< std::string, Table >::const_iterator it = M_tables.find( name );
+    if ( it == M_tables.end() )
+    {
+        return static_cast< const double * >( 0 );
+    }
+
+    *size = it->second.size_;
+    return it->second.data_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SharedDataStore::addTable( const std::string & name,
+                           const std::vector< double > & values )
+{
+    if ( name.length() >= NAME_SIZE )
+    {
+        std::cerr << __FILE__ << ": (addTable) too long table name ["
+                  << name << "]" << std::endl;
+        return;
+    }
+
+    M_pending.push_back( std::make_pair( name, values ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+SharedDataStore::publish( const std::string & name,
+                          const std::string & key )
+{
+    if ( M_pending.empty() )
+    {
+        return false;
+    }
+
+    //
+    // compute the layout
+    //
+    const size_t index_offset = sizeof( Header ) + align8( key.length() );
+    const size_t data_offset = index_offset + sizeof( TableEntry ) * M_pending.size();
+
+    size_t total_size = data_offset;
+    for ( size_t i = 0; i < M_pending.size(); ++i )
+    {
+        total_size += sizeof( double ) * M_pending[i].second.size();
+    }
+
+    //
+    // only one process creates the segment at a time.
+    //
+    CreationLock lock( name );
+    if ( ! lock.isLocked() )
+    {
+        std::cerr << __FILE__ << ": (publish) could not lock the segment ["
+                  << name << "] " << std::strerror( errno ) << std::endl;
+        return false;
+    }
+
+    //
+    // check the existing segment.
+    // it is replaced if it has the other version or key.
+    // no process is creating the segment while the lock is held,
+    // so the segment that is not ready was left by the crashed creator.
+    // the segment of an unknown format is left as it is, and the tables are not shared.
+    //
+    {
+        size_t size = 0;
+        const char * data = map_segment( name, &size );
+        if ( data )
+        {
+            const Status status = validate< std::map< std::string, Table > >( data, size, key, 0 );
+            boost::int32_t creator_pid = 0;
+            if ( size >= sizeof( Header ) )
+            {
+                creator_pid = reinterpret_cast< const Header * >( data )->creator_pid_;
+            }
+            ::munmap( const_cast< char * >( data ), size );
+
+            if ( status == SEGMENT_OK )
+            {
+                // published by another process
+                return attach( name, key );
+            }
+
+            if ( status == SEGMENT_BROKEN )
+            {
+                std::cerr << __FILE__ << ": (publish) " << status_name( status )
+                          << " segment [" << name << "]. the tables are not shared." << std::endl;
+                return false;
+            }
+
+            if ( status == SEGMENT_NOT_READY )
+            {
+                std::cerr << __FILE__ << ": (publish) reclaim the segment [" << name
+                          << "] left by the process " << creator_pid << std::endl;
+            }
+        }
+
+        // an empty segment cannot be mapped. it is also left by the crashed creator.
+        ::shm_unlink( name.c_str() );
+    }
+
+    int fd = ::shm_open( name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644 );
+    if ( fd < 0 )
+    {
+        std::cerr << __FILE__ << ": (publish) could not create the segment ["
+                  << name << "] " << std::strerror( errno ) << std::endl;
+        return false;
+    }
+
+    if ( ::ftruncate( fd, total_size ) != 0 )
+    {
+        std::cerr << __FILE__ << ": (publish) could not resize the segment ["
+                  << name << "]" << std::endl;
+        ::close( fd );
+        ::shm_unlink( name.c_str() );
+        return false;
+    }
+
+    void * addr = ::mmap( 0, total_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    ::close( fd );
+
+    if ( addr == MAP_FAILED )
+    {
+        std::cerr << __FILE__ << ": (publish) could not map the segment ["
+                  << name << "]" << std::endl;
+        ::shm_unlink( name.c_str() );
+        return false;
+    }
+
+    //
+    // write the tables.
+    // the ready flag is set at the end, after all values are visible.
+    //
+    char * data = static_cast< char * >( addr );
+    std::memset( data, 0, data_offset );
+
+    Header * header = reinterpret_cast< Header * >( data );
+    std::memcpy( header->magic_, MAGIC, sizeof( MAGIC ) );
+    header->version_ = VERSION;
+    header->ready_ = 0;
+    header->table_size_ = static_cast< boost::uint32_t >( M_pending.size() );
+    header->total_size_ = total_size;
+    header->key_size_ = key.length();
+    header->creator_pid_ = static_cast< boost::int32_t >( ::getpid() );
+
+    std::memcpy( data + sizeof( Header ), key.data(), key.length() );
+
+    TableEntry * entries = reinterpret_cast< TableEntry * >( data + index_offset );
+    size_t offset = data_offset;
+    for ( size_t i = 0; i < M_pending.size(); ++i )
+    {
+        const std::vector< double > & values = M_pending[i].second;
+
+        std::strncpy( entries[i].name_, M_pending[i].first.c_str(), NAME_SIZE - 1 );
+        entries[i].offset_ = offset;
+        entries[i].size_ = values.size();
+
+        if ( ! values.empty() )
+        {
+            std::memcpy( data + offset, &values[0], sizeof( double ) * values.size() );
+        }
+        offset += sizeof( double ) * values.size();
+    }
+
+    __sync_synchronize();
+    *static_cast< volatile boost::uint32_t * >( &header->ready_ ) = 1;
+
+    ::munmap( addr, total_size );
+
+    M_pending.clear();
+
+    return attach( name, key );
+}
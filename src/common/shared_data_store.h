@@ -0,0 +1,165 @@
+// -*-c++-*-
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SHARED_DATA_STORE_H
+#define SHARED_DATA_STORE_H
+
+#include <map>
+#include <vector>
+#include <string>
+#include <cstddef>
+
+/*!
+  \class SharedDataStore
+  \brief read only numeric tables shared by the processes on the same host.
+
+  The first process that loads the data files publishes the tables into
+  the POSIX shared memory segment. The other processes attach the
+  segment read-only and use the tables without parsing the files. The
+  segment layout is:
+
+    header: magic "HTDS", version, ready flag, table size, total size, key size, creator pid
+    key: the stamp of the source files
+    table index: name, offset, the number of values
+    data: double arrays
+
+  The key is created from the path, the size and the modification time
+  of the source files. If the segment is missing, not ready or created
+  from the other files, attach() fails and the caller loads the data
+  files privately.
+
+  The pointers returned by table() are valid until detach() is called.
+  The store is never detached while the tables are used.
+*/
+class SharedDataStore {
+public:
+
+    enum {
+        VERSION = 2
+    };
+
+private:
+
+    /*!
+      \brief attached table
+     */
+    struct Table {
+        const double * data_;
+        size_t size_;
+    };
+
+    std::string M_name; //!< attached segment name
+    const char * M_data; //!< mapped segment
+    size_t M_size; //!< mapped size
+
+    //! key: table name
+    std::map< std::string, Table > M_tables;
+
+    //! tables registered to be published
+    std::vector< std::pair< std::string, std::vector< double > > > M_pending;
+
+    // private for singleton
+    SharedDataStore();
+
+    // not used
+    SharedDataStore( const SharedDataStore & );
+    SharedDataStore & operator=( const SharedDataStore & );
+
+public:
+
+    ~SharedDataStore();
+
+    static
+    SharedDataStore & instance();
+
+    static
+    const SharedDataStore & i()
+      {
+          return instance();
+      }
+
+    /*!
+      \brief create the key of the source files
+      \param filepaths source file paths
+      \return key string
+     */
+    static
+    std::string make_key( const std::vector< std::string > & filepaths );
+
+    /*!
+      \brief attach the existing segment read-only
+      \param name shared memory name. e.g. /helios_data
+      \param key expected key of the source files
+      \return true if the segment is ready and has the same key.
+     */
+    bool attach( const std::string & name,
+                 const std::string & key );
+
+    /*!
+      \brief unmap the segment
+     */
+    void detach();
+
+    bool isAttached() const
+      {
+          return M_data != static_cast< const char * >( 0 );
+      }
+
+    /*!
+      \brief get the attached table
+      \param name table name
+      \param size pointer to the variable to store the number of values
+      \return pointer to the first value. NULL if not found.
+     */
+    const double * table( const std::string & name,
+                          size_t * size ) const;
+
+    /*!
+      \brief register the table to be published
+      \param name table name
+      \param values table values
+     */
+    void addTable( const std::string & name,
+                   const std::vector< double > & values );
+
+    /*!
+      \brief create the segment from the registered tables and attach it.
+      the creation is serialized by the lock object "<name>.lock".
+      if another process has published the same tables while waiting for
+      the lock, that segment is attached. the stale segment that has the
+      other version or key, or the segment left by the crashed creator, is
+      replaced. the segment of an unknown format is left as it is, and the
+      tables are not shared.
+      \param name shared memory name
+      \param key key of the source files
+      \return true if the segment is published and attached.
+     */
+    bool publish( const std::string & name,
+                  const std::string & key );
+
+};
+
+#endif
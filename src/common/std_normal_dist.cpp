@@ -104,44 +104,3 @@ StdNormalDist::pdf( const double standard_deviation,
 
     return M_probability_densities[idx];
 }
-
-/*-------------------------------------------------------------------*/
-/*!
-
- */
-double
-StdNormalDist::cdf( const double standard_deviation,
-                    const double value ) const
-{
-#if 0
-    //
-    // need linear interpolation?
-    //
-    double v = value / standard_deviation * 100.0;
-    double cv = std::ceil( v );
-    double fv = std::floor( v );
-
-    double crate = ( c - fv ) / ( cv - fv );
-
-    size_t cidx = static_cast< size_t >( cv );
-    size_t fidx = static_cast< size_t >( fv );
-
-    double ccdf = ( cidx >= M_cumulative_densities.size()
-                    ? 0.0
-                    : M_cumulative_densities[cidx] );
-    double fcdf = ( fidx >= M_cumulativedensities.size()
-                    ? 0.0
-                    : M_cumulative_densities[fidx] );
-
-    return cpdf * crate + fpdf * ( 1.0 - crate );
-#endif
-
-    size_t idx = static_cast< size_t >( std::ceil( value / standard_deviation * 100.0 ) );
-
-    if ( idx >= M_cumulative_densities.size() )
-    {
-        return 1.0;
-    }
-
-    return M_cumulative_densities[idx];
-}
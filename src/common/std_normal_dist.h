@@ -28,6 +28,7 @@
 #define STD_NORMAL_DIST_H
 
 #include <vector>
+#include <cmath>
 
 /*!
   \class StdNormalDist
@@ -66,13 +67,19 @@ public:
 
     /*!
       \brief approximate cumulative density function for another normal distribution.
+      defined here to be inlined into BallMoveModel::probability().
       \param standard_deviation standard deviation value of another distribution
       \param value input value for another distribution
       \return approximate cumulative density.
      */
     double cdf( const double standard_deviation,
-                const double value ) const;
-
+                const double value ) const
+      {
+          const size_t idx = static_cast< size_t >( std::ceil( value / standard_deviation * 100.0 ) );
+          return ( idx >= M_cumulative_densities.size()
+                   ? 1.0
+                   : M_cumulative_densities[idx] );
+      }
 
 };
 
@@ -33,6 +33,7 @@
 
 #include "predict_state.h"
 #include "action_state_pair.h"
+#include "action_index_counter.h"
 
 #include <rcsc/player/world_model.h>
 #include <rcsc/player/intercept_table.h>
@@ -108,17 +109,12 @@ void
 ActGen_DirectPass::generate( std::vector< ActionStatePair > * result,
                              const PredictState & state,
                              const WorldModel & current_wm,
-                             const std::vector< ActionStatePair > & path ) const
+                             const ActionStatePath & path ) const
 {
     static const int VALID_PLAYER_THRESHOLD = 10;
-    static GameTime s_last_call_time( 0, 0 );
-    static int s_action_count = 0;
+    static ActionIndexCounter s_action_count;
 
-    if ( current_wm.time() != s_last_call_time )
-    {
-        s_action_count = 0;
-        s_last_call_time = current_wm.time();
-    }
+    s_action_count.update( current_wm.time() );
 
 
 #ifdef DEBUG_PRINT
@@ -204,7 +200,7 @@ ActGen_DirectPass::generate( std::vector< ActionStatePair > * result,
     const AbstractPlayerObject & holder = state.ballHolder();
     int generated_count = 0;
 
-    for ( PredictPlayerObject::Cont::const_iterator it = state.ourPlayers().begin(),
+    for ( PredictState::PlayerCont::const_iterator it = state.ourPlayers().begin(),
               end = state.ourPlayers().end();
           it != end;
           ++it )
@@ -301,9 +297,8 @@ ActGen_DirectPass::generate( std::vector< ActionStatePair > * result,
                                                     spent_time,
                                                     kick_step,
                                                     "direct" ) );
-        ++s_action_count;
         ++generated_count;
-        action->setIndex( s_action_count );
+        action->setIndex( s_action_count.next() );
         action->setMode( ActPass::SIMPLE_DIRECT );
         action->setSafetyLevel( CooperativeAction::MaybeDangerous );
         result->push_back( ActionStatePair( action, result_state ) );
@@ -313,6 +308,6 @@ ActGen_DirectPass::generate( std::vector< ActionStatePair > * result,
     dlog.addText( Logger::ACTION_CHAIN,
                   __FILE__": Direct path=%d, generated=%d total=%d",
                   path.size(),
-                  generated_count, s_action_count );
+                  generated_count, s_action_count.count() );
 #endif
 }
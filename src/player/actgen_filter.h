@@ -47,7 +47,7 @@ public:
     void generate( std::vector< ActionStatePair > * result,
                    const PredictState & state,
                    const rcsc::WorldModel & current_wm,
-                   const std::vector< ActionStatePair > & path ) const
+                   const ActionStatePath & path ) const
       {
           if ( path.size() < M_max_threshold_length )
           {
@@ -72,7 +72,7 @@ public:
     void generate( std::vector< ActionStatePair > * result,
                    const PredictState & state,
                    const rcsc::WorldModel & current_wm,
-                   const std::vector< ActionStatePair > & path ) const
+                   const ActionStatePath & path ) const
       {
           if ( path.size() + 1 >= M_min_threshold_length )
           {
@@ -105,7 +105,7 @@ public:
     void generate( std::vector< ActionStatePair > * result,
                    const PredictState & state,
                    const rcsc::WorldModel & current_wm,
-                   const std::vector< ActionStatePair > & path ) const
+                   const ActionStatePath & path ) const
       {
           if ( ( M_max_threshold_length == MAX
                  || path.size() < M_max_threshold_length )
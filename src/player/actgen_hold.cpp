@@ -49,7 +49,7 @@ void
 ActGen_Hold::generate( std::vector< ActionStatePair > * result,
                        const PredictState & state,
                        const WorldModel & wm,
-                       const std::vector< ActionStatePair > & ) const
+                       const ActionStatePath & ) const
 {
     if ( ! wm.self().isKickable()
          || wm.self().isFrozen() )
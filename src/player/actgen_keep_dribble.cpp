@@ -48,7 +48,7 @@ void
 ActGen_KeepDribble::generate( std::vector< ActionStatePair > * result,
                                const PredictState & state,
                                const WorldModel & wm,
-                               const std::vector< ActionStatePair > & path ) const
+                               const ActionStatePath & path ) const
 {
     // generate only first actions
     if ( ! path.empty() )
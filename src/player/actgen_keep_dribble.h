@@ -37,7 +37,7 @@ public:
     void generate( std::vector< ActionStatePair > * result,
                    const PredictState & state,
                    const rcsc::WorldModel & wm,
-                   const std::vector< ActionStatePair > & path ) const;
+                   const ActionStatePath & path ) const;
 };
 
 #endif
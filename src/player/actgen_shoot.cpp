@@ -51,7 +51,7 @@ void
 ActGen_Shoot::generate( std::vector< ActionStatePair > * result,
                         const PredictState & state,
                         const WorldModel & wm,
-                        const std::vector< ActionStatePair > & ) const
+                        const ActionStatePath & ) const
 {
     const AbstractPlayerObject & holder = state.ballHolder();
 
@@ -38,7 +38,7 @@ public:
     void generate( std::vector< ActionStatePair > * result,
                    const PredictState & state,
                    const rcsc::WorldModel & current_wm,
-                   const std::vector< ActionStatePair > & path ) const;
+                   const ActionStatePath & path ) const;
 };
 
 #endif
@@ -33,6 +33,7 @@
 
 #include "predict_state.h"
 #include "action_state_pair.h"
+#include "action_index_counter.h"
 
 #include <rcsc/player/world_model.h>
 #include <rcsc/common/server_param.h>
@@ -56,7 +57,7 @@ exist_opponent_on_ball_move( const PredictState & state,
                              const Segment2D & ball_move,
                              const Vector2D & receive_pos )
 {
-    for ( PredictPlayerObject::Cont::const_iterator o = state.theirPlayers().begin(),
+    for ( PredictState::PlayerCont::const_iterator o = state.theirPlayers().begin(),
               end = state.theirPlayers().end();
           o != end;
           ++o )
@@ -89,21 +90,16 @@ void
 ActGen_SimpleCross::generate( std::vector< ActionStatePair > * result,
                               const PredictState & state,
                               const WorldModel & current_wm,
-                              const std::vector< ActionStatePair > & path ) const
+                              const ActionStatePath & path ) const
 {
-    static GameTime s_last_call_time( 0, 0 );
-    static int s_action_count = 0;
+    static ActionIndexCounter s_action_count;
 
     if ( path.empty() )
     {
         return;
     }
 
-    if ( current_wm.time() != s_last_call_time )
-    {
-        s_action_count = 0;
-        s_last_call_time = current_wm.time();
-    }
+    s_action_count.update( current_wm.time() );
 
     const Vector2D goal = ServerParam::i().theirTeamGoalPos();
 
@@ -115,7 +111,7 @@ ActGen_SimpleCross::generate( std::vector< ActionStatePair > * result,
     const AbstractPlayerObject & holder = state.ballHolder();
     int generated_count = 0;
 
-    for ( PredictPlayerObject::Cont::const_iterator t = state.ourPlayers().begin(),
+    for ( PredictState::PlayerCont::const_iterator t = state.ourPlayers().begin(),
               end = state.ourPlayers().end();
           t != end;
           ++t )
@@ -166,9 +162,8 @@ ActGen_SimpleCross::generate( std::vector< ActionStatePair > * result,
                                                         spent_time,
                                                         kick_step,
                                                         "simpleCross" ) );
-            ++s_action_count;
             ++generated_count;
-            action->setIndex( s_action_count );
+            action->setIndex( s_action_count.next() );
             action->setMode( ActPass::SIMPLE_CROSS );
             action->setSafetyLevel( CooperativeAction::MaybeDangerous );
             result->push_back( ActionStatePair( action, result_state ) );
@@ -179,6 +174,6 @@ ActGen_SimpleCross::generate( std::vector< ActionStatePair > * result,
     dlog.addText( Logger::ACTION_CHAIN,
                   "(ActGen_SimpleCross) path=%zd, generated=%d total=%d",
                   path.size(),
-                  generated_count, s_action_count );
+                  generated_count, s_action_count.count() );
 #endif
 }
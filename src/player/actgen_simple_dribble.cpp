@@ -35,6 +35,7 @@
 
 #include "action_state_pair.h"
 #include "predict_state.h"
+#include "action_index_counter.h"
 
 #include <rcsc/player/world_model.h>
 #include <rcsc/common/logger.h>
@@ -91,7 +92,7 @@ void
 ActGen_SimpleDribble::generate( std::vector< ActionStatePair > * result,
                                 const PredictState & state,
                                 const WorldModel & current_wm,
-                                const std::vector< ActionStatePair > & path ) const
+                                const ActionStatePath & path ) const
 {
     generateImplAngles( result, state, current_wm, path );
     //generateImplVoronoiTargets( result, state, current_wm, path );
@@ -105,16 +106,11 @@ void
 ActGen_SimpleDribble::generateImplAngles( std::vector< ActionStatePair > * result,
                                           const PredictState & state,
                                           const WorldModel & current_wm,
-                                          const std::vector< ActionStatePair > & path ) const
+                                          const ActionStatePath & path ) const
 {
-    static GameTime s_last_call_time( 0, 0 );
-    static int s_action_count = 0;
+    static ActionIndexCounter s_action_count;
 
-    if ( current_wm.time() != s_last_call_time )
-    {
-        s_action_count = 0;
-        s_last_call_time = current_wm.time();
-    }
+    s_action_count.update( current_wm.time() );
 
     if ( path.empty() )
     {
@@ -223,7 +219,7 @@ ActGen_SimpleDribble::generateImplAngles( std::vector< ActionStatePair > * resul
         // check opponent
         //
         bool exist_opponent = false;
-        for ( PredictPlayerObject::Cont::const_iterator o = state.theirPlayers().begin();
+        for ( PredictState::PlayerCont::const_iterator o = state.theirPlayers().begin();
               o != state.theirPlayers().end();
               ++o )
         {
@@ -277,8 +273,7 @@ ActGen_SimpleDribble::generateImplAngles( std::vector< ActionStatePair > * resul
                                                                    holder_reach_step,
                                                                    "Simple" );
 
-        ++s_action_count;
-        action->setIndex( s_action_count );
+        action->setIndex( s_action_count.next() );
         action->setSafetyLevel( CooperativeAction::MaybeDangerous );
         result->push_back( ActionStatePair( action, result_state ) );
 
@@ -291,7 +286,7 @@ ActGen_SimpleDribble::generateImplAngles( std::vector< ActionStatePair > * resul
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::ACTION_CHAIN,
                   __FILE__": Dribble path=%d, holder=%d generated=%d/%d",
-                  path.size(), holder.unum(), count, s_action_count );
+                  path.size(), holder.unum(), count, s_action_count.count() );
 #endif
 }
 
@@ -303,16 +298,11 @@ void
 ActGen_SimpleDribble::generateImplVoronoiTargets( std::vector< ActionStatePair > * result,
                                                   const PredictState & state,
                                                   const WorldModel & current_wm,
-                                                  const std::vector< ActionStatePair > & path ) const
+                                                  const ActionStatePath & path ) const
 {
-    static GameTime s_last_call_time( 0, 0 );
-    static int s_action_count = 0;
+    static ActionIndexCounter s_action_count;
 
-    if ( current_wm.time() != s_last_call_time )
-    {
-        s_action_count = 0;
-        s_last_call_time = current_wm.time();
-    }
+    s_action_count.update( current_wm.time() );
 
     if ( path.empty() )
     {
@@ -349,7 +339,7 @@ ActGen_SimpleDribble::generateImplVoronoiTargets( std::vector< ActionStatePair >
         // check opponent
         //
         bool exist_opponent = false;
-        for ( PredictPlayerObject::Cont::const_iterator o = state.theirPlayers().begin();
+        for ( PredictState::PlayerCont::const_iterator o = state.theirPlayers().begin();
               o != state.theirPlayers().end();
               ++o )
         {
@@ -383,11 +373,10 @@ ActGen_SimpleDribble::generateImplVoronoiTargets( std::vector< ActionStatePair >
                                                                    1,
                                                                    holder_reach_step - 2,
                                                                    "Simple" );
-        action->setIndex( s_action_count );
+        action->setIndex( s_action_count.next() - 1 );
         action->setSafetyLevel( CooperativeAction::MaybeDangerous );
         result->push_back( ActionStatePair( action, result_state ) );
 
-        ++s_action_count;
         ++count;
         if ( count > 10 )
         {
@@ -401,6 +390,6 @@ ActGen_SimpleDribble::generateImplVoronoiTargets( std::vector< ActionStatePair >
                   __FILE__": Dribble path=%d, holder=%d generated=%d/%d",
                   path.size(),
                   holder.unum(),
-                  count, s_action_count );
+                  count, s_action_count.count() );
 #endif
 }
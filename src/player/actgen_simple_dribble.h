@@ -42,19 +42,19 @@ public:
     void generate( std::vector< ActionStatePair > * result,
                    const PredictState & state,
                    const rcsc::WorldModel & wm,
-                   const std::vector< ActionStatePair > & path ) const;
+                   const ActionStatePath & path ) const;
 
 private:
 
     void generateImplAngles( std::vector< ActionStatePair > * result,
                              const PredictState & state,
                              const rcsc::WorldModel & wm,
-                             const std::vector< ActionStatePair > & path ) const;
+                             const ActionStatePath & path ) const;
 
     void generateImplVoronoiTargets( std::vector< ActionStatePair > * result,
                                      const PredictState & state,
                                      const rcsc::WorldModel & wm,
-                                     const std::vector< ActionStatePair > & path ) const;
+                                     const ActionStatePath & path ) const;
 };
 
 #endif
@@ -35,6 +35,7 @@
 
 #include "predict_state.h"
 #include "action_state_pair.h"
+#include "action_index_counter.h"
 
 #include <rcsc/player/world_model.h>
 #include <rcsc/player/intercept_table.h>
@@ -50,7 +51,7 @@
 using namespace rcsc;
 
 namespace {
-int g_action_count = 0;
+ActionIndexCounter g_action_count;
 }
 
 /*-------------------------------------------------------------------*/
@@ -61,11 +62,11 @@ void
 ActGen_VoronoiPass::generate( std::vector< ActionStatePair > * result,
                               const PredictState & state,
                               const WorldModel & wm,
-                              const std::vector< ActionStatePair > & path ) const
+                              const ActionStatePath & path ) const
 {
+#ifdef DEBUG_PROFILE
     static GameTime s_update_time;
     static int s_call_counter = 0;
-#ifdef DEBUG_PROFILE
     static double s_cumulative_msec = 0.0;
 #endif
 
@@ -79,23 +80,23 @@ ActGen_VoronoiPass::generate( std::vector< ActionStatePair > * result,
     Timer timer;
 #endif
 
+    g_action_count.update( wm.time() );
+
+#ifdef DEBUG_PROFILE
     if ( s_update_time != wm.time() )
     {
         s_call_counter = 0;
-        g_action_count = 0;
         s_update_time = wm.time();
-
-#ifdef DEBUG_PROFILE
         s_cumulative_msec = 0.0;
         dlog.addText( Logger::ACTION_CHAIN,
                       __FILE__": create candidate pointss, elapsed %f [ms]",
                       timer.elapsedReal() );
-#endif
     }
 
     ++s_call_counter;
+#endif
 
-    PredictPlayerObject::Cont receivers;
+    std::vector< const PredictPlayerObject * > receivers;
     receivers.reserve( state.ourPlayers().size() );
 
     if ( ! createReceiverCandidates( receivers, state, wm, path ) )
@@ -122,10 +123,10 @@ ActGen_VoronoiPass::generate( std::vector< ActionStatePair > * result,
 
  */
 bool
-ActGen_VoronoiPass::createReceiverCandidates( PredictPlayerObject::Cont & receivers,
+ActGen_VoronoiPass::createReceiverCandidates( std::vector< const PredictPlayerObject * > & receivers,
                                               const PredictState & state,
                                               const rcsc::WorldModel & wm,
-                                              const std::vector< ActionStatePair > & path ) const
+                                              const ActionStatePath & path ) const
 {
     //
     // check previous ball holder in order to forbid the previous ball holder becomes the receiver.
@@ -183,7 +184,7 @@ ActGen_VoronoiPass::createReceiverCandidates( PredictPlayerObject::Cont & receiv
                   state.ball().pos().x, state.ball().pos().y );
 #endif
 
-    for ( PredictPlayerObject::Cont::const_iterator p = state.ourPlayers().begin(), end = state.ourPlayers().end();
+    for ( PredictState::PlayerCont::const_iterator p = state.ourPlayers().begin(), end = state.ourPlayers().end();
           p != end;
           ++p )
     {
@@ -225,7 +226,7 @@ void
 ActGen_VoronoiPass::generateActions( std::vector< ActionStatePair > * result,
                                      const PredictState & state,
                                      const std::vector< rcsc::Vector2D > & candidates,
-                                     const PredictPlayerObject::Cont & receivers ) const
+                                     const std::vector< const PredictPlayerObject * > & receivers ) const
 {
 
     const ServerParam & SP = ServerParam::i();
@@ -256,9 +257,9 @@ ActGen_VoronoiPass::generateActions( std::vector< ActionStatePair > * result,
             continue;
         }
 
-        PredictPlayerObject::ConstPtr receiver;
+        const PredictPlayerObject * receiver = static_cast< const PredictPlayerObject * >( 0 );
         int min_receiver_step = 1000;
-        for ( PredictPlayerObject::Cont::const_iterator p = receivers.begin();
+        for ( std::vector< const PredictPlayerObject * >::const_iterator p = receivers.begin();
               p != receivers.end();
               ++p )
         {
@@ -317,7 +318,7 @@ ActGen_VoronoiPass::generateActions( std::vector< ActionStatePair > * result,
 
         const double success_prob = SimplePassChecker::check( state,
                                                               &(state.ballHolder()),
-                                                              receiver.get(),
+                                                              receiver,
                                                               receive_point,
                                                               ball_first_speed,
                                                               ball_step );
@@ -350,9 +351,8 @@ ActGen_VoronoiPass::generateActions( std::vector< ActionStatePair > * result,
                                                     kick_step + ball_step,
                                                     kick_step,
                                                     "Voronoi" ) );
-        ++g_action_count;
         ++generated_count;
-        action->setIndex( g_action_count );
+        action->setIndex( g_action_count.next() );
         action->setMode( ActPass::VORONOI );
         action->setSafetyLevel( CooperativeAction::MaybeDangerous );
         result->push_back( ActionStatePair( action, result_state ) );
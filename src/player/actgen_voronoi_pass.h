@@ -42,17 +42,17 @@ public:
     void generate( std::vector< ActionStatePair > * result,
                    const PredictState & state,
                    const rcsc::WorldModel & wm,
-                   const std::vector< ActionStatePair > & path ) const;
+                   const ActionStatePath & path ) const;
 
 private:
-    bool createReceiverCandidates( PredictPlayerObject::Cont & receivers,
+    bool createReceiverCandidates( std::vector< const PredictPlayerObject * > & receivers,
                                    const PredictState & state,
                                    const rcsc::WorldModel & wm,
-                                   const std::vector< ActionStatePair > & path ) const;
+                                   const ActionStatePath & path ) const;
     void generateActions( std::vector< ActionStatePair > * result,
                           const PredictState & state,
                           const std::vector< rcsc::Vector2D > & candidates,
-                          const PredictPlayerObject::Cont & receivers ) const;
+                          const std::vector< const PredictPlayerObject * > & receivers ) const;
 };
 
 #endif
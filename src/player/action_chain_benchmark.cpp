@@ -0,0 +1,238 @@
+// -*-c++-*-
+
+/*!
+  \file action_chain_benchmark.cpp
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "action_chain_benchmark.h"
+
+#include "action_chain_best_first_search.h"
+#include "action_chain_depth_first_search.h"
+#include "action_chain_monte_calro_tree_search.h"
+#include "cooperative_action.h"
+
+#include "options.h"
+
+#include <rcsc/player/world_model.h>
+#include <rcsc/common/logger.h>
+#include <rcsc/time/timer.h>
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+
+using namespace rcsc;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ActionChainBenchmark::ActionChainBenchmark( FieldEvaluator::Ptr evaluator,
+                                            const ActionGeneratorHolder::ConstPtr & generator )
+{
+    const Options & opt = Options::i();
+
+    M_entries.push_back( Entry( "BestFirstSearch",
+                                ActionChainGraph::Ptr( new ActionChainBestFirstSearch( evaluator,
+                                                                                       generator,
+                                                                                       opt.maxChainLength(),
+                                                                                       opt.maxEvaluateSize() ) ) ) );
+    {
+        ActionChainBestFirstSearch * warm = new ActionChainBestFirstSearch( evaluator,
+                                                                            generator,
+                                                                            opt.maxChainLength(),
+                                                                            opt.maxEvaluateSize() );
+        warm->setWarmStart( true, opt.chainSearchWarmStartMargin() );
+        M_entries.push_back( Entry( "BestFirstSearch(warm)", ActionChainGraph::Ptr( warm ) ) );
+    }
+    if ( opt.chainSearchThreads() > 1 )
+    {
+        ActionChainBestFirstSearch * parallel = new ActionChainBestFirstSearch( evaluator,
+                                                                                generator,
+                                                                                opt.maxChainLength(),
+                                                                                opt.maxEvaluateSize() );
+        parallel->setThreadSize( opt.chainSearchThreads() );
+        M_entries.push_back( Entry( "BestFirstSearch(para)", ActionChainGraph::Ptr( parallel ) ) );
+    }
+    M_entries.push_back( Entry( "DepthFirstSearch",
+                                ActionChainGraph::Ptr( new ActionChainDepthFirstSearch( evaluator,
+                                                                                        generator,
+                                                                                        opt.maxChainLength(),
+                                                                                        opt.maxEvaluateSize() ) ) ) );
+    M_entries.push_back( Entry( "MonteCarloTreeSearch",
+                                ActionChainGraph::Ptr( new ActionChainMonteCalroTreeSearch( evaluator,
+                                                                                            generator,
+                                                                                            opt.maxChainLength(),
+                                                                                            opt.maxEvaluateSize() ) ) ) );
+
+    for ( std::vector< Entry >::iterator it = M_entries.begin(), end = M_entries.end();
+          it != end;
+          ++it )
+    {
+        it->graph_->setTimeBudget( opt.chainSearchBudgetMSec() );
+        it->graph_->setTranspositionTable( opt.chainSearchTranspositionGrid() );
+        it->graph_->setRecordStatistics( false );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ActionChainBenchmark::setFieldEvaluator( FieldEvaluator::Ptr evaluator )
+{
+    for ( std::vector< Entry >::iterator it = M_entries.begin(), end = M_entries.end();
+          it != end;
+          ++it )
+    {
+        it->graph_->setFieldEvaluator( evaluator );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ActionChainBenchmark::run( const WorldModel & wm,
+                           const ActionChainGraph & reference )
+{
+    if ( reference.bestSequence().empty() )
+    {
+        return;
+    }
+
+    const CooperativeAction & reference_action = reference.bestFirstAction();
+
+    for ( std::vector< Entry >::iterator it = M_entries.begin(), end = M_entries.end();
+          it != end;
+          ++it )
+    {
+        Timer timer;
+        it->graph_->search( wm );
+        const double elapsed = timer.elapsedReal();
+
+        const size_t node_count = it->graph_->nodeCount();
+        const int best_index = it->graph_->bestSequenceIndex();
+
+        it->search_count_ += 1;
+        it->total_node_count_ += node_count;
+        it->total_msec_ += elapsed;
+        if ( it->max_msec_ < elapsed )
+        {
+            it->max_msec_ = elapsed;
+        }
+        if ( best_index > 0 )
+        {
+            it->total_msec_to_best_ += it->graph_->bestSequenceMSec();
+        }
+        if ( it->graph_->isTimeOver() )
+        {
+            it->time_over_count_ += 1;
+        }
+
+        const bool agreed = ( ! it->graph_->bestSequence().empty()
+                              && is_same_action( reference_action, it->graph_->bestFirstAction() ) );
+        if ( agreed )
+        {
+            it->agreement_count_ += 1;
+        }
+
+        dlog.addText( Logger::ACTION_CHAIN,
+                      "(ActionChainBenchmark) %s: nodes=%zd best_index=%d to_best=%.3f [ms] elapsed=%.3f [ms] agreed=%d",
+                      it->name_.c_str(), node_count, best_index, it->graph_->bestSequenceMSec(),
+                      elapsed, agreed ? 1 : 0 );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+ActionChainBenchmark::print( std::ostream & os ) const
+{
+    os << "action chain search benchmark:"
+       << " max_chain_length=" << Options::i().maxChainLength()
+       << " max_evaluate_size=" << Options::i().maxEvaluateSize()
+       << " budget=" << Options::i().chainSearchBudgetMSec() << "[ms]"
+       << '\n';
+    os << std::setw( 22 ) << std::left << " searcher"
+       << std::right
+       << std::setw( 8 ) << "count"
+       << std::setw( 12 ) << "nodes/sec"
+       << std::setw( 10 ) << "ave_node"
+       << std::setw( 10 ) << "ave_ms"
+       << std::setw( 10 ) << "max_ms"
+       << std::setw( 12 ) << "to_best_ms"
+       << std::setw( 10 ) << "time_over"
+       << std::setw( 10 ) << "agree[%]"
+       << '\n';
+
+    for ( std::vector< Entry >::const_iterator it = M_entries.begin(), end = M_entries.end();
+          it != end;
+          ++it )
+    {
+        const double count = std::max( 1, it->search_count_ );
+        const double nodes_per_sec = ( it->total_msec_ > 0.0
+                                       ? it->total_node_count_ / ( it->total_msec_ * 0.001 )
+                                       : 0.0 );
+
+        os << ' ' << std::setw( 21 ) << std::left << it->name_
+           << std::right << std::fixed << std::setprecision( 2 )
+           << std::setw( 8 ) << it->search_count_
+           << std::setw( 12 ) << nodes_per_sec
+           << std::setw( 10 ) << it->total_node_count_ / count
+           << std::setw( 10 ) << it->total_msec_ / count
+           << std::setw( 10 ) << it->max_msec_
+           << std::setw( 12 ) << it->total_msec_to_best_ / count
+           << std::setw( 10 ) << it->time_over_count_
+           << std::setw( 10 ) << 100.0 * it->agreement_count_ / count
+           << '\n';
+    }
+
+    return os << std::flush;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ActionChainBenchmark::is_same_action( const CooperativeAction & lhs,
+                                      const CooperativeAction & rhs )
+{
+    return ( lhs.type() == rhs.type()
+             && lhs.targetPlayerUnum() == rhs.targetPlayerUnum()
+             && lhs.targetBallPos().dist2( rhs.targetBallPos() ) < std::pow( 1.0, 2 ) );
+}
@@ -0,0 +1,135 @@
+// -*-c++-*-
+
+/*!
+  \file action_chain_benchmark.h
+  \brief comparative benchmark of the action chain searchers Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef ACTION_CHAIN_BENCHMARK_H
+#define ACTION_CHAIN_BENCHMARK_H
+
+#include "action_chain_graph.h"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace rcsc {
+class WorldModel;
+}
+
+/*!
+  \class ActionChainBenchmark
+  \brief run every searcher on the same root state and compare them.
+
+  This class is used with the offline client mode, in which the
+  recorded games are replayed. helios_chain_benchmark replays the
+  offline client log of one player without the server. Every searcher
+  is applied to the same world model after the searcher used for the
+  decision has finished.
+  Therefore, the caches in the generators are already warm for all
+  benchmarked searchers.
+*/
+class ActionChainBenchmark {
+public:
+
+    typedef boost::shared_ptr< ActionChainBenchmark > Ptr; //!< pointer type alias
+
+private:
+
+    /*!
+      \brief result holder for each searcher
+     */
+    struct Entry {
+        std::string name_;
+        ActionChainGraph::Ptr graph_;
+
+        int search_count_;
+        boost::int64_t total_node_count_;
+        double total_msec_;
+        double max_msec_;
+        double total_msec_to_best_; //!< elapsed time when the best is found
+        int time_over_count_;
+        int agreement_count_; //!< the first action is same as the one of the reference searcher
+
+        Entry( const std::string & name,
+               ActionChainGraph::Ptr graph )
+            : name_( name ),
+              graph_( graph ),
+              search_count_( 0 ),
+              total_node_count_( 0 ),
+              total_msec_( 0.0 ),
+              max_msec_( 0.0 ),
+              total_msec_to_best_( 0.0 ),
+              time_over_count_( 0 ),
+              agreement_count_( 0 )
+          { }
+    };
+
+    std::vector< Entry > M_entries;
+
+    // not used
+    ActionChainBenchmark( const ActionChainBenchmark & );
+    ActionChainBenchmark & operator=( const ActionChainBenchmark & );
+
+public:
+
+    /*!
+      \brief create all searchers with the same parameters as the main searcher
+      \param evaluator field evaluator instance
+      \param generator action generator instance
+     */
+    ActionChainBenchmark( FieldEvaluator::Ptr evaluator,
+                          const ActionGeneratorHolder::ConstPtr & generator );
+
+    void setFieldEvaluator( FieldEvaluator::Ptr evaluator );
+
+    /*!
+      \brief run all searchers
+      \param wm world model as the root state
+      \param reference searcher whose result is used for the decision
+     */
+    void run( const rcsc::WorldModel & wm,
+              const ActionChainGraph & reference );
+
+    /*!
+      \brief print the summary
+      \param os reference to the output stream
+      \return reference to the output stream
+     */
+    std::ostream & print( std::ostream & os ) const;
+
+    static
+    bool is_same_action( const CooperativeAction & lhs,
+                         const CooperativeAction & rhs );
+
+};
+
+#endif
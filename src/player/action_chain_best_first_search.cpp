@@ -37,29 +37,40 @@
 #include <rcsc/common/logger.h>
 #include <rcsc/time/timer.h>
 
-#include <queue>
+#include <algorithm>
+#include <functional>
 #include <limits>
+#include <cmath>
 
 // #define DEBUG_PROFILE
 // #define DEBUG_PRINT
 
-// #define USE_LAST_DECISION
-
 using namespace rcsc;
 
-inline
-bool
-operator<( const ActionChainGraph::Sequence & lhs,
-           const ActionChainGraph::Sequence & rhs )
-{
-    return lhs.hvalue_ < rhs.hvalue_;
-}                            //???
+namespace {
 
+//! the number of the first actions of the last search expanded in the warm start
+const size_t WARM_SIBLING_SIZE = 3;
+
+//! the last result is discarded if the ball moved more than this distance
+const double WARM_BALL_MOVE_THR = 5.0;
+
+//! tolerance for the target ball position to identify the same action
+const double WARM_TARGET_POS_TOLERANCE = 3.0;
+
+}
 
 /*-------------------------------------------------------------------*/
-/*-------------------------------------------------------------------*/
-/*-------------------------------------------------------------------*/
+/*!
 
+ */
+bool
+ActionChainBestFirstSearch::ActionSignature::match( const CooperativeAction & action ) const
+{
+    return ( type_ == action.type()
+             && target_player_unum_ == action.targetPlayerUnum()
+             && target_ball_pos_.dist2( action.targetBallPos() ) < std::pow( WARM_TARGET_POS_TOLERANCE, 2 ) );
+}
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -72,9 +83,71 @@ ActionChainBestFirstSearch::ActionChainBestFirstSearch( FieldEvaluator::Ptr eval
     : ActionChainGraph( evaluator, generator, max_depth, max_traversal ),
       M_last_search_time( -1, 0 ),
       M_last_target_player_unum( Unum_Unknown ),
-      M_last_target_ball_pos( Vector2D::INVALIDATED )
+      M_last_target_ball_pos( Vector2D::INVALIDATED ),
+      M_best_node_index( -1 ),
+      M_use_last_decision( false ),
+      M_warm_start( false ),
+      M_warm_start_margin( -1.0 ),
+      M_last_ball_holder_unum( Unum_Unknown ),
+      M_last_ball_pos( Vector2D::INVALIDATED ),
+      M_warm_active( false ),
+      M_warm_bound( -std::numeric_limits< double >::max() ),
+      M_warm_search_count( 0 ),
+      M_warm_hit_count( 0 )
+{
+    // the node arena never reallocates during the search,
+    // because the path view refers to the pairs stored in the arena.
+    M_nodes.reserve( max_traversal );
+    M_open_list.reserve( max_traversal + 1 );
+    M_path_buffer.reserve( max_depth + 1 );
+
+    setThreadSize( 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ActionChainBestFirstSearch::setThreadSize( const size_t size )
 {
+    const size_t thread_size = std::max( static_cast< size_t >( 1 ), size );
 
+    M_tasks.resize( thread_size );
+    M_task_ptrs.resize( thread_size );
+    for ( size_t i = 0; i < thread_size; ++i )
+    {
+        M_tasks[i].search_ = this;
+        M_tasks[i].path_.reserve( M_max_depth + 1 );
+        M_task_ptrs[i] = &M_tasks[i];
+    }
+
+    if ( thread_size > 1 )
+    {
+        M_worker_pool = boost::shared_ptr< ActionChainWorkerPool >( new ActionChainWorkerPool( thread_size ) );
+    }
+    else
+    {
+        M_worker_pool.reset();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ActionChainBestFirstSearch::setWarmStart( const bool on,
+                                          const double prune_margin )
+{
+    M_warm_start = on;
+    M_warm_start_margin = prune_margin;
+
+    if ( ! on )
+    {
+        M_last_best_chain.clear();
+        M_last_top_actions.clear();
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -84,15 +157,21 @@ ActionChainBestFirstSearch::ActionChainBestFirstSearch( FieldEvaluator::Ptr eval
 void
 ActionChainBestFirstSearch::search( const WorldModel & wm )
 {
+    // the time budget includes the preparation of the root state
+    Timer timer;
+
     clearResult();
 
+    M_nodes.clear();
+    M_open_list.clear();
+    M_best_node_index = -1;
+
     M_first_state = PredictState::ConstPtr( new PredictState( wm ) );
 
-#ifdef DEBUG_PROFILE
-    Timer timer;
-#endif
+    prepareWarmStart( wm );
 
-    doSearch( wm );
+    doSearch( wm, timer );
+    buildBestSequence();
 
     if ( M_best_sequence.chain_.empty() )
     {
@@ -105,15 +184,19 @@ ActionChainBestFirstSearch::search( const WorldModel & wm )
         M_last_target_ball_pos =  M_best_sequence.chain_.front().action().targetBallPos();
     }
 
-#ifdef DEBUG_PROFILE
+    saveLastResult();
+
     const double elapsed = timer.elapsedReal();
+#ifdef DEBUG_PROFILE
     dlog.addText( Logger::ACTION_CHAIN,
-                  "(BestFirstSearch) PROFILE size=%d elapsed %f [ms]",
-                  M_node_count, elapsed );
-    Statistics::instance().setActionSearchData( M_node_count, elapsed );
-#else
-    Statistics::instance().setActionSearchData( M_node_count, 0.0 );
+                  "(BestFirstSearch) PROFILE size=%d elapsed %f [ms]%s",
+                  M_node_count, elapsed, ( M_time_over ? " time over" : "" ) );
 #endif
+    if ( M_record_statistics )
+    {
+        Statistics::instance().setActionSearchData( M_node_count, elapsed, M_time_over );
+    }
+    recordTranspositionStatistics();
 }
 
 /*-------------------------------------------------------------------*/
@@ -121,123 +204,562 @@ ActionChainBestFirstSearch::search( const WorldModel & wm )
 
  */
 void
-ActionChainBestFirstSearch::doSearch( const WorldModel & wm )
+ActionChainBestFirstSearch::doSearch( const WorldModel & wm,
+                                      const Timer & timer )
 {
-    std::priority_queue< Sequence > q;
+    // the tasks are executed on this thread while the debug log is recorded,
+    // because the logger is not thread safe. the result is not changed.
+    const bool parallel = ( M_worker_pool
+                            && ! dlog.isEnabled( Logger::LEVEL_ANY ) );
 
-    //q.push( Sequence( std::vector< ActionStatePair >(), 0.0, 0.0 ) );
-    q.push( Sequence() );
+    M_use_last_decision = ( M_warm_start
+                            && M_last_search_time.cycle() == wm.time().cycle() - 1
+                            && M_last_target_player_unum != Unum_Unknown );
+    int pruned_count = 0;
 
-    while ( 1 )
+    if ( M_warm_active )
     {
-        if ( q.empty() )
+        // the root node is expanded in the replay
+        if ( ! replayLastResult( wm, timer ) )
         {
-            break;
+            return;
         }
+    }
+    else
+    {
+        M_open_list.push_back( OpenNode( 0.0, -1 ) );
+    }
 
-        Sequence best_seq = q.top();
-        q.pop();
-
-        if ( best_seq.chain_.size() >= M_max_depth
-             || ( ! best_seq.chain_.empty()
-                  && best_seq.chain_.back().action().isFinalAction() ) )
+    while ( ! M_open_list.empty() )
+    {
+        //
+        // anytime search: return the best sequence found so far
+        //
+        if ( M_time_budget_msec > 0.0
+             && timer.elapsedReal() >= M_time_budget_msec )
         {
-            // over the max chain length
-            // or, the last action is a final action type.
-            continue;
+            dlog.addText( Logger::ACTION_CHAIN,
+                          "(BestFirstSearch) ***** over time budget %.2f [ms] *****",
+                          M_time_budget_msec );
+            M_time_over = true;
+            return;
         }
 
-        // generate possible action-state pair at the tail of action chain
-        std::vector< ActionStatePair > candidate_actions;
+        //
+        // pop the frontier nodes for the batch
+        //
+        size_t task_size = 0;
+        while ( task_size < M_tasks.size()
+                && ! M_open_list.empty() )
         {
-            const PredictState * state = ( best_seq.chain_.empty()
-                                           ? &(*M_first_state)
-                                           : &(best_seq.chain_.back().state()) );
-            M_action_generator->generate( &candidate_actions, *state, wm, best_seq.chain_ );
+            std::pop_heap( M_open_list.begin(), M_open_list.end() );
+            const OpenNode top = M_open_list.back();
+            M_open_list.pop_back();
+
+            if ( top.index_ >= 0
+                 && M_nodes[top.index_].expanded_ )
+            {
+                // already expanded by the replay of the last chain
+                continue;
+            }
 
             //
-            // if shoot action is generated, erase all other actions
+            // warm start: the node far below the value of the replayed chain
+            // is not expanded, but it is still a candidate.
             //
-            if ( ! candidate_actions.empty()
-                 && candidate_actions.front().action().type() == CooperativeAction::Shoot )
+            if ( M_warm_active
+                 && M_warm_start_margin >= 0.0
+                 && top.hvalue_ < M_warm_bound - M_warm_start_margin )
+            {
+                ++pruned_count;
+                continue;
+            }
+
+            const size_t parent_depth = buildPath( top.index_ );
+
+            if ( parent_depth >= M_max_depth
+                 || ( parent_depth > 0
+                      && M_path_buffer[parent_depth - 1]->action().isFinalAction() ) )
             {
-                candidate_actions.erase( candidate_actions.begin() + 1, candidate_actions.end() );
+                // over the max chain length
+                // or, the last action is a final action type.
+                continue;
             }
+
+            ExpandTask & task = M_tasks[task_size];
+            task.wm_ = &wm;
+            task.parent_index_ = top.index_;
+            task.path_.assign( M_path_buffer.begin(), M_path_buffer.end() );
+            task.children_.clear();
+            ++task_size;
         }
 
-#ifdef DEBUG_PRINT
-        if ( best_seq.chain_.empty() )
+        //
+        // generate and evaluate the children of each frontier node
+        //
+        if ( parallel )
         {
-            dlog.addText( Logger::ACTION_CHAIN,
-                          "(BestFirstSearch) >>>> generate (0 empty[-1]) candidate_size=%zd <<<<<",
-                          candidate_actions.size() );
+            M_worker_pool->run( &M_task_ptrs[0], task_size );
         }
         else
         {
-            dlog.addText( Logger::ACTION_CHAIN,
-                          "(BestFirstSearch) >>>> generate (%d %s[%d]) candidate_size=%d <<<<<",
-                          best_seq.chain_.back().index(),
-                          best_seq.chain_.back().action().description(),
-                          best_seq.chain_.back().action().index(),
-                          candidate_actions.size() );
+            for ( size_t i = 0; i < task_size; ++i )
+            {
+                expand( M_tasks[i] );
+            }
+        }
+
+        //
+        // register the children in the fixed order
+        //
+        for ( size_t i = 0; i < task_size; ++i )
+        {
+            if ( ! registerChildren( M_tasks[i], timer ) )
+            {
+                return;
+            }
+        }
+    }
+
+    if ( pruned_count > 0 )
+    {
+        dlog.addText( Logger::ACTION_CHAIN,
+                      "(BestFirstSearch) warm start: pruned %d nodes. bound=%.3f margin=%.3f",
+                      pruned_count, M_warm_bound, M_warm_start_margin );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ActionChainBestFirstSearch::ExpandTask::run()
+{
+    search_->expand( *this );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief generate the children of the frontier node and evaluate them.
+  This method can be called by the worker threads. The search tree
+  must not be modified here.
+ */
+void
+ActionChainBestFirstSearch::expand( ExpandTask & task )
+{
+    const size_t parent_depth = task.path_.size() - 1;
+    const ActionStatePath parent_path( &task.path_[0], parent_depth );
+
+    // generate possible action-state pair at the tail of action chain
+    {
+        const PredictState & state = ( parent_path.empty()
+                                       ? *M_first_state
+                                       : parent_path.back().state() );
+        M_action_generator->generate( &task.children_, state, *task.wm_, parent_path );
+
+        //
+        // if shoot action is generated, erase all other actions
+        //
+        if ( ! task.children_.empty()
+             && task.children_.front().action().type() == CooperativeAction::Shoot )
+        {
+            task.children_.erase( task.children_.begin() + 1, task.children_.end() );
         }
+    }
+
+#ifdef DEBUG_PRINT
+    if ( parent_path.empty() )
+    {
+        dlog.addText( Logger::ACTION_CHAIN,
+                      "(BestFirstSearch) >>>> generate (0 empty[-1]) candidate_size=%zd <<<<<",
+                      task.children_.size() );
+    }
+    else
+    {
+        dlog.addText( Logger::ACTION_CHAIN,
+                      "(BestFirstSearch) >>>> generate (%d %s[%d]) candidate_size=%d <<<<<",
+                      parent_path.back().index(),
+                      parent_path.back().action().description(),
+                      parent_path.back().action().index(),
+                      task.children_.size() );
+    }
 #endif
 
-        for ( std::vector< ActionStatePair >::const_iterator it = candidate_actions.begin(),
-                  end = candidate_actions.end();
+    const size_t size = task.children_.size();
+    if ( size == 0 )
+    {
+        return;
+    }
+
+    if ( parent_depth == 0 )
+    {
+        for ( std::vector< ActionStatePair >::iterator it = task.children_.begin(),
+                  end = task.children_.end();
               it != end;
               ++it )
         {
-            ++M_node_count;
+            double penalty = M_evaluator->getFirstActionPenalty( *M_first_state, *it );
+            it->setPenalty( penalty );
+        }
+    }
 
-            Sequence candidate_seq = best_seq;
-            candidate_seq.chain_.push_back( *it );
+    // all children share the same parent path
+    task.values_.resize( size );
+    M_evaluator->evaluateBatch( *M_first_state, parent_path, task.children_, &task.values_[0] );
 
-            if ( candidate_seq.chain_.size() == 1 )
-            {
-                double penalty = M_evaluator->getFirstActionPenalty( *M_first_state, *it );
-                candidate_seq.chain_.back().setPenalty( penalty );
-            }
+    for ( size_t i = 0; i < size; ++i )
+    {
+        ActionStatePair & pair = task.children_[i];
+        const CooperativeAction & first_action = ( parent_depth == 0
+                                                   ? pair.action()
+                                                   : parent_path.front().action() );
+
+        double value = task.values_[i];
+        if ( M_use_last_decision
+             && first_action.targetPlayerUnum() != M_last_target_player_unum )
+        {
+            // hysteresis against changing the receiver of the last decision
+            if ( value > 0.0 ) value *= 0.9;
+            else value /= 0.9;
+        }
+        pair.setValue( value );
+    }
+}
 
-            double value = M_evaluator->evaluate( *M_first_state, candidate_seq.chain_ );
-#ifdef USE_LAST_DECISION
-            if ( M_last_search_time.cycle() == wm.time().cycle() - 1
-                 && M_last_target_player_unum != Unum_Unknown )
-            {
-                if ( candidate_seq.chain_.front().action().targetPlayerUnum() != M_last_target_player_unum )
-                {
-                    if ( value > 0.0 ) value *= 0.9;
-                    else value /= 0.9;
-                }
-            }
-#endif
-            candidate_seq.value_ = value;
-            candidate_seq.hvalue_ = value;
-            candidate_seq.chain_.back().setValue( value );
+/*-------------------------------------------------------------------*/
+/*!
+  \brief add the evaluated children into the search tree.
+  \return false if the number of nodes reaches the limit.
+ */
+bool
+ActionChainBestFirstSearch::registerChildren( const ExpandTask & task,
+                                              const Timer & timer )
+{
+    const size_t parent_depth = task.path_.size() - 1;
 
+    for ( std::vector< ActionStatePair >::const_iterator it = task.children_.begin(),
+              end = task.children_.end();
+          it != end;
+          ++it )
+    {
+        ++M_node_count;
 
-            if ( dlog.isEnabled( Logger::PLAN ) )
-            {
-                debugPrintSequence( M_node_count, candidate_seq );
-            }
+        M_nodes.push_back( Node( task.parent_index_, *it ) );
+        const int index = static_cast< int >( M_nodes.size() ) - 1;
+        const ActionStatePair & pair = M_nodes.back().pair_;
+        const double value = pair.value();
 
-            if ( candidate_seq.value_ > M_best_sequence.value_ )
-            {
-                dlog.addText( Logger::ACTION_CHAIN,
-                              "(BestFirstSearch) <<<< updated best to index %d", M_node_count );
-                M_best_sequence_index = M_node_count;
-                M_best_sequence = candidate_seq;
-            }
+        if ( dlog.isEnabled( Logger::PLAN ) )
+        {
+            const size_t depth = buildPath( index );
+            debugPrintSequence( M_node_count, ActionStatePath( &M_path_buffer[0], depth ), value );
+        }
 
-            if ( M_node_count >= M_max_traversal )
-            {
-                dlog.addText( Logger::ACTION_CHAIN,
-                              "(BestFirstSearch) ***** over max node size *****" );
-                return;
-            }
+        if ( value > M_best_sequence.value_ )
+        {
+            dlog.addText( Logger::ACTION_CHAIN,
+                          "(BestFirstSearch) <<<< updated best to index %d", M_node_count );
+            M_best_sequence_index = M_node_count;
+            M_best_sequence.value_ = value;
+            M_best_sequence_msec = timer.elapsedReal();
+            M_best_node_index = index;
+        }
+
+        if ( M_node_count >= M_max_traversal )
+        {
+            dlog.addText( Logger::ACTION_CHAIN,
+                          "(BestFirstSearch) ***** over max node size *****" );
+            return false;
+        }
+
+        //
+        // the same state has already been reached by the better chain.
+        // the node is kept as a leaf, but it is not expanded.
+        //
+        if ( M_transposition_table
+             && parent_depth + 1 < M_max_depth
+             && ! pair.action().isFinalAction()
+             && M_transposition_table->isDominated( pair.state(), parent_depth + 1, value ) )
+        {
+            continue;
+        }
+
+        M_open_list.push_back( OpenNode( value, index ) );
+        std::push_heap( M_open_list.begin(), M_open_list.end() );
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief set the chain from the root state to the node into M_path_buffer.
+  One extra slot is always kept at the tail for the child node.
+  \return length of the chain
+ */
+size_t
+ActionChainBestFirstSearch::buildPath( const int index )
+{
+    size_t depth = 0;
+    for ( int i = index; i >= 0; i = M_nodes[i].parent_ )
+    {
+        ++depth;
+    }
+
+    M_path_buffer.resize( depth + 1 );
+
+    size_t pos = depth;
+    for ( int i = index; i >= 0; i = M_nodes[i].parent_ )
+    {
+        M_path_buffer[--pos] = &M_nodes[i].pair_;
+    }
+
+    return depth;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ActionChainBestFirstSearch::buildBestSequence()
+{
+    if ( M_best_node_index < 0 )
+    {
+        return;
+    }
+
+    M_best_sequence.chain_.clear();
+    for ( int i = M_best_node_index; i >= 0; i = M_nodes[i].parent_ )
+    {
+        M_best_sequence.chain_.push_back( M_nodes[i].pair_ );
+    }
+    std::reverse( M_best_sequence.chain_.begin(), M_best_sequence.chain_.end() );
+
+    M_best_sequence.hvalue_ = M_best_sequence.value_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check if the last search result can be reused in this search.
+ */
+void
+ActionChainBestFirstSearch::prepareWarmStart( const WorldModel & wm )
+{
+    M_warm_active = false;
+    M_warm_bound = -std::numeric_limits< double >::max();
+
+    if ( ! M_warm_start
+         || M_last_best_chain.empty() )
+    {
+        return;
+    }
+
+    if ( M_last_search_time.cycle() != wm.time().cycle() - 1
+         || M_last_ball_holder_unum != M_first_state->ballHolder().unum()
+         || ! M_last_ball_pos.isValid()
+         || M_last_ball_pos.dist2( wm.ball().pos() ) > std::pow( WARM_BALL_MOVE_THR, 2 ) )
+    {
+        dlog.addText( Logger::ACTION_CHAIN,
+                      "(BestFirstSearch) warm start: the last result is not available" );
+        return;
+    }
+
+    M_warm_active = true;
+    dlog.addText( Logger::ACTION_CHAIN,
+                  "(BestFirstSearch) warm start: replay the last chain (length %zd) and %zd first actions",
+                  M_last_best_chain.size(), M_last_top_actions.size() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief re-evaluate the last best chain from the current state before
+  the best first search. The nodes on the chain and the top first actions
+  of the last search are expanded here, so the best value is initialized
+  by the value of the replayed chain.
+  \return false if the number of nodes reaches the limit.
+ */
+bool
+ActionChainBestFirstSearch::replayLastResult( const WorldModel & wm,
+                                              const Timer & timer )
+{
+    if ( ! expandNow( wm, timer, -1 ) )
+    {
+        return false;
+    }
+
+    const int first_action_last = static_cast< int >( M_nodes.size() );
+
+    //
+    // follow the last best chain
+    //
+    size_t matched = 0;
+    int first = 0;
+    int last = first_action_last;
+    for ( size_t depth = 0; depth < M_last_best_chain.size(); ++depth )
+    {
+        const int index = findChild( first, last, M_last_best_chain[depth] );
+        if ( index < 0 )
+        {
+            break;
+        }
+
+        ++matched;
+
+        if ( depth + 1 >= M_max_depth
+             || M_nodes[index].pair_.action().isFinalAction() )
+        {
+            break;
+        }
+
+        first = static_cast< int >( M_nodes.size() );
+        if ( ! expandNow( wm, timer, index ) )
+        {
+            return false;
+        }
+        last = static_cast< int >( M_nodes.size() );
+    }
 
-            q.push( candidate_seq );
+    //
+    // expand the top first actions of the last search
+    //
+    for ( std::vector< ActionSignature >::const_iterator it = M_last_top_actions.begin(),
+              end = M_last_top_actions.end();
+          it != end;
+          ++it )
+    {
+        const int index = findChild( 0, first_action_last, *it );
+        if ( index < 0
+             || M_nodes[index].expanded_
+             || M_max_depth <= 1
+             || M_nodes[index].pair_.action().isFinalAction() )
+        {
+            continue;
         }
+
+        if ( ! expandNow( wm, timer, index ) )
+        {
+            return false;
+        }
+    }
+
+    M_warm_bound = M_best_sequence.value_;
+
+    ++M_warm_search_count;
+    if ( matched > 0 )
+    {
+        ++M_warm_hit_count;
+    }
+
+    if ( M_record_statistics )
+    {
+        Statistics::instance().setWarmStartData( matched > 0 );
     }
 
+    dlog.addText( Logger::ACTION_CHAIN,
+                  "(BestFirstSearch) warm start: matched %zd/%zd of the last chain. bound=%.3f hit rate %.3f (%d/%d)",
+                  matched, M_last_best_chain.size(), M_warm_bound,
+                  static_cast< double >( M_warm_hit_count ) / M_warm_search_count,
+                  M_warm_hit_count, M_warm_search_count );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief expand the node on this thread and register its children.
+  \param index arena index of the node. -1 means the root state.
+  \return false if the number of nodes reaches the limit.
+ */
+bool
+ActionChainBestFirstSearch::expandNow( const WorldModel & wm,
+                                       const Timer & timer,
+                                       const int index )
+{
+    buildPath( index );
+
+    ExpandTask & task = M_tasks[0];
+    task.wm_ = &wm;
+    task.parent_index_ = index;
+    task.path_.assign( M_path_buffer.begin(), M_path_buffer.end() );
+    task.children_.clear();
+
+    expand( task );
+
+    if ( index >= 0 )
+    {
+        M_nodes[index].expanded_ = true;
+    }
+
+    return registerChildren( task, timer );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief find the node that has the same action as the signature.
+  \param first the first arena index of the range
+  \param last the last arena index of the range (not included)
+  \param signature the action to be found
+  \return arena index of the found node. -1 if not found.
+ */
+int
+ActionChainBestFirstSearch::findChild( const int first,
+                                       const int last,
+                                       const ActionSignature & signature ) const
+{
+    for ( int i = first; i < last; ++i )
+    {
+        if ( signature.match( M_nodes[i].pair_.action() ) )
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief record the best chain and the top first actions for the next search.
+ */
+void
+ActionChainBestFirstSearch::saveLastResult()
+{
+    M_last_best_chain.clear();
+    M_last_top_actions.clear();
+
+    if ( ! M_warm_start
+         || M_best_node_index < 0 )
+    {
+        return;
+    }
+
+    M_last_ball_holder_unum = M_first_state->ballHolder().unum();
+    M_last_ball_pos = M_first_state->ball().pos();
+
+    for ( std::vector< ActionStatePair >::const_iterator it = M_best_sequence.chain_.begin(),
+              end = M_best_sequence.chain_.end();
+          it != end;
+          ++it )
+    {
+        M_last_best_chain.push_back( ActionSignature( it->action() ) );
+    }
+
+    std::vector< std::pair< double, int > > first_actions;
+    for ( size_t i = 0; i < M_nodes.size(); ++i )
+    {
+        if ( M_nodes[i].parent_ < 0 )
+        {
+            first_actions.push_back( std::make_pair( M_nodes[i].pair_.value(), static_cast< int >( i ) ) );
+        }
+    }
+
+    const size_t size = std::min( WARM_SIBLING_SIZE, first_actions.size() );
+    std::partial_sort( first_actions.begin(), first_actions.begin() + size, first_actions.end(),
+                       std::greater< std::pair< double, int > >() );
+
+    for ( size_t i = 0; i < size; ++i )
+    {
+        M_last_top_actions.push_back( ActionSignature( M_nodes[first_actions[i].second].pair_.action() ) );
+    }
 }
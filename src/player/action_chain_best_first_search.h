@@ -33,15 +33,132 @@
 #define ACTION_CHAIN_BEST_FIRST_SEARCH_H
 
 #include "action_chain_graph.h"
+#include "action_chain_worker_pool.h"
+#include "cooperative_action.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+
+namespace rcsc {
+class Timer;
+}
 
 class ActionChainBestFirstSearch
     : public ActionChainGraph {
 private:
 
+    /*!
+      \brief search tree node stored in the per-cycle node arena.
+      The action chain is restored by following the parent index.
+     */
+    struct Node {
+        int parent_; //!< parent node index in the arena. -1 means the root state.
+        ActionStatePair pair_; //!< action, its result state and evaluated value
+        bool expanded_; //!< true if the node has already been expanded by the warm start
+
+        Node( const int parent,
+              const ActionStatePair & pair )
+            : parent_( parent ),
+              pair_( pair ),
+              expanded_( false )
+          { }
+    };
+
+    /*!
+      \brief the key to identify the same action in the consecutive cycles
+     */
+    struct ActionSignature {
+        CooperativeAction::Type type_;
+        int target_player_unum_;
+        rcsc::Vector2D target_ball_pos_;
+
+        explicit
+        ActionSignature( const CooperativeAction & action )
+            : type_( action.type() ),
+              target_player_unum_( action.targetPlayerUnum() ),
+              target_ball_pos_( action.targetBallPos() )
+          { }
+
+        bool match( const CooperativeAction & action ) const;
+    };
+
+    /*!
+      \brief entry of the open list
+     */
+    struct OpenNode {
+        double hvalue_; //!< heuristic value used as the priority
+        int index_; //!< node index in the arena. -1 means the root state.
+
+        OpenNode( const double hvalue,
+                  const int index )
+            : hvalue_( hvalue ),
+              index_( index )
+          { }
+
+        bool operator<( const OpenNode & rhs ) const
+          {
+              return hvalue_ < rhs.hvalue_;
+          }
+    };
+
+    /*!
+      \brief generation and evaluation of the children of one frontier node.
+      The task refers only the arena and the read-only data, so the
+      tasks in the same batch can be executed in parallel.
+     */
+    struct ExpandTask
+        : public ActionChainWorkerPool::Task {
+        ActionChainBestFirstSearch * search_;
+        const rcsc::WorldModel * wm_;
+        int parent_index_; //!< arena index of the expanded node
+        std::vector< const ActionStatePair * > path_; //!< chain to the expanded node + one slot for the child
+        std::vector< ActionStatePair > children_; //!< generated and evaluated children
+        std::vector< double > values_; //!< buffer for the batch evaluation
+
+        ExpandTask()
+            : search_( static_cast< ActionChainBestFirstSearch * >( 0 ) ),
+              wm_( static_cast< const rcsc::WorldModel * >( 0 ) ),
+              parent_index_( -1 )
+          { }
+
+        virtual
+        void run();
+    };
+
     rcsc::GameTime M_last_search_time;
     int M_last_target_player_unum;
     rcsc::Vector2D M_last_target_ball_pos;
 
+    std::vector< Node > M_nodes; //!< node arena. cleared at the beginning of each search without releasing the memory.
+    std::vector< OpenNode > M_open_list; //!< binary heap of the open nodes
+    std::vector< const ActionStatePair * > M_path_buffer; //!< work area to create the path view
+    int M_best_node_index; //!< arena index of the best node. -1 means no result.
+
+    //
+    // parallel expansion
+    //
+
+    std::vector< ExpandTask > M_tasks; //!< the size equals to the batch size (= thread size)
+    std::vector< ActionChainWorkerPool::Task * > M_task_ptrs;
+    boost::shared_ptr< ActionChainWorkerPool > M_worker_pool; //!< null if single thread
+    bool M_use_last_decision; //!< if true, the first action with the different receiver of the last decision is penalized
+
+    //
+    // warm start
+    //
+
+    bool M_warm_start; //!< if true, the last search result is reused
+    double M_warm_start_margin; //!< the nodes below (warm bound - margin) are not expanded. negative value disables pruning
+    int M_last_ball_holder_unum;
+    rcsc::Vector2D M_last_ball_pos;
+    std::vector< ActionSignature > M_last_best_chain; //!< the best chain of the last search
+    std::vector< ActionSignature > M_last_top_actions; //!< the top first actions of the last search
+    bool M_warm_active; //!< true if the last search result is available in the current search
+    double M_warm_bound; //!< the best value after the last chain is re-evaluated
+    int M_warm_search_count; //!< the number of the searches that the last result was available
+    int M_warm_hit_count; //!< the number of the searches that the last first action was generated again
+
 public:
 
     ActionChainBestFirstSearch( FieldEvaluator::Ptr evaluator,
@@ -52,10 +169,47 @@ public:
     virtual
     void search( const rcsc::WorldModel & wm );
 
+    /*!
+      \brief set the warm start mode
+      \param on if true, the last best chain is re-evaluated from the current state
+      before the best first search, and its value is used as the initial best value.
+      In addition, the first action with the different receiver of the last decision is penalized.
+      \param prune_margin the nodes whose value is less than
+      (the initial best value - prune_margin) are not expanded. negative value disables pruning.
+     */
+    void setWarmStart( const bool on,
+                       const double prune_margin );
+
+    /*!
+      \brief set the number of threads for the parallel expansion.
+      \param size the number of threads. the same number of frontier nodes are
+      expanded at once. The search result depends on this value,
+      but it is deterministic for the fixed value.
+     */
+    void setThreadSize( const size_t size );
 
 private:
 
-    void doSearch( const rcsc::WorldModel & wm );
+    void doSearch( const rcsc::WorldModel & wm,
+                   const rcsc::Timer & timer );
+
+    void expand( ExpandTask & task );
+    bool registerChildren( const ExpandTask & task,
+                           const rcsc::Timer & timer );
+
+    size_t buildPath( const int index );
+    void buildBestSequence();
+
+    void prepareWarmStart( const rcsc::WorldModel & wm );
+    bool replayLastResult( const rcsc::WorldModel & wm,
+                           const rcsc::Timer & timer );
+    bool expandNow( const rcsc::WorldModel & wm,
+                    const rcsc::Timer & timer,
+                    const int index );
+    int findChild( const int first,
+                   const int last,
+                   const ActionSignature & signature ) const;
+    void saveLastResult();
 
 };
 
@@ -31,6 +31,7 @@
 #include "action_chain_depth_first_search.h"
 
 #include "cooperative_action.h"
+#include "statistics.h"
 
 #include <rcsc/common/logger.h>
 #include <rcsc/time/timer.h>
@@ -63,18 +64,17 @@ ActionChainDepthFirstSearch::ActionChainDepthFirstSearch( FieldEvaluator::Ptr ev
 void
 ActionChainDepthFirstSearch::search( const WorldModel & wm )
 {
+    // the time budget includes the preparation of the root state
+    Timer timer;
+
     clearResult();
 
     M_first_state = PredictState::ConstPtr( new PredictState( wm ) );
 
-#ifdef DEBUG_PROFILE
-    Timer timer;
-#endif
-
     // do search
     {
         std::vector< ActionStatePair > empty_path;
-        doRecursiveSearch( wm, *M_first_state, empty_path, &M_best_sequence );
+        doRecursiveSearch( wm, timer, *M_first_state, empty_path, &M_best_sequence );
     }
 
     if ( M_best_sequence.chain_.empty() )
@@ -85,11 +85,17 @@ ActionChainDepthFirstSearch::search( const WorldModel & wm )
         }
     }
 
+    const double elapsed = timer.elapsedReal();
 #ifdef DEBUG_PROFILE
     dlog.addText( Logger::ACTION_CHAIN,
                   __FILE__": PROFILE size=%d elapsed %f [ms]",
-                  M_node_count, timer.elapsedReal() );
+                  M_node_count, elapsed );
 #endif
+    if ( M_record_statistics )
+    {
+        Statistics::instance().setActionSearchData( M_node_count, elapsed, M_time_over );
+    }
+    recordTranspositionStatistics();
 
 #ifdef DEBUG_PAINT_EVALUATED_POINTS
     debug_paint_evaluated_points();
@@ -102,6 +108,7 @@ ActionChainDepthFirstSearch::search( const WorldModel & wm )
  */
 bool
 ActionChainDepthFirstSearch::doRecursiveSearch( const WorldModel & wm,
+                                                const Timer & timer,
                                                 const PredictState & state,
                                                 const std::vector< ActionStatePair > & path,
                                                 Sequence * result )
@@ -121,6 +128,22 @@ ActionChainDepthFirstSearch::doRecursiveSearch( const WorldModel & wm,
         return false;
     }
 
+    //
+    // check time budget
+    //
+    if ( M_time_over
+         || ( M_time_budget_msec > 0.0
+              && timer.elapsedReal() >= M_time_budget_msec ) )
+    {
+        if ( ! M_time_over )
+        {
+            dlog.addText( Logger::ACTION_CHAIN,
+                          "cut by time budget %.2f [ms]", M_time_budget_msec );
+        }
+        M_time_over = true;
+        return false;
+    }
+
     //
     // check current state
     //
@@ -139,6 +162,19 @@ ActionChainDepthFirstSearch::doRecursiveSearch( const WorldModel & wm,
     g_evaluated_points.push_back( EvalPoint( M_node_count, state.ball().pos(), best_result.value_ ) );
 #endif
 
+    //
+    // the same state has already been reached by the better chain.
+    //
+    if ( M_transposition_table
+         && ! path.empty()
+         && path.size() < M_max_depth
+         && ! path.back().action().isFinalAction()
+         && M_transposition_table->isDominated( state, path.size(), best_result.value_ ) )
+    {
+        *result = best_result;
+        return true;
+    }
+
     //
     // generate candidate actions
     //
@@ -163,7 +199,7 @@ ActionChainDepthFirstSearch::doRecursiveSearch( const WorldModel & wm,
 
         new_path.push_back( *it );
 
-        if ( doRecursiveSearch( wm, (*it).state(), new_path, &candidate_result ) )
+        if ( doRecursiveSearch( wm, timer, (*it).state(), new_path, &candidate_result ) )
         {
             if ( dlog.isEnabled( Logger::PLAN ) )
             {
@@ -177,6 +213,11 @@ ActionChainDepthFirstSearch::doRecursiveSearch( const WorldModel & wm,
             {
                 best_result = candidate_result;
                 M_best_sequence_index = M_node_count;
+                if ( path.empty() )
+                {
+                    // the best sequence of the whole tree is updated only at the root
+                    M_best_sequence_msec = timer.elapsedReal();
+                }
             }
         }
     }
@@ -34,6 +34,10 @@
 
 #include "action_chain_graph.h"
 
+namespace rcsc {
+class Timer;
+}
+
 class ActionChainDepthFirstSearch
     : public ActionChainGraph {
 private:
@@ -52,6 +56,7 @@ public:
 private:
 
     bool doRecursiveSearch( const rcsc::WorldModel & wm,
+                            const rcsc::Timer & timer,
                             const PredictState & state,
                             const std::vector< ActionStatePair > & path,
                             Sequence * result );
@@ -31,6 +31,7 @@
 #include "action_chain_graph.h"
 #include "predict_state.h"
 #include "act_hold_ball.h"
+#include "statistics.h"
 
 #include <rcsc/player/player_agent.h>
 #include <rcsc/common/server_param.h>
@@ -65,8 +66,12 @@ ActionChainGraph::ActionChainGraph( FieldEvaluator::Ptr evaluator,
       M_action_generator( generator ),
       M_max_depth( max_depth ),
       M_max_traversal( max_traversal ),
+      M_time_budget_msec( 0.0 ),
+      M_time_over( false ),
+      M_record_statistics( true ),
       M_node_count( 0 ),
-      M_best_sequence_index( 0 )
+      M_best_sequence_index( 0 ),
+      M_best_sequence_msec( 0.0 )
 {
     M_best_sequence.value_ = -std::numeric_limits< double >::max();
 }
@@ -81,6 +86,34 @@ ActionChainGraph::setFieldEvaluator( FieldEvaluator::Ptr eval )
     M_evaluator = eval;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ActionChainGraph::setTimeBudget( const double msec )
+{
+    M_time_budget_msec = msec;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ActionChainGraph::setTranspositionTable( const double grid_size )
+{
+    if ( grid_size > 0.0 )
+    {
+        M_transposition_table = ActionChainTranspositionTable::Ptr( new ActionChainTranspositionTable( M_max_traversal,
+                                                                                                       grid_size ) );
+    }
+    else
+    {
+        M_transposition_table.reset();
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -89,13 +122,46 @@ void
 ActionChainGraph::clearResult()
 {
     M_node_count = 0;
+    M_time_over = false;
     M_best_sequence.chain_.clear();
     M_best_sequence.value_ = -std::numeric_limits< double >::max();
     M_best_sequence_index = 0;
+    M_best_sequence_msec = 0.0;
+
+    if ( M_transposition_table )
+    {
+        M_transposition_table->clear();
+    }
 
     ActionStatePair::reset_index_count();
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ActionChainGraph::recordTranspositionStatistics()
+{
+    if ( ! M_transposition_table
+         || ! M_record_statistics )
+    {
+        return;
+    }
+
+    dlog.addText( Logger::ACTION_CHAIN,
+                  "(ActionChainGraph) transposition: lookup=%d hit=%d cut=%d size=%zd",
+                  M_transposition_table->lookupCount(),
+                  M_transposition_table->hitCount(),
+                  M_transposition_table->cutCount(),
+                  M_transposition_table->size() );
+
+    Statistics::instance().setTranspositionData( M_transposition_table->lookupCount(),
+                                                 M_transposition_table->hitCount(),
+                                                 M_transposition_table->cutCount(),
+                                                 M_transposition_table->memoryUsage() );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -157,7 +223,7 @@ ActionChainGraph::debugSendBestSequence( PlayerAgent * agent ) const
             s0 = &current_state;
             s1 = &(path[0].state());
 #if 0
-            for ( PredictPlayerObject::Cont::const_iterator p = s1->ourPlayers().begin(), end = s1->ourPlayers().end();
+            for ( PredictState::PlayerCont::const_iterator p = s1->ourPlayers().begin(), end = s1->ourPlayers().end();
                   p != end;
                   ++p )
             {
@@ -250,14 +316,25 @@ ActionChainGraph::debugSendBestSequence( PlayerAgent * agent ) const
 void
 ActionChainGraph::debugPrintSequence( const size_t count,
                                       const Sequence & sequence )
+{
+    debugPrintSequence( count, ActionStatePath( sequence.chain_ ), sequence.value_ );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ActionChainGraph::debugPrintSequence( const size_t count,
+                                      const ActionStatePath & path,
+                                      const double value )
 {
     dlog.addText( Logger::PLAN,
                   "%zd: evaluation=%lf",
-                  count, sequence.value_ );
+                  count, value );
 
     const PredictState & current_state = *M_first_state;
 
-    const std::vector< ActionStatePair > & path = sequence.chain_;
     const size_t size = path.size();
 
     for ( size_t i = 0; i < size; ++i )
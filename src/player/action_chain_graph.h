@@ -37,6 +37,8 @@
 #include "predict_state.h"
 
 #include "action_state_pair.h"
+#include "action_state_path.h"
+#include "action_chain_transposition_table.h"
 
 #include <rcsc/geom/vector_2d.h>
 
@@ -74,11 +76,18 @@ protected:
 
     const size_t M_max_depth;
     const size_t M_max_traversal;
+    double M_time_budget_msec; //!< time budget for one search. non-positive value means unlimited.
+    bool M_time_over; //!< true if the last search was stopped by the time budget
+    bool M_record_statistics; //!< if false, the search result is not recorded to Statistics
 
     size_t M_node_count;
 
+    //! duplicated state detector. null if disabled.
+    ActionChainTranspositionTable::Ptr M_transposition_table;
+
     Sequence M_best_sequence;
     int M_best_sequence_index;
+    double M_best_sequence_msec; //!< elapsed time when the best sequence was found [ms]
 
 private:
 
@@ -110,9 +119,32 @@ public:
 
     void setFieldEvaluator( FieldEvaluator::Ptr eval );
 
+    /*!
+      \brief set the time budget for one search
+      \param msec time budget [ms]. non-positive value means unlimited.
+     */
+    void setTimeBudget( const double msec );
+
+    /*!
+      \brief enable the transposition table
+      \param grid_size quantization step of the ball position. non-positive value disables the table.
+     */
+    void setTranspositionTable( const double grid_size );
+
+    /*!
+      \brief set the statistics recording switch.
+      the searchers for the benchmark must not record their results.
+      \param on if false, the search result is not recorded to Statistics
+     */
+    void setRecordStatistics( const bool on )
+      {
+          M_record_statistics = on;
+      }
+
 protected:
 
     void clearResult();
+    void recordTranspositionStatistics();
     void createDefaultHold( const rcsc::WorldModel & wm );
 
 public:
@@ -127,6 +159,34 @@ public:
           return M_best_sequence.chain_.front().action();
       };
 
+    size_t nodeCount() const
+      {
+          return M_node_count;
+      }
+
+    /*!
+      \brief get the node count when the best sequence was found
+      \return node count. non-positive value means the default action.
+     */
+    int bestSequenceIndex() const
+      {
+          return M_best_sequence_index;
+      }
+
+    /*!
+      \brief get the elapsed time when the best sequence was found
+      \return elapsed time from the beginning of search() [ms]
+     */
+    double bestSequenceMSec() const
+      {
+          return M_best_sequence_msec;
+      }
+
+    bool isTimeOver() const
+      {
+          return M_time_over;
+      }
+
 protected:
 
     //
@@ -135,6 +195,9 @@ protected:
 
     void debugPrintSequence( const size_t count,
                              const Sequence & sequence );
+    void debugPrintSequence( const size_t count,
+                             const ActionStatePath & path,
+                             const double value );
 
 public:
 
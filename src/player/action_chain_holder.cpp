@@ -38,6 +38,7 @@
 #include "action_chain_best_first_search.h"
 #include "action_chain_depth_first_search.h"
 #include "action_chain_monte_calro_tree_search.h"
+#include "action_chain_benchmark.h"
 
 #include "options.h"
 
@@ -45,6 +46,8 @@
 #include <rcsc/param/cmd_line_parser.h>
 #include <rcsc/param/param_map.h>
 
+#include <iostream>
+#include <algorithm>
 
 using namespace rcsc;
 
@@ -53,7 +56,8 @@ using namespace rcsc;
 
  */
 ActionChainHolder::ActionChainHolder()
-    : M_graph()
+    : M_graph(),
+      M_benchmark()
 {
 
 }
@@ -84,20 +88,7 @@ ActionChainHolder::init( FieldEvaluator::Ptr evaluator,
     //           << "  max_evaluate_size = " << Options::i().maxEvaluateSize() << '\n'
     //           << std::flush;
 
-#if 1
-    M_graph = ActionChainGraph::Ptr( new ActionChainBestFirstSearch( evaluator,
-                                                                     generator,
-                                                                     Options::i().maxChainLength(),
-                                                                     Options::i().maxEvaluateSize() ) );
-#else
-    if ( Options::i().chainSearchMethod() == "BestFirstSearch" )
-    {
-        M_graph = ActionChainGraph::Ptr( new ActionChainBestFirstSearch( evaluator,
-                                                                         generator,
-                                                                         Options::i().maxChainLength(),
-                                                                         Options::i().maxEvaluateSize() ) );
-    }
-    else if ( Options::i().chainSearchMethod() == "DepthFirstSearch" )
+    if ( Options::i().chainSearchMethod() == "DepthFirstSearch" )
     {
         M_graph = ActionChainGraph::Ptr( new ActionChainDepthFirstSearch( evaluator,
                                                                           generator,
@@ -113,15 +104,29 @@ ActionChainHolder::init( FieldEvaluator::Ptr evaluator,
     }
     else
     {
-        std::cerr << "Unknown search method ["
-                  << Options::i().chainSearchMethod() << ']'
-                  << " use the BestFirstSearch instead." << std::endl;
-        M_graph = ActionChainGraph::Ptr( new ActionChainBestFirstSearch( evaluator,
-                                                                         generator,
-                                                                         Options::i().maxChainLength(),
-                                                                         Options::i().maxEvaluateSize() ) );
+        if ( Options::i().chainSearchMethod() != "BestFirstSearch" )
+        {
+            std::cerr << "Unknown search method ["
+                      << Options::i().chainSearchMethod() << ']'
+                      << " use the BestFirstSearch instead." << std::endl;
+        }
+        ActionChainBestFirstSearch * best_first = new ActionChainBestFirstSearch( evaluator,
+                                                                                 generator,
+                                                                                 Options::i().maxChainLength(),
+                                                                                 Options::i().maxEvaluateSize() );
+        best_first->setWarmStart( Options::i().chainSearchWarmStart(),
+                                  Options::i().chainSearchWarmStartMargin() );
+        best_first->setThreadSize( std::max( 1, Options::i().chainSearchThreads() ) );
+        M_graph = ActionChainGraph::Ptr( best_first );
+    }
+
+    M_graph->setTimeBudget( Options::i().chainSearchBudgetMSec() );
+    M_graph->setTranspositionTable( Options::i().chainSearchTranspositionGrid() );
+
+    if ( Options::i().chainSearchBenchmark() )
+    {
+        M_benchmark = ActionChainBenchmark::Ptr( new ActionChainBenchmark( evaluator, generator ) );
     }
-#endif
 }
 
 
@@ -133,6 +138,11 @@ void
 ActionChainHolder::setFieldEvaluator( FieldEvaluator::Ptr eval )
 {
     M_graph->setFieldEvaluator( eval );
+
+    if ( M_benchmark )
+    {
+        M_benchmark->setFieldEvaluator( eval );
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -151,4 +161,22 @@ ActionChainHolder::update( const WorldModel & wm )
     s_update_time = wm.time();
 
     M_graph->search( wm );
+
+    if ( M_benchmark )
+    {
+        M_benchmark->run( wm, *M_graph );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ActionChainHolder::printBenchmark( std::ostream & os ) const
+{
+    if ( M_benchmark )
+    {
+        M_benchmark->print( os );
+    }
 }
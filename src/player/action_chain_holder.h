@@ -37,15 +37,22 @@
 #include "action_generator.h"
 #include "cooperative_action.h"
 
+#include <iosfwd>
+
 namespace rcsc {
 class WorldModel;
 }
 
+class ActionChainBenchmark;
+
 class ActionChainHolder {
 private:
 
     ActionChainGraph::Ptr M_graph;
 
+    //! comparative benchmark of the searchers. created only in the benchmark mode.
+    boost::shared_ptr< ActionChainBenchmark > M_benchmark;
+
 private:
 
     /*!
@@ -80,6 +87,12 @@ public:
 
     void update( const rcsc::WorldModel & wm );
 
+    /*!
+      \brief print the result of the searcher benchmark, if enabled.
+      \param os reference to the output stream
+     */
+    void printBenchmark( std::ostream & os ) const;
+
 };
 
 #endif
@@ -76,26 +76,25 @@ ActionChainMonteCalroTreeSearch::search( const WorldModel & wm )
 
     M_first_state = PredictState::ConstPtr( new PredictState( wm ) );
 
-#ifdef DEBUG_PROFILE
     Timer timer;
-#endif
 
-    doSearch( wm );
+    doSearch( wm, timer );
 
     if ( M_best_sequence.chain_.empty() )
     {
         createDefaultHold( wm );
     }
 
-#ifdef DEBUG_PROFILE
     const double elapsed = timer.elapsedReal();
+#ifdef DEBUG_PROFILE
     dlog.addText( Logger::ACTION_CHAIN,
                   __FILE__": PROFILE size=%d elapsed %f [ms]",
                   M_node_count, elapsed );
-    Statistics::instance().setActionSearchData( M_node_count, elapsed );
-#else
-    Statistics::instance().setActionSearchData( M_node_count, 0.0 );
 #endif
+    if ( M_record_statistics )
+    {
+        Statistics::instance().setActionSearchData( M_node_count, elapsed, M_time_over );
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -103,7 +102,8 @@ ActionChainMonteCalroTreeSearch::search( const WorldModel & wm )
 
  */
 void
-ActionChainMonteCalroTreeSearch::doSearch( const WorldModel & wm )
+ActionChainMonteCalroTreeSearch::doSearch( const WorldModel & wm,
+                                           const Timer & timer )
 {
     std::vector< ActionStatePair > sequence;
 
@@ -117,12 +117,21 @@ ActionChainMonteCalroTreeSearch::doSearch( const WorldModel & wm )
 
     for ( size_t i = 0; i < M_max_traversal; ++i )
     {
+        if ( M_time_budget_msec > 0.0
+             && timer.elapsedReal() >= M_time_budget_msec )
+        {
+            dlog.addText( Logger::ACTION_CHAIN,
+                          __FILE__" (doSearch) over time budget %.2f [ms]. playout=%zd",
+                          M_time_budget_msec, i );
+            M_time_over = true;
+            break;
+        }
 #ifdef DEBUG_PRINT
         dlog.addText( Logger::ACTION_CHAIN,
                       ">>>>>>>>>>>>>>>>>>>> playout %d <<<<<<<<<<<<<<<<<<<<",
                       i + 1 );
 #endif
-        doPlayoutRecursive( wm, sequence, root_node );
+        doPlayoutRecursive( wm, timer, sequence, root_node );
     }
 
 #ifdef DEBUG_PRINT
@@ -138,6 +147,7 @@ ActionChainMonteCalroTreeSearch::doSearch( const WorldModel & wm )
  */
 double
 ActionChainMonteCalroTreeSearch::doPlayoutRecursive( const WorldModel & wm,
+                                                     const Timer & timer,
                                                      std::vector< ActionStatePair > & sequence,
                                                      boost::shared_ptr< Node > node )
 {
@@ -168,6 +178,7 @@ ActionChainMonteCalroTreeSearch::doPlayoutRecursive( const WorldModel & wm,
                   ++it )
             {
                 boost::shared_ptr< Node > child_node( new Node( M_node_count, *it ) );
+                child_node->msec_ = timer.elapsedReal();
                 ++M_node_count;
 
                 sequence.push_back( *it );
@@ -210,7 +221,7 @@ ActionChainMonteCalroTreeSearch::doPlayoutRecursive( const WorldModel & wm,
 
     sequence.push_back( best_ucb_child->data_ );
 
-    double best_child_value = doPlayoutRecursive( wm, sequence, best_ucb_child );
+    double best_child_value = doPlayoutRecursive( wm, timer, sequence, best_ucb_child );
     // double value = node->original_value_ + M_gamma * doSearch( wm, sequence, best_child );
     best_ucb_child->updateValue( best_child_value, node->count_ );
 
@@ -404,6 +415,9 @@ ActionChainMonteCalroTreeSearch::buildBestSequence( boost::shared_ptr< Node > no
 #endif
         sequence.chain_.push_back( best_child->data_ );
         sequence.value_ = best_value;
+        M_best_sequence_index = best_child->index_ + 1;
+        // the whole sequence is available when its last node is created
+        M_best_sequence_msec = best_child->msec_;
         buildBestSequence( best_child, sequence );
     }
 }
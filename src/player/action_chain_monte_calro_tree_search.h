@@ -36,6 +36,10 @@
 
 #include <boost/shared_ptr.hpp>
 
+namespace rcsc {
+class Timer;
+}
+
 class ActionChainMonteCalroTreeSearch
     : public ActionChainGraph {
 private:
@@ -49,6 +53,7 @@ private:
         double original_value_; //!< original evaluation
         double cumulative_value_;
         double ucb_value_; //!< negative value means infinite value.
+        double msec_; //!< elapsed time when the node was created [ms]
 
         Node( const size_t index,
               ActionStatePair data )
@@ -58,7 +63,8 @@ private:
               count_( 0 ),
               original_value_( 0.0 ),
               cumulative_value_( 0.0 ),
-              ucb_value_( -1.0 )
+              ucb_value_( -1.0 ),
+              msec_( 0.0 )
           { }
 
         boost::shared_ptr< Node > findBestUCBChild();
@@ -92,9 +98,11 @@ public:
 
 private:
 
-    void doSearch( const rcsc::WorldModel & wm );
+    void doSearch( const rcsc::WorldModel & wm,
+                   const rcsc::Timer & timer );
 
     double doPlayoutRecursive( const rcsc::WorldModel & wm,
+                               const rcsc::Timer & timer,
                                std::vector< ActionStatePair > & sequence,
                                boost::shared_ptr< Node > node );
 
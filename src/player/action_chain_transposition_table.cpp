@@ -0,0 +1,227 @@
+// -*-c++-*-
+
+/*!
+  \file action_chain_transposition_table.cpp
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+
+#include "action_chain_transposition_table.h"
+
+#include "predict_state.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace rcsc;
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief mix the bits of the key (splitmix64 finalizer)
+ */
+inline
+boost::uint64_t
+hash_key( boost::uint64_t x )
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief quantize the coordinate value into the 16 bits unsigned value
+ */
+inline
+boost::uint64_t
+quantize( const double value,
+          const double grid_size )
+{
+    const long q = static_cast< long >( std::floor( value / grid_size ) ) + 0x8000;
+    return static_cast< boost::uint64_t >( std::min( std::max( q, 0L ), 0xffffL ) );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ActionChainTranspositionTable::ActionChainTranspositionTable( const size_t max_size,
+                                                              const double grid_size )
+    : M_grid_size( std::max( 0.01, grid_size ) ),
+      M_mask( 0 ),
+      M_search_id( 0 ),
+      M_size( 0 ),
+      M_lookup_count( 0 ),
+      M_hit_count( 0 ),
+      M_cut_count( 0 )
+{
+    // keep the load factor less than 0.5
+    size_t capacity = 64;
+    while ( capacity < max_size * 2 )
+    {
+        capacity *= 2;
+    }
+
+    Entry empty;
+    empty.key_ = 0;
+    empty.value_ = 0.0;
+    empty.depth_value_ = 0.0;
+    empty.value_depth_ = 0;
+    empty.depth_ = 0;
+    empty.search_id_ = 0;
+
+    M_entries.assign( capacity, empty );
+    M_mask = capacity - 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ActionChainTranspositionTable::clear()
+{
+    ++M_search_id;
+    if ( M_search_id == 0 )
+    {
+        // wrapped around. invalidate all entries explicitly.
+        for ( std::vector< Entry >::iterator it = M_entries.begin(), end = M_entries.end();
+              it != end;
+              ++it )
+        {
+            it->search_id_ = 0;
+        }
+        M_search_id = 1;
+    }
+
+    M_size = 0;
+    M_lookup_count = 0;
+    M_hit_count = 0;
+    M_cut_count = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ActionChainTranspositionTable::Key
+ActionChainTranspositionTable::makeKey( const PredictState & state ) const
+{
+    const AbstractPlayerObject & holder = state.ballHolder();
+
+    const Key side = ( holder.side() == LEFT ? 1
+                       : holder.side() == RIGHT ? 2
+                       : 0 );
+    const Key unum = static_cast< Key >( std::max( 0, holder.unum() ) & 0x1f );
+    const Key spent_time = static_cast< Key >( std::min( state.spentTime(), 0xffffUL ) );
+
+    return ( side
+             | ( unum << 2 )
+             | ( spent_time << 7 )
+             | ( quantize( state.ball().pos().x, M_grid_size ) << 23 )
+             | ( quantize( state.ball().pos().y, M_grid_size ) << 39 ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ActionChainTranspositionTable::isDominated( const PredictState & state,
+                                            const size_t depth,
+                                            const double value )
+{
+    ++M_lookup_count;
+
+    const Key key = makeKey( state );
+
+    size_t i = static_cast< size_t >( hash_key( key ) ) & M_mask;
+    while ( true )
+    {
+        Entry & e = M_entries[i];
+
+        if ( e.search_id_ != M_search_id )
+        {
+            // empty slot. register the new state if the table has enough space.
+            if ( M_size * 2 < M_entries.size() )
+            {
+                e.key_ = key;
+                e.value_ = value;
+                e.depth_value_ = value;
+                e.value_depth_ = static_cast< boost::uint32_t >( depth );
+                e.depth_ = static_cast< boost::uint32_t >( depth );
+                e.search_id_ = M_search_id;
+                ++M_size;
+            }
+            return false;
+        }
+
+        if ( e.key_ == key )
+        {
+            ++M_hit_count;
+
+            if ( ( e.value_depth_ <= depth
+                   && e.value_ >= value )
+                 || ( e.depth_ <= depth
+                      && e.depth_value_ >= value ) )
+            {
+                ++M_cut_count;
+                return true;
+            }
+
+            if ( value > e.value_
+                 || ( value == e.value_ && depth < e.value_depth_ ) )
+            {
+                e.value_ = value;
+                e.value_depth_ = static_cast< boost::uint32_t >( depth );
+            }
+
+            // the shorter chain has more room for the following actions.
+            if ( depth < e.depth_
+                 || ( depth == e.depth_ && value > e.depth_value_ ) )
+            {
+                e.depth_value_ = value;
+                e.depth_ = static_cast< boost::uint32_t >( depth );
+            }
+            return false;
+        }
+
+        i = ( i + 1 ) & M_mask;
+    }
+
+    return false;
+}
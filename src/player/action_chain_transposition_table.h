@@ -0,0 +1,142 @@
+// -*-c++-*-
+
+/*!
+  \file action_chain_transposition_table.h
+  \brief transposition table for the action chain search Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+#ifndef ACTION_CHAIN_TRANSPOSITION_TABLE_H
+#define ACTION_CHAIN_TRANSPOSITION_TABLE_H
+
+#include <boost/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
+
+#include <vector>
+#include <cstddef>
+
+class PredictState;
+
+/*!
+  \class ActionChainTranspositionTable
+  \brief hash table of the predicted states reached in one search.
+
+  Two states are regarded as the same if they have the same ball
+  holder, the same spent time and the ball position in the same grid
+  cell. When the state is reached again by a different chain, it is not
+  expanded if a recorded chain is not longer and its value is not less
+  than the new one (dominated duplicate). Each state records two chains:
+  the chain with the best value, and the shortest chain. A better value
+  found by a longer chain never overwrites the shortest chain, and vice versa.
+
+  The table uses open addressing with a fixed capacity. The entries are
+  invalidated by the search id, so clearing the table costs nothing.
+*/
+class ActionChainTranspositionTable {
+public:
+
+    typedef boost::shared_ptr< ActionChainTranspositionTable > Ptr; //!< pointer type alias
+    typedef boost::uint64_t Key; //!< state key type
+
+private:
+
+    struct Entry {
+        Key key_;
+        double value_; //!< the best value of the chains reaching this state
+        double depth_value_; //!< the best value of the shortest chains
+        boost::uint32_t value_depth_; //!< chain length of the best value chain
+        boost::uint32_t depth_; //!< the shortest chain length
+        boost::uint32_t search_id_; //!< the entry is empty if this differs from the current id
+    };
+
+    const double M_grid_size; //!< quantization step of the ball position
+
+    std::vector< Entry > M_entries; //!< the size is always a power of two
+    size_t M_mask;
+    boost::uint32_t M_search_id;
+    size_t M_size; //!< the number of used entries in the current search
+
+    // statistics of the current search
+    int M_lookup_count;
+    int M_hit_count; //!< the number of lookups that found the same state
+    int M_cut_count; //!< the number of dominated duplicates
+
+    // not used
+    ActionChainTranspositionTable();
+    ActionChainTranspositionTable( const ActionChainTranspositionTable & );
+    ActionChainTranspositionTable & operator=( const ActionChainTranspositionTable & );
+
+public:
+
+    /*!
+      \brief allocate the table
+      \param max_size the maximum number of states registered in one search
+      \param grid_size quantization step of the ball position
+     */
+    ActionChainTranspositionTable( const size_t max_size,
+                                   const double grid_size );
+
+    /*!
+      \brief invalidate all entries and reset the statistics for the new search
+     */
+    void clear();
+
+    /*!
+      \brief create the key of the state
+      \param state predicted state
+      \return key value
+     */
+    Key makeKey( const PredictState & state ) const;
+
+    /*!
+      \brief register the state reached by the chain, and check if it is a dominated duplicate.
+      \param state the state at the tail of the chain
+      \param depth the length of the chain
+      \param value evaluated value of the chain
+      \return true if the same state was already reached by the better or equal chain.
+     */
+    bool isDominated( const PredictState & state,
+                      const size_t depth,
+                      const double value );
+
+    double gridSize() const { return M_grid_size; }
+
+    int lookupCount() const { return M_lookup_count; }
+    int hitCount() const { return M_hit_count; }
+    int cutCount() const { return M_cut_count; }
+    size_t size() const { return M_size; }
+
+    /*!
+      \brief get the memory size allocated for the entries
+      \return memory size in bytes
+     */
+    size_t memoryUsage() const
+      {
+          return M_entries.capacity() * sizeof( Entry );
+      }
+
+};
+
+#endif
@@ -0,0 +1,203 @@
+// -*-c++-*-
+
+/*!
+  \file action_chain_worker_pool.cpp
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+
+#include "action_chain_worker_pool.h"
+
+#include <iostream>
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ActionChainWorkerPool::ActionChainWorkerPool( const size_t thread_size )
+    : M_tasks( static_cast< Task * const * >( 0 ) ),
+      M_task_size( 0 ),
+      M_next_task( 0 ),
+      M_done_count( 0 ),
+      M_generation( 0 ),
+      M_quit( false )
+{
+    pthread_cond_init( &M_start_cond, NULL );
+    pthread_cond_init( &M_done_cond, NULL );
+
+    for ( size_t i = 1; i < thread_size; ++i )
+    {
+        pthread_t thread;
+        if ( pthread_create( &thread, NULL, &ActionChainWorkerPool::thread_main, this ) != 0 )
+        {
+            std::cerr << "(ActionChainWorkerPool) could not create the worker thread. "
+                      << M_threads.size() + 1 << " threads are used." << std::endl;
+            break;
+        }
+        M_threads.push_back( thread );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ActionChainWorkerPool::~ActionChainWorkerPool()
+{
+    {
+        ScopedLock lock( M_mutex );
+        M_quit = true;
+        pthread_cond_broadcast( &M_start_cond );
+    }
+
+    for ( std::vector< pthread_t >::iterator it = M_threads.begin(), end = M_threads.end();
+          it != end;
+          ++it )
+    {
+        pthread_join( *it, NULL );
+    }
+
+    pthread_cond_destroy( &M_start_cond );
+    pthread_cond_destroy( &M_done_cond );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ActionChainWorkerPool::run( Task * const * tasks,
+                            const size_t size )
+{
+    if ( size == 0 )
+    {
+        return;
+    }
+
+    if ( M_threads.empty()
+         || size == 1 )
+    {
+        for ( size_t i = 0; i < size; ++i )
+        {
+            tasks[i]->run();
+        }
+        return;
+    }
+
+    M_mutex.lock();
+
+    M_tasks = tasks;
+    M_task_size = size;
+    M_next_task = 0;
+    M_done_count = 0;
+    ++M_generation;
+    pthread_cond_broadcast( &M_start_cond );
+
+    runTasks();
+
+    while ( M_done_count < M_task_size )
+    {
+        pthread_cond_wait( &M_done_cond, M_mutex.native() );
+    }
+
+    M_tasks = static_cast< Task * const * >( 0 );
+    M_task_size = 0;
+    M_next_task = 0;
+
+    M_mutex.unlock();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void *
+ActionChainWorkerPool::thread_main( void * arg )
+{
+    static_cast< ActionChainWorkerPool * >( arg )->workerLoop();
+    return NULL;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ActionChainWorkerPool::workerLoop()
+{
+    unsigned long generation = 0;
+
+    M_mutex.lock();
+
+    while ( true )
+    {
+        while ( ! M_quit
+                && generation == M_generation )
+        {
+            pthread_cond_wait( &M_start_cond, M_mutex.native() );
+        }
+
+        if ( M_quit )
+        {
+            break;
+        }
+
+        generation = M_generation;
+        runTasks();
+    }
+
+    M_mutex.unlock();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief take and execute the tasks until the batch becomes empty.
+  M_mutex must be locked by the caller. The lock is released while a
+  task is running.
+ */
+void
+ActionChainWorkerPool::runTasks()
+{
+    while ( M_next_task < M_task_size )
+    {
+        Task * task = M_tasks[M_next_task];
+        ++M_next_task;
+
+        M_mutex.unlock();
+        task->run();
+        M_mutex.lock();
+
+        ++M_done_count;
+        if ( M_done_count == M_task_size )
+        {
+            pthread_cond_broadcast( &M_done_cond );
+        }
+    }
+}
@@ -0,0 +1,125 @@
+// -*-c++-*-
+
+/*!
+  \file action_chain_worker_pool.h
+  \brief worker thread pool for the parallel action chain search Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+#ifndef ACTION_CHAIN_WORKER_POOL_H
+#define ACTION_CHAIN_WORKER_POOL_H
+
+#include "mutex.h"
+
+#include <pthread.h>
+
+#include <vector>
+#include <cstddef>
+
+/*!
+  \class ActionChainWorkerPool
+  \brief fixed size thread pool that runs a batch of tasks.
+
+  The thread that calls run() also executes the tasks. Therefore,
+  (thread_size - 1) worker threads are created.
+  run() returns after all tasks in the batch are finished, so the
+  tasks can refer the caller's data without any lock.
+*/
+class ActionChainWorkerPool {
+public:
+
+    /*!
+      \brief abstract task
+     */
+    class Task {
+    public:
+        virtual
+        ~Task()
+          { }
+
+        virtual
+        void run() = 0;
+    };
+
+private:
+
+    std::vector< pthread_t > M_threads;
+
+    Mutex M_mutex;
+    pthread_cond_t M_start_cond; //!< notify workers of the new batch
+    pthread_cond_t M_done_cond; //!< notify the caller of the batch end
+
+    Task * const * M_tasks; //!< current batch
+    size_t M_task_size;
+    size_t M_next_task; //!< index of the task to be taken next
+    size_t M_done_count; //!< the number of finished tasks in the batch
+    unsigned long M_generation; //!< batch counter
+    bool M_quit;
+
+    // not used
+    ActionChainWorkerPool( const ActionChainWorkerPool & );
+    ActionChainWorkerPool & operator=( const ActionChainWorkerPool & );
+
+public:
+
+    /*!
+      \brief create worker threads
+      \param thread_size the number of threads including the caller thread
+     */
+    explicit
+    ActionChainWorkerPool( const size_t thread_size );
+
+    /*!
+      \brief join all worker threads
+     */
+    ~ActionChainWorkerPool();
+
+    /*!
+      \brief get the number of threads including the caller thread
+     */
+    size_t threadSize() const
+      {
+          return M_threads.size() + 1;
+      }
+
+    /*!
+      \brief execute the tasks and wait for all of them.
+      \param tasks array of the task pointer
+      \param size the number of tasks
+     */
+    void run( Task * const * tasks,
+              const size_t size );
+
+private:
+
+    static
+    void * thread_main( void * arg );
+
+    void workerLoop();
+
+    void runTasks();
+};
+
+#endif
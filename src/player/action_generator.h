@@ -32,6 +32,8 @@
 #ifndef ACTION_GENERATOR_H
 #define ACTION_GENERATOR_H
 
+#include "action_state_path.h"
+
 #include <boost/shared_ptr.hpp>
 
 #include <vector>
@@ -46,6 +48,13 @@ class PredictState;
 /*!
   \class ActionGenerator
   \brief an abstract class to generate chain of action-state pair
+
+  generate() may be called by several threads at the same time in the
+  parallel best first search, except for the first action (empty path)
+  that is always generated by the main thread. Therefore, the generators
+  that refer the per-cycle singleton generators (Generator*::instance())
+  must generate only the first action, and the other generators must not
+  have any unguarded mutable static data.
 */
 class ActionGenerator {
 public:
@@ -81,7 +90,7 @@ public:
     void generate( std::vector< ActionStatePair > * result,
                    const PredictState & state,
                    const rcsc::WorldModel & wm,
-                   const std::vector< ActionStatePair > & path ) const = 0;
+                   const ActionStatePath & path ) const = 0;
 };
 
 #endif
@@ -82,7 +82,7 @@ public:
     void generate( std::vector< ActionStatePair > * result,
                    const PredictState & state,
                    const rcsc::WorldModel & wm,
-                   const std::vector< ActionStatePair > & path ) const
+                   const ActionStatePath & path ) const
       {
           for ( std::vector< ActionGenerator::ConstPtr >::const_iterator g = M_generators.begin();
                 g != M_generators.end();
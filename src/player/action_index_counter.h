@@ -0,0 +1,98 @@
+// -*-c++-*-
+
+/*!
+  \file action_index_counter.h
+  \brief per-cycle serial counter of the generated actions Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+#ifndef ACTION_INDEX_COUNTER_H
+#define ACTION_INDEX_COUNTER_H
+
+#include "mutex.h"
+
+#include <rcsc/game_time.h>
+
+/*!
+  \class ActionIndexCounter
+  \brief serial counter of the generated actions reset every cycle.
+
+  The action generators may be called by several worker threads in the
+  parallel search. This counter replaces the function-local static
+  counter in those generators.
+*/
+class ActionIndexCounter {
+private:
+
+    Mutex M_mutex;
+    rcsc::GameTime M_time; //!< last updated time
+    int M_count;
+
+    // not used
+    ActionIndexCounter( const ActionIndexCounter & );
+    ActionIndexCounter & operator=( const ActionIndexCounter & );
+
+public:
+
+    ActionIndexCounter()
+        : M_time( 0, 0 ),
+          M_count( 0 )
+      { }
+
+    /*!
+      \brief reset the counter if the game time is changed
+      \param current current game time
+     */
+    void update( const rcsc::GameTime & current )
+      {
+          ScopedLock lock( M_mutex );
+          if ( current != M_time )
+          {
+              M_count = 0;
+              M_time = current;
+          }
+      }
+
+    /*!
+      \brief increment the counter
+      \return new index value
+     */
+    int next()
+      {
+          ScopedLock lock( M_mutex );
+          return ++M_count;
+      }
+
+    /*!
+      \brief get the current counter value
+     */
+    int count()
+      {
+          ScopedLock lock( M_mutex );
+          return M_count;
+      }
+};
+
+#endif
@@ -57,6 +57,19 @@ public:
 
     static void reset_index_count();
 
+    /*!
+      \brief get the new serial index.
+      The counter is atomically incremented because the pairs can be
+      created by the worker threads of the parallel search.
+      The index is only used by the debug log. While the log is enabled,
+      the search runs on one thread, so the index is the creation order
+      as before.
+     */
+    static int next_index()
+      {
+          return __sync_add_and_fetch( &S_index_count, 1 );
+      }
+
     /*!
       \brief copy constructor
      */
@@ -86,7 +99,7 @@ public:
 
     ActionStatePair( const CooperativeAction * action,
                      const PredictState * state )
-        : M_index( ++S_index_count ),
+        : M_index( next_index() ),
           M_action( action ),
           M_state( state ),
           M_value( 0.0 ),
@@ -95,7 +108,7 @@ public:
 
     ActionStatePair( const boost::shared_ptr< const CooperativeAction > & action,
                      const PredictState * state )
-        : M_index( ++S_index_count ),
+        : M_index( next_index() ),
           M_action( action ),
           M_state( state ),
           M_value( 0.0 ),
@@ -104,7 +117,7 @@ public:
 
     ActionStatePair( const CooperativeAction * action,
                      const boost::shared_ptr< const PredictState > & state )
-        : M_index( ++S_index_count ),
+        : M_index( next_index() ),
           M_action( action ),
           M_state( state ),
           M_value( 0.0 ),
@@ -113,7 +126,7 @@ public:
 
     ActionStatePair( const boost::shared_ptr< const CooperativeAction > & action,
                      const boost::shared_ptr< const PredictState > & state )
-        : M_index( ++S_index_count ),
+        : M_index( next_index() ),
           M_action( action ),
           M_state( state ),
           M_value( 0.0 ),
@@ -0,0 +1,118 @@
+// -*-c++-*-
+
+/*!
+  \file action_state_path.h
+  \brief read-only view of the action-state pair chain Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef ACTION_STATE_PATH_H
+#define ACTION_STATE_PATH_H
+
+#include "action_state_pair.h"
+
+#include <vector>
+#include <cstddef>
+
+/*!
+  \class ActionStatePath
+  \brief lightweight read-only view of the chain of action-state pair.
+
+  The view does not own any element. It refers either a contiguous
+  container (std::vector< ActionStatePair >) or an array of pointers
+  to the pairs stored in the search tree nodes.
+  The referred storage must outlive the view.
+*/
+class ActionStatePath {
+private:
+
+    const ActionStatePair * M_pairs; //!< contiguous storage
+    const ActionStatePair * const * M_pair_ptrs; //!< pointer array storage
+    size_t M_size;
+
+public:
+
+    /*!
+      \brief create an empty path
+     */
+    ActionStatePath()
+        : M_pairs( static_cast< const ActionStatePair * >( 0 ) ),
+          M_pair_ptrs( static_cast< const ActionStatePair * const * >( 0 ) ),
+          M_size( 0 )
+      { }
+
+    /*!
+      \brief create a view of the vector container (implicit conversion)
+      \param path the chain of action-state pair
+     */
+    ActionStatePath( const std::vector< ActionStatePair > & path )
+        : M_pairs( path.empty() ? static_cast< const ActionStatePair * >( 0 ) : &path.front() ),
+          M_pair_ptrs( static_cast< const ActionStatePair * const * >( 0 ) ),
+          M_size( path.size() )
+      { }
+
+    /*!
+      \brief create a view of the pointer array
+      \param pair_ptrs the array of pointers ordered from the first action
+      \param size the length of the array
+     */
+    ActionStatePath( const ActionStatePair * const * pair_ptrs,
+                     const size_t size )
+        : M_pairs( static_cast< const ActionStatePair * >( 0 ) ),
+          M_pair_ptrs( pair_ptrs ),
+          M_size( size )
+      { }
+
+    bool empty() const
+      {
+          return M_size == 0;
+      }
+
+    size_t size() const
+      {
+          return M_size;
+      }
+
+    const ActionStatePair & operator[]( const size_t i ) const
+      {
+          return ( M_pair_ptrs
+                   ? *M_pair_ptrs[i]
+                   : M_pairs[i] );
+      }
+
+    const ActionStatePair & front() const
+      {
+          return operator[]( 0 );
+      }
+
+    const ActionStatePair & back() const
+      {
+          return operator[]( M_size - 1 );
+      }
+
+};
+
+#endif
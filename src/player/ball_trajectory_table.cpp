@@ -0,0 +1,134 @@
+// -*-c++-*-
+
+/*!
+  \file ball_trajectory_table.cpp
+  \brief precomputed ball movement table Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "ball_trajectory_table.h"
+
+#include <rcsc/common/server_param.h>
+#include <rcsc/soccer_math.h>
+#include <rcsc/math_util.h>
+
+#include <iostream>
+
+using namespace rcsc;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+BallTrajectoryTable::BallTrajectoryTable()
+    : M_ball_decay( ServerParam::DEFAULT_BALL_DECAY ),
+      M_one_minus_decay( 1.0 - ServerParam::DEFAULT_BALL_DECAY ),
+      M_valid( false )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+BallTrajectoryTable &
+BallTrajectoryTable::instance()
+{
+    static BallTrajectoryTable s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+BallTrajectoryTable::create()
+{
+    const ServerParam & SP = ServerParam::i();
+
+    M_valid = false;
+    M_ball_decay = SP.ballDecay();
+    M_one_minus_decay = 1.0 - M_ball_decay;
+
+    M_decay_pow.resize( MAX_STEP + 1 );
+    M_one_minus_decay_pow.resize( MAX_STEP + 1 );
+    M_sum_factor.resize( MAX_STEP + 1 );
+
+    for ( int step = 0; step <= MAX_STEP; ++step )
+    {
+        M_decay_pow[step] = std::pow( M_ball_decay, step );
+        M_one_minus_decay_pow[step] = 1.0 - M_decay_pow[step];
+        M_sum_factor[step] = 1.0 * M_one_minus_decay_pow[step] / M_one_minus_decay;
+    }
+
+    M_valid = true;
+
+    //
+    // verify the table by the original formulas.
+    // if any value is not identical, the table is disabled.
+    //
+
+    const Vector2D pos( 12.3, -4.5 );
+    const Vector2D vel = Vector2D::from_polar( SP.ballSpeedMax() * 0.77, 31.0 );
+
+    for ( int step = 1; step <= MAX_STEP; ++step )
+    {
+        for ( double dist = 0.5; dist < 60.0; dist += 3.7 )
+        {
+            const double speed = dist / step;
+
+            if ( firstSpeed( dist, step ) != SP.firstBallSpeed( dist, step )
+                 || travelDistance( speed, step ) != calc_sum_geom_series( speed, M_ball_decay, step ) )
+            {
+                M_valid = false;
+                break;
+            }
+        }
+
+        const Vector2D p = inertiaPoint( pos, vel, step );
+        const Vector2D q = inertia_n_step_point( pos, vel, step, M_ball_decay );
+
+        if ( ! M_valid
+             || decayPow( step ) != std::pow( M_ball_decay, step )
+             || p.x != q.x
+             || p.y != q.y )
+        {
+            std::cerr << "(BallTrajectoryTable::create) step=" << step
+                      << " the table value is not identical to the original formula."
+                      << " use the original formulas." << std::endl;
+            M_valid = false;
+            return false;
+        }
+    }
+
+    return true;
+}
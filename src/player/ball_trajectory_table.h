@@ -0,0 +1,185 @@
+// -*-c++-*-
+
+/*!
+  \file ball_trajectory_table.h
+  \brief precomputed ball movement table Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef BALL_TRAJECTORY_TABLE_H
+#define BALL_TRAJECTORY_TABLE_H
+
+#include <rcsc/geom/vector_2d.h>
+
+#include <vector>
+#include <cmath>
+
+/*!
+  \class BallTrajectoryTable
+  \brief the powers of the ball decay and the geometric series for each step.
+
+  All values are computed by the same expressions as
+  ServerParam::firstBallSpeed(), rcsc::calc_sum_geom_series() and
+  rcsc::inertia_n_step_point(), so that the results are identical to
+  them bit by bit. If the step is out of the table or the table has not
+  been created, the values are computed directly.
+*/
+class BallTrajectoryTable {
+public:
+
+    enum {
+        MAX_STEP = 100 //!< the maximum step stored in the table
+    };
+
+private:
+
+    double M_ball_decay;
+    double M_one_minus_decay; //!< 1 - decay
+
+    bool M_valid; //!< true if the table has been created and verified
+
+    std::vector< double > M_decay_pow; //!< decay^step
+    std::vector< double > M_one_minus_decay_pow; //!< 1 - decay^step
+    std::vector< double > M_sum_factor; //!< (1 - decay^step) / (1 - decay)
+
+    // private for singleton
+    BallTrajectoryTable();
+
+    // not used
+    BallTrajectoryTable( const BallTrajectoryTable & );
+    BallTrajectoryTable & operator=( const BallTrajectoryTable & );
+
+public:
+
+    static
+    BallTrajectoryTable & instance();
+
+    static
+    const BallTrajectoryTable & i()
+      {
+          return instance();
+      }
+
+    /*!
+      \brief create the table from the current ServerParam
+      \return true if the table is successfully created.
+     */
+    bool create();
+
+    bool isValid() const
+      {
+          return M_valid;
+      }
+
+    double ballDecay() const
+      {
+          return M_ball_decay;
+      }
+
+    /*!
+      \brief get the decay rate after n steps
+      \param step the number of steps
+      \return decay^step
+     */
+    double decayPow( const int step ) const
+      {
+          return ( M_valid && 0 <= step && step <= MAX_STEP
+                   ? M_decay_pow[step]
+                   : std::pow( M_ball_decay, step ) );
+      }
+
+    /*!
+      \brief get the ball speed after n steps
+      \param first_speed the first ball speed
+      \param step the number of steps
+      \return ball speed
+     */
+    double speedAfter( const double first_speed,
+                       const int step ) const
+      {
+          return first_speed * decayPow( step );
+      }
+
+    /*!
+      \brief get the travelled distance after n steps.
+      same as rcsc::calc_sum_geom_series( first_speed, decay, step )
+      \param first_speed the first ball speed
+      \param step the number of steps
+      \return travelled distance
+     */
+    double travelDistance( const double first_speed,
+                           const int step ) const
+      {
+          return ( M_valid && 0 <= step && step <= MAX_STEP
+                   ? first_speed * M_one_minus_decay_pow[step] / M_one_minus_decay
+                   : first_speed * ( 1.0 - std::pow( M_ball_decay, step ) ) / ( 1.0 - M_ball_decay ) );
+      }
+
+    /*!
+      \brief get the first ball speed to travel the distance in n steps.
+      same as ServerParam::firstBallSpeed( dist, step )
+      \param dist ball travel distance
+      \param step the number of steps
+      \return first ball speed
+     */
+    double firstSpeed( const double dist,
+                       const int step ) const
+      {
+          return ( M_valid && 0 <= step && step <= MAX_STEP
+                   ? dist * M_one_minus_decay / M_one_minus_decay_pow[step]
+                   : dist * ( 1.0 - M_ball_decay ) / ( 1.0 - std::pow( M_ball_decay, step ) ) );
+      }
+
+    /*!
+      \brief get the sum of the geometric series with the first term 1.0
+      \param step the number of steps
+      \return (1 - decay^step) / (1 - decay)
+     */
+    double sumFactor( const int step ) const
+      {
+          return ( M_valid && 0 <= step && step <= MAX_STEP
+                   ? M_sum_factor[step]
+                   : 1.0 * ( 1.0 - std::pow( M_ball_decay, step ) ) / ( 1.0 - M_ball_decay ) );
+      }
+
+    /*!
+      \brief get the ball position after n steps.
+      same as rcsc::inertia_n_step_point( pos, vel, step, decay )
+      \param pos the first ball position
+      \param vel the first ball velocity
+      \param step the number of steps
+      \return ball position
+     */
+    rcsc::Vector2D inertiaPoint( const rcsc::Vector2D & pos,
+                                 const rcsc::Vector2D & vel,
+                                 const int step ) const
+      {
+          return rcsc::Vector2D( pos + vel * sumFactor( step ) );
+      }
+
+};
+
+#endif
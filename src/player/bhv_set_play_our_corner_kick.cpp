@@ -848,7 +848,7 @@ Bhv_SetPlayOurCornerKick::get1stMovePoint( const PlayerAgent * agent )
         return Vector2D::INVALIDATED;
     }
 
-    return f->getPosition( wm.self().unum(), wm.ball().pos() );
+    return Strategy::i().getFormationPosition( f, wm.self().unum(), wm.ball().pos() );
 }
 
 /*-------------------------------------------------------------------*/
@@ -871,5 +871,5 @@ Bhv_SetPlayOurCornerKick::get2ndMovePoint( const PlayerAgent * agent )
         return Vector2D::INVALIDATED;
     }
 
-    return f->getPosition( wm.self().unum(), wm.ball().pos() );
+    return Strategy::i().getFormationPosition( f, wm.self().unum(), wm.ball().pos() );
 }
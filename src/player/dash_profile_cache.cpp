@@ -0,0 +1,163 @@
+// -*-c++-*-
+
+/*!
+  \file dash_profile_cache.cpp
+  \brief persistent self dash profile cache Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "dash_profile_cache.h"
+
+#include <rcsc/common/stamina_model.h>
+#include <rcsc/common/player_type.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace rcsc;
+
+const double DashProfileCache::DEFAULT_STAMINA_BUFFER = -1.0;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+DashProfileCache::DashProfileCache()
+    : M_entries( TABLE_SIZE ),
+      M_hit_count( 0 ),
+      M_miss_count( 0 )
+{
+    for ( std::vector< Entry >::iterator it = M_entries.begin(), end = M_entries.end();
+          it != end;
+          ++it )
+    {
+        it->player_type_ = static_cast< const PlayerType * >( 0 );
+        it->profile_.size_ = 0;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+DashProfileCache &
+DashProfileCache::instance()
+{
+    static DashProfileCache s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const DashProfileCache::Profile &
+DashProfileCache::get( const PlayerType & ptype,
+                       const StaminaModel & stamina_model,
+                       const double dash_power,
+                       const double stamina_buffer,
+                       const int n_dash )
+{
+    const int size = std::min( static_cast< int >( MAX_DASH ), n_dash );
+
+    std::size_t seed = 0;
+    boost::hash_combine( seed, &ptype );
+    boost::hash_combine( seed, stamina_model.stamina() );
+    boost::hash_combine( seed, stamina_model.effort() );
+    boost::hash_combine( seed, stamina_model.recovery() );
+    boost::hash_combine( seed, stamina_model.capacity() );
+    boost::hash_combine( seed, dash_power );
+    boost::hash_combine( seed, stamina_buffer );
+
+    Entry & entry = M_entries[seed % TABLE_SIZE];
+
+    if ( entry.player_type_ == &ptype
+         && entry.stamina_ == stamina_model.stamina()
+         && entry.effort_ == stamina_model.effort()
+         && entry.recovery_ == stamina_model.recovery()
+         && entry.capacity_ == stamina_model.capacity()
+         && entry.dash_power_ == dash_power
+         && entry.stamina_buffer_ == stamina_buffer
+         && entry.profile_.size_ >= size )
+    {
+        ++M_hit_count;
+        return entry.profile_;
+    }
+
+    ++M_miss_count;
+
+    entry.player_type_ = &ptype;
+    entry.stamina_ = stamina_model.stamina();
+    entry.effort_ = stamina_model.effort();
+    entry.recovery_ = stamina_model.recovery();
+    entry.capacity_ = stamina_model.capacity();
+    entry.dash_power_ = dash_power;
+    entry.stamina_buffer_ = stamina_buffer;
+
+    //
+    // same as the dash loops of the dribble generators
+    //
+    StaminaModel model = stamina_model;
+    for ( int i = 0; i < size; ++i )
+    {
+        const double power = ( stamina_buffer == DEFAULT_STAMINA_BUFFER
+                               ? model.getSafetyDashPower( ptype, dash_power )
+                               : model.getSafetyDashPower( ptype, dash_power, stamina_buffer ) );
+
+        entry.profile_.dash_power_[i] = power;
+        entry.profile_.effort_[i] = model.effort();
+
+        model.simulateDash( ptype, power );
+    }
+    entry.profile_.size_ = size;
+
+    return entry.profile_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+DashProfileCache::print( std::ostream & os ) const
+{
+    const long total = M_hit_count + M_miss_count;
+
+    os << "DashProfileCache: lookup=" << total
+       << " hit=" << M_hit_count
+       << " hit_rate=" << ( total > 0
+                            ? 100.0 * M_hit_count / total
+                            : 0.0 )
+       << "%\n";
+
+    return os;
+}
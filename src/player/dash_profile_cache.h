@@ -0,0 +1,160 @@
+// -*-c++-*-
+
+/*!
+  \file dash_profile_cache.h
+  \brief persistent self dash profile cache Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+
+#ifndef DASH_PROFILE_CACHE_H
+#define DASH_PROFILE_CACHE_H
+
+#include <iosfwd>
+#include <vector>
+
+namespace rcsc {
+class PlayerType;
+class StaminaModel;
+}
+
+/*!
+  \class DashProfileCache
+  \brief the dash power and the effort of the consecutive full power dashes.
+
+  The dribble generators simulate the consecutive dashes from the
+  stamina state of the current cycle. The sequence of the dash power
+  and the effort depends only on the player type, the stamina model and
+  the requested dash power, but not on the dash direction nor the
+  velocity. The cache holds the sequence for each combination of them,
+  and the generators compute the dash acceleration from the cached
+  values by the same expressions as the original simulation.
+
+  The key is compared without any quantization, so the cached sequence
+  is always same as the simulation result. The table is direct mapped
+  and kept over the cycles. Since the stamina state changes only by the
+  dash and the recovery, the entries are reused while the player is
+  resting or the stamina is full.
+
+  This class is not thread safe. It is used only by the generators for
+  the first action of the action chain.
+*/
+class DashProfileCache {
+public:
+
+    enum {
+        MAX_DASH = 16, //!< the maximum number of dashes
+        TABLE_SIZE = 256 //!< the number of the table entries
+    };
+
+    //! stamina_buffer value to use the default argument of StaminaModel::getSafetyDashPower()
+    static const double DEFAULT_STAMINA_BUFFER;
+
+    /*!
+      \brief simulated dash sequence
+     */
+    struct Profile {
+        int size_; //!< the number of dashes
+        double dash_power_[MAX_DASH]; //!< safety dash power of each dash
+        double effort_[MAX_DASH]; //!< effort before each dash
+    };
+
+private:
+
+    /*!
+      \brief table entry
+     */
+    struct Entry {
+        const rcsc::PlayerType * player_type_; //!< null if empty
+        double stamina_;
+        double effort_;
+        double recovery_;
+        double capacity_;
+        double dash_power_;
+        double stamina_buffer_;
+        Profile profile_;
+    };
+
+    std::vector< Entry > M_entries;
+
+    long M_hit_count;
+    long M_miss_count;
+
+    // private for singleton
+    DashProfileCache();
+
+    // not used
+    DashProfileCache( const DashProfileCache & );
+    DashProfileCache & operator=( const DashProfileCache & );
+
+public:
+
+    static
+    DashProfileCache & instance();
+
+    static
+    const DashProfileCache & i()
+      {
+          return instance();
+      }
+
+    /*!
+      \brief get the dash sequence. the sequence is simulated if not cached.
+      \param ptype player type
+      \param stamina_model the stamina model before the first dash
+      \param dash_power requested dash power
+      \param stamina_buffer stamina buffer for the safety dash power.
+      DEFAULT_STAMINA_BUFFER means the default argument.
+      \param n_dash the number of dashes. the caller must not request more than MAX_DASH.
+      \return the dash sequence that contains min(n_dash, MAX_DASH) dashes at least.
+      the caller must simulate the dashes by itself if n_dash > MAX_DASH.
+     */
+    const Profile & get( const rcsc::PlayerType & ptype,
+                         const rcsc::StaminaModel & stamina_model,
+                         const double dash_power,
+                         const double stamina_buffer,
+                         const int n_dash );
+
+    long hitCount() const
+      {
+          return M_hit_count;
+      }
+
+    long missCount() const
+      {
+          return M_miss_count;
+      }
+
+    /*!
+      \brief print the hit rate
+      \param os reference to the output stream
+      \return reference to the output stream
+     */
+    std::ostream & print( std::ostream & os ) const;
+
+};
+
+#endif
@@ -36,6 +36,7 @@
 #include "field_analyzer.h"
 #include "predict_state.h"
 #include "pass_checker.h"
+#include "reach_cycle_table.h"
 #include "strategy.h"
 
 #include <rcsc/action/kick_table.h>
@@ -55,6 +56,8 @@
 
 #include <algorithm>
 
+#define USE_REACH_CYCLE_TABLE
+
 // #define DEBUG_PROFILE
 
 // #ifdef DEBUG_PRINT
@@ -306,6 +309,16 @@ FieldAnalyzer::init( const std::string & ball_table_file )
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+FieldAnalyzer::attach( const SharedDataStore & store )
+{
+    return M_ball_move_model.attach( store );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -363,6 +376,23 @@ FieldAnalyzer::predict_player_turn_cycle( const PlayerType * ptype,
                                 AngleDeg::asin_deg( dist_thr / target_dist ) );
     }
 
+#ifdef USE_REACH_CYCLE_TABLE
+    n_turn = ReachCycleTable::i().turnCycle( ptype, angle_diff, turn_margin, player_speed );
+#ifdef DEBUG_PREDICT_PLAYER_TURN_CYCLE
+    const bool table_hit = ( n_turn >= 0 );
+#endif
+    if ( n_turn < 0 )
+    {
+        n_turn = ReachCycleTable::simulate_turn_cycle( ptype, angle_diff, turn_margin, player_speed );
+    }
+
+#ifdef DEBUG_PREDICT_PLAYER_TURN_CYCLE
+    dlog.addText( Logger::ANALYZER,
+                  "(predict_player_turn_cycle) lookup angleDiff=%.3f turnMargin=%.3f speed=%.2f n_turn=%d (%s)",
+                  angle_diff, turn_margin, player_speed, n_turn,
+                  ( table_hit ? "table" : "simulate" ) );
+#endif
+#else
     double speed = player_speed;
     while ( angle_diff > turn_margin )
     {
@@ -375,6 +405,7 @@ FieldAnalyzer::predict_player_turn_cycle( const PlayerType * ptype,
     dlog.addText( Logger::ANALYZER,
                   "(predict_player_turn_cycle) angleDiff=%.3f turnMargin=%.3f speed=%.2f n_turn=%d",
                   angle_diff, turn_margin, player_speed, n_turn );
+#endif
 #endif
 
     return n_turn;
@@ -666,7 +697,7 @@ FieldAnalyzer::get_pass_count( const PredictState & state,
     const AbstractPlayerObject & from = state.ballHolder();
 
     int pass_count = 0;
-    for ( PredictPlayerObject::Cont::const_iterator it = state.ourPlayers().begin(), end = state.ourPlayers().end();
+    for ( PredictState::PlayerCont::const_iterator it = state.ourPlayers().begin(), end = state.ourPlayers().end();
           it != end;
           ++it )
     {
@@ -722,7 +753,7 @@ FieldAnalyzer::get_congestion( const PredictState & state,
 
     double congestion = 0.0;
 
-    for ( PredictPlayerObject::Cont::const_iterator it = state.theirPlayers().begin(),
+    for ( PredictState::PlayerCont::const_iterator it = state.theirPlayers().begin(),
               end = state.theirPlayers().end();
           it != end;
           ++it )
@@ -744,6 +775,53 @@ FieldAnalyzer::get_congestion( const PredictState & state,
     return congestion;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+FieldAnalyzer::get_congestion_batch( const PredictState & state,
+                                     const double * xs,
+                                     const double * ys,
+                                     const size_t size,
+                                     double * result,
+                                     const int opponent_additional_chase_time )
+{
+    static const double factor = 1.0 / ( 2.0 * std::pow( 2.5, 2 ) );
+
+    for ( size_t i = 0; i < size; ++i )
+    {
+        result[i] = 0.0;
+    }
+
+    //
+    // the opponents are the outer loop, and the points are the inner loop.
+    // the inner loop has no branch, so that it can be vectorized by the compiler.
+    // the summation order for each point is same as get_congestion().
+    //
+    for ( PredictState::PlayerCont::const_iterator it = state.theirPlayers().begin(),
+              end = state.theirPlayers().end();
+          it != end;
+          ++it )
+    {
+        if ( (*it)->goalie() ) continue;
+        if ( (*it)->ghostCount() >= 3 ) continue;
+
+        const double opp_x = (*it)->pos().x;
+        const double opp_y = (*it)->pos().y;
+        const double reach = (*it)->playerTypePtr()->realSpeedMax()
+            * ( bound( 0, (*it)->posCount() - 2, 2 ) + opponent_additional_chase_time );
+
+        for ( size_t i = 0; i < size; ++i )
+        {
+            const double dx = xs[i] - opp_x;
+            const double dy = ys[i] - opp_y;
+            const double d = std::sqrt( dx * dx + dy * dy ) - reach;
+            result[i] += std::exp( - ( d * d ) * factor );
+        }
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -1064,6 +1142,8 @@ FieldAnalyzer::update( const WorldModel & wm )
     }
     s_update_time = wm.time();
 
+    M_opponent_grid.update( wm );
+
     if ( wm.gameMode().type() == GameMode::BeforeKickOff
          || wm.gameMode().type() == GameMode::AfterGoal_
          || wm.gameMode().isPenaltyKickMode() )
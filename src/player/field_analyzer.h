@@ -36,6 +36,7 @@
 #include "predict_state.h"
 
 #include "ball_move_model.h"
+#include "opponent_grid.h"
 
 #include <rcsc/formation/formation.h>
 #include <rcsc/player/player_object.h>
@@ -53,6 +54,7 @@ class WorldModel;
 }
 
 class PassChecker;
+class SharedDataStore;
 
 class FieldAnalyzer {
 public:
@@ -72,6 +74,8 @@ private:
 
     BallMoveModel M_ball_move_model;
 
+    OpponentGrid M_opponent_grid;
+
     const rcsc::AbstractPlayerObject * M_our_shoot_blocker;
 
     double M_shoot_point_values[SHOOT_AREA_X_DIVS][SHOOT_AREA_Y_DIVS];
@@ -98,12 +102,24 @@ public:
 
     bool init( const std::string & ball_table_file );
 
+    /*!
+      \brief use the ball model table in the shared memory instead of the file
+      \param store attached data store
+      \return true if the table is found in the store.
+     */
+    bool attach( const SharedDataStore & store );
+
 
     const BallMoveModel & ballMoveModel() const
       {
           return M_ball_move_model;
       }
 
+    const OpponentGrid & opponentGrid() const
+      {
+          return M_opponent_grid;
+      }
+
     const rcsc::VoronoiDiagram & targetVoronoiDiagram() const
       {
           return M_target_voronoi_diagram;
@@ -236,6 +252,24 @@ public:
                            const rcsc::Vector2D & point,
                            const int opponent_additional_chase_time = 0 );
 
+    /*!
+      \brief compute the congestion values at the multiple points at once.
+      The result of each point is same as get_congestion().
+      \param state state that has the opponent players
+      \param xs x coordinates of the points
+      \param ys y coordinates of the points
+      \param size the number of points
+      \param result array to store the congestion values
+      \param opponent_additional_chase_time additional cycles for opponents
+     */
+    static
+    void get_congestion_batch( const PredictState & state,
+                               const double * xs,
+                               const double * ys,
+                               const size_t size,
+                               double * result,
+                               const int opponent_additional_chase_time = 0 );
+
     static
     const rcsc::AbstractPlayerObject * get_blocker( const rcsc::WorldModel & wm,
                                                     const rcsc::Vector2D & opponent_pos );
@@ -44,6 +44,7 @@
 #include <map>
 #include <vector>
 #include <utility>
+#include <algorithm>
 
 // #define FIELD_EVALUATOR_DEBUG_LOG
 
@@ -52,6 +53,63 @@ using namespace rcsc;
 static const double GRID_SIZE = 5.0;
 static const double RECT_SIZE_RATE = 0.2;
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+FieldEvaluator::evaluateBatch( const PredictState & first_state,
+                               const ActionStatePath & parent_path,
+                               const std::vector< ActionStatePair > & children,
+                               double * values )
+{
+    std::vector< const ActionStatePair * > path( parent_path.size() + 1 );
+    for ( size_t i = 0; i < parent_path.size(); ++i )
+    {
+        path[i] = &parent_path[i];
+    }
+
+    const size_t size = children.size();
+    for ( size_t i = 0; i < size; ++i )
+    {
+        path.back() = &children[i];
+        values[i] = evaluate( first_state, ActionStatePath( &path[0], path.size() ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+FieldEvaluator::share_opponents( const std::vector< ActionStatePair > & children )
+{
+    if ( children.empty() )
+    {
+        return true;
+    }
+
+    const PredictState::PlayerCont opponents = children.front().state().theirPlayers();
+
+    for ( std::vector< ActionStatePair >::const_iterator it = children.begin() + 1, end = children.end();
+          it != end;
+          ++it )
+    {
+        const PredictState::PlayerCont other = it->state().theirPlayers();
+        if ( other.size() != opponents.size()
+             || ! std::equal( opponents.begin(), opponents.end(), other.begin() ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
 void
 FieldEvaluator::writeDebugLog( const WorldModel & wm ) const
 {
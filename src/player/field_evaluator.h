@@ -27,6 +27,8 @@
 
 /////////////////////////////////////////////////////////////////////
 
+#include "action_state_path.h"
+
 #include <boost/shared_ptr.hpp>
 
 #include <vector>
@@ -76,7 +78,22 @@ public:
      */
     virtual
     double evaluate( const PredictState & first_state,
-                     const std::vector< ActionStatePair > & path ) = 0;
+                     const ActionStatePath & path ) = 0;
+
+    /*!
+      \brief evaluate all children of one expanded node at once.
+      The default implementation calls evaluate() for each child.
+      This method can be called by the worker threads of the searcher.
+      \param first_state root state of the search tree
+      \param parent_path chain from the root to the expanded node. empty if the root is expanded.
+      \param children action-state pairs generated from the expanded node
+      \param values array to store the results. its size must be children.size().
+     */
+    virtual
+    void evaluateBatch( const PredictState & first_state,
+                        const ActionStatePath & parent_path,
+                        const std::vector< ActionStatePair > & children,
+                        double * values );
 
     virtual
     double getFirstActionPenalty( const PredictState & /* first_state */,
@@ -91,6 +108,17 @@ public:
       \param wm world model instance
      */
     void writeDebugLog( const rcsc::WorldModel & wm ) const;
+
+protected:
+
+    /*!
+      \brief check if all children have the same opponent instances.
+      If true, the opponent dependent terms can be shared in the batch evaluation.
+      \param children action-state pairs generated from the same node
+      \return checked result
+     */
+    static
+    bool share_opponents( const std::vector< ActionStatePair > & children );
 };
 
 
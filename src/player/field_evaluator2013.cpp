@@ -135,7 +135,7 @@ get_opponent_dist( const PredictState & state,
 
     double min_dist = MAX_DIST;
 
-    for ( PredictPlayerObject::Cont::const_iterator it = state.theirPlayers().begin(),
+    for ( PredictState::PlayerCont::const_iterator it = state.theirPlayers().begin(),
               end = state.theirPlayers().end();
           it != end;
           ++it )
@@ -189,7 +189,7 @@ FieldEvaluator2013::~FieldEvaluator2013()
  */
 double
 FieldEvaluator2013::evaluate( const PredictState & first_state,
-                              const std::vector< ActionStatePair > & path )
+                              const ActionStatePath & path )
 {
     if ( path.empty() )
     {
@@ -412,7 +412,7 @@ FieldEvaluator2013::getFirstActionPenaltyImpl( const PredictState & first_state,
  */
 double
 FieldEvaluator2013::evaluateImpl( const PredictState & first_state,
-                                  const std::vector< ActionStatePair > & path ) const
+                                  const ActionStatePath & path ) const
 {
     //
     // state evaluation
@@ -511,7 +511,7 @@ FieldEvaluator2013::evaluateImpl( const PredictState & first_state,
 
  */
 double
-FieldEvaluator2013::getStateValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2013::getStateValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
     const ServerParam & SP = ServerParam::i();
@@ -693,7 +693,7 @@ FieldEvaluator2013::getStateValue( const std::vector< ActionStatePair > & path )
 
  */
 double
-FieldEvaluator2013::getBallPositionValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2013::getBallPositionValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
     double value = 0.0;
@@ -758,7 +758,7 @@ FieldEvaluator2013::getBallPositionValue( const std::vector< ActionStatePair > &
 
  */
 double
-FieldEvaluator2013::getShootChanceValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2013::getShootChanceValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
@@ -779,14 +779,14 @@ FieldEvaluator2013::getShootChanceValue( const std::vector< ActionStatePair > &
 
  */
 double
-FieldEvaluator2013::getFrontSpaceValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2013::getFrontSpaceValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
     const Vector2D pos = state.ballHolder().pos();
 
     double free_angle = 90.0;
-    for ( PredictPlayerObject::Cont::const_iterator o = state.theirPlayers().begin(), end = state.theirPlayers().end();
+    for ( PredictState::PlayerCont::const_iterator o = state.theirPlayers().begin(), end = state.theirPlayers().end();
           o != end;
           ++o )
     {
@@ -816,7 +816,7 @@ FieldEvaluator2013::getFrontSpaceValue( const std::vector< ActionStatePair > & p
 
  */
 double
-FieldEvaluator2013::getOverDefenseLineValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2013::getOverDefenseLineValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
@@ -849,7 +849,7 @@ FieldEvaluator2013::getOverDefenseLineValue( const std::vector< ActionStatePair
 
  */
 double
-FieldEvaluator2013::getOpponentGoalDistanceValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2013::getOpponentGoalDistanceValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
@@ -869,7 +869,7 @@ FieldEvaluator2013::getOpponentGoalDistanceValue( const std::vector< ActionState
 
  */
 double
-FieldEvaluator2013::getOurGoalDistanceValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2013::getOurGoalDistanceValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
@@ -890,7 +890,7 @@ FieldEvaluator2013::getOurGoalDistanceValue( const std::vector< ActionStatePair
  */
 double
 FieldEvaluator2013::getLengthPenalty( const PredictState & first_state,
-                                      const std::vector< ActionStatePair > & path ) const
+                                      const ActionStatePath & path ) const
 {
     (void)first_state;
 
@@ -935,7 +935,7 @@ FieldEvaluator2013::getLengthPenalty( const PredictState & first_state,
 
  */
 double
-FieldEvaluator2013::getOpponentDistancePenalty( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2013::getOpponentDistancePenalty( const ActionStatePath & path ) const
 {
     //const double PATH_OPPENENT_DIST_PENALTY = -1.0e+4;
     const double PATH_OPPENENT_DIST_PENALTY = -1.0;
@@ -1005,7 +1005,7 @@ FieldEvaluator2013::getOpponentDistancePenalty( const std::vector< ActionStatePa
  */
 double
 FieldEvaluator2013::getActionTypePenalty( const PredictState & first_state,
-                                          const std::vector< ActionStatePair > & path ) const
+                                          const ActionStatePath & path ) const
 {
     double penalty = 0.0;
 
@@ -1100,7 +1100,7 @@ FieldEvaluator2013::getActionTypePenalty( const PredictState & first_state,
 
  */
 double
-FieldEvaluator2013::getBallPositionForOurGoalieValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2013::getBallPositionForOurGoalieValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
@@ -1140,7 +1140,7 @@ FieldEvaluator2013::getBallPositionForOurGoalieValue( const std::vector< ActionS
 
  */
 double
-FieldEvaluator2013::getOverAttackLineValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2013::getOverAttackLineValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
@@ -1159,7 +1159,7 @@ FieldEvaluator2013::getOverAttackLineValue( const std::vector< ActionStatePair >
 
  */
 double
-FieldEvaluator2013::getCongestionValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2013::getCongestionValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
@@ -1183,7 +1183,7 @@ FieldEvaluator2013::getCongestionValue( const std::vector< ActionStatePair > & p
 
  */
 double
-FieldEvaluator2013::getPassCountValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2013::getPassCountValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
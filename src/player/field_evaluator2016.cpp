@@ -63,6 +63,8 @@
 
 // #define DEBUG_PRINT_PARAM
 
+// #define DEBUG_CHECK_BATCH
+
 using namespace rcsc;
 
 namespace {
@@ -135,7 +137,7 @@ get_opponent_dist( const PredictState & state,
 
     double min_dist = MAX_DIST;
 
-    for ( PredictPlayerObject::Cont::const_iterator it = state.theirPlayers().begin(),
+    for ( PredictState::PlayerCont::const_iterator it = state.theirPlayers().begin(),
               end = state.theirPlayers().end();
           it != end;
           ++it )
@@ -165,6 +167,209 @@ get_opponent_dist( const PredictState & state,
     return min_dist;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the value of the terminal state (goal, conceded, out of pitch
+  or opponent ball).
+  \return true if the state is terminal and value is set.
+ */
+inline
+bool
+get_terminal_state_value( const ServerParam & SP,
+                          const Vector2D & ball_pos,
+                          const bool our_ball,
+                          double * value )
+{
+    const double abs_y = std::fabs( ball_pos.y );
+
+    // ball is in opponent goal
+    if ( ball_pos.x > + ( SP.pitchHalfLength() - 0.1 )
+         && abs_y < SP.goalHalfWidth() + 2.0 )
+    {
+        *value = GOAL_VALUE;
+        return true;
+    }
+
+    // ball is in our goal
+    if ( ball_pos.x < - ( SP.pitchHalfLength() - 0.1 )
+         && abs_y < SP.goalHalfWidth() )
+    {
+        *value = CONCEDED_VALUE;
+        return true;
+    }
+
+    // out of pitch, or opponent has ball
+    if ( std::fabs( ball_pos.x ) > SP.pitchHalfLength()
+         || abs_y > SP.pitchHalfWidth()
+         || ! our_ball )
+    {
+        *value = -50.0 + ball_pos.x;
+        return true;
+    }
+
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+inline
+double
+get_ball_position_value( const ServerParam & SP,
+                         const Vector2D & ball_pos )
+{
+    if ( ball_pos.x > 25.0 )
+    {
+        double value = SP.pitchHalfLength() + SP.pitchLength();
+
+        // penalty for the distance from corners
+        double d2
+            = std::pow( ball_pos.x - SP.pitchHalfLength(), 2 )
+            + std::pow( std::fabs( ball_pos.y ) - SP.pitchHalfWidth(), 2 );
+        if ( d2 < std::pow( 15.0, 2 ) )
+        {
+            value -= std::exp( -d2 / ( 2.0 * std::pow( 10.0, 2 ) ) ) * 5.0;
+        }
+        return value;
+    }
+
+    if ( ball_pos.x > 20.0 )
+    {
+        double rate = ( 25.0 - ball_pos.x ) / 5.0;
+        return ( ball_pos.x + SP.pitchLength() ) * rate
+            + ( SP.pitchHalfLength() + SP.pitchLength() ) * ( 1.0 - rate );
+    }
+
+    return ball_pos.x + SP.pitchLength();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+inline
+double
+get_opponent_goal_distance_value( const ServerParam & SP,
+                                  const Vector2D & ball_pos )
+{
+    const double their_goal_dist = SP.theirTeamGoalPos().dist( ball_pos );
+    return ( their_goal_dist <= 30.0
+             ? ( 30.0 - their_goal_dist ) * THEIR_GOAL_DIST_RATE
+             : 0.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+inline
+double
+get_our_goal_distance_value( const ServerParam & SP,
+                             const Vector2D & ball_pos )
+{
+    const double our_goal_dist = SP.ourTeamGoalPos().dist( ball_pos );
+    return ( our_goal_dist <= 30.0
+             ? ( 30.0 - our_goal_dist ) * -3.28763719460485
+             : 0.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+inline
+double
+get_path_length_penalty( const size_t path_size )
+{
+    double penalty = 0.0;
+
+    if ( path_size >= 2 ) penalty -= 3.0;
+    if ( path_size >= 3 ) penalty -= 4.0;
+    if ( path_size >= 4 ) penalty -= 5.0;
+    if ( path_size >= 5 ) penalty -= 6.0;
+
+    return penalty;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+inline
+double
+get_spent_time_penalty( const unsigned long spent_time )
+{
+    return -0.15 * spent_time;
+    //return -0.3 * spent_time;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the penalty for the sharp turn after the dribble.
+ */
+inline
+double
+get_move_angle_penalty( const AngleDeg & prev_move_angle,
+                        const AngleDeg & next_move_angle )
+{
+    double angle_diff = ( prev_move_angle - next_move_angle ).abs();
+    return ( angle_diff > 120.0
+             ? -( angle_diff - 120.0 )
+             : 0.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+inline
+double
+get_shoot_spot_penalty( const Vector2D & shoot_pos )
+{
+    //return - shoot_pos.dist( best_shoot_spot );
+    return -0.5 * shoot_pos.dist( Vector2D( 52.5, 0 ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+inline
+double
+get_shoot_opponent_penalty( const double opponent_dist )
+{
+    return -1.0 * std::exp( -std::pow( opponent_dist, 2 ) / ( 2.0 * std::pow( 1.0, 2 ) ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the penalty for the opponent distance after the first dribble.
+ */
+static
+double
+get_first_dribble_value( const PredictState & first_state,
+                         const ActionStatePair & first_pair,
+                         const bool gliders )
+{
+    const PredictState & next_state = first_pair.state();
+
+    if ( first_pair.action().type() == CooperativeAction::Dribble
+         && ( next_state.ball().pos().x < 0.0
+              || gliders ) )
+    {
+        double opponent_dist = get_opponent_dist( first_state,
+                                                  next_state.ball().pos(),
+                                                  0 );
+        if ( opponent_dist < 5.0 )
+        {
+            return -5.0 * std::exp( -std::pow( opponent_dist, 2 ) / ( 2.0 * std::pow( 2.0, 2 ) ) );
+        }
+    }
+
+    return 0.0;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -189,7 +394,7 @@ FieldEvaluator2016::~FieldEvaluator2016()
  */
 double
 FieldEvaluator2016::evaluate( const PredictState & first_state,
-                              const std::vector< ActionStatePair > & path )
+                              const ActionStatePath & path )
 {
     if ( path.empty() )
     {
@@ -203,6 +408,196 @@ FieldEvaluator2016::evaluate( const PredictState & first_state,
     return value;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief evaluate all children of one node.
+  The result is same as evaluate(), but the terms depending only on
+  the parent path are computed once. Each term uses the same helper
+  function as evaluateImpl().
+  The children are evaluated in a scalar loop. The child terms branch on
+  the ball position and call ShootSimulator, so a structure-of-arrays
+  copy of the ball positions would only duplicate the formulas of the
+  helpers without making the loop vectorizable.
+ */
+void
+FieldEvaluator2016::evaluateBatch( const PredictState & first_state,
+                                   const ActionStatePath & parent_path,
+                                   const std::vector< ActionStatePair > & children,
+                                   double * values )
+{
+    const size_t size = children.size();
+    if ( size == 0 )
+    {
+        return;
+    }
+
+    if ( dlog.isEnabled( Logger::PLAN )
+         || ! share_opponents( children ) )
+    {
+        // the debug log of each term is written by evaluate()
+        FieldEvaluator::evaluateBatch( first_state, parent_path, children, values );
+        return;
+    }
+
+    const ServerParam & SP = ServerParam::i();
+    const size_t depth = parent_path.size() + 1;
+
+    //
+    // per-parent terms
+    //
+
+    const double path_length_penalty = get_path_length_penalty( depth );
+
+    // move angle penalty inside of the parent path
+    double parent_move_angle_value = 0.0;
+    AngleDeg parent_move_angle( 0.0 );
+    Vector2D parent_ball_pos = first_state.ball().pos();
+    bool parent_is_dribble = false;
+    if ( depth >= 2 )
+    {
+        Vector2D prev_move = ( parent_path.front().state().ball().pos() - first_state.ball().pos() );
+        AngleDeg prev_move_angle = prev_move.th();
+        for ( size_t i = 1; i < parent_path.size(); ++i )
+        {
+            Vector2D next_move = ( parent_path[i].state().ball().pos() - parent_path[i-1].state().ball().pos() );
+            AngleDeg next_move_angle = next_move.th();
+            if ( parent_path[i-1].action().type() == CooperativeAction::Dribble )
+            {
+                parent_move_angle_value += get_move_angle_penalty( prev_move_angle, next_move_angle );
+            }
+            prev_move_angle = next_move_angle;
+        }
+        parent_move_angle = prev_move_angle;
+        parent_ball_pos = parent_path.back().state().ball().pos();
+        parent_is_dribble = ( parent_path.back().action().type() == CooperativeAction::Dribble );
+    }
+
+    // shoot terms
+    const PredictState & shoot_state = ( depth == 1
+                                         ? first_state
+                                         : parent_path.back().state() );
+    const double shoot_spot_value = get_shoot_spot_penalty( shoot_state.ball().pos() );
+    double shoot_opponent_value = 0.0;
+    if ( depth >= 2 )
+    {
+        shoot_opponent_value = get_shoot_opponent_penalty( get_opponent_dist( first_state,
+                                                                              parent_path.front().state().ball().pos(),
+                                                                              0 ) );
+    }
+
+    // dribble penalty for the first action
+    const bool gliders = ( Strategy::i().opponentType() == Strategy::Type_Gliders );
+    double front_dribble_value = 0.0;
+    if ( depth >= 2 )
+    {
+        front_dribble_value = get_first_dribble_value( first_state, parent_path.front(), gliders );
+    }
+
+    // the opponents for the shoot chance. all children have the same opponents.
+    const PredictState & front_state = children.front().state();
+    const AbstractPlayerObject::Cont shoot_opponents
+        = front_state.getPlayers( new OpponentOrUnknownPlayerPredicate( front_state.self().side() ) );
+
+    //
+    // combine the terms in the same order as evaluateImpl()
+    //
+
+    for ( size_t i = 0; i < size; ++i )
+    {
+        const ActionStatePair & pair = children[i];
+        const PredictState & state = pair.state();
+        const Vector2D & ball_pos = state.ball().pos();
+
+        //
+        // state value. same as getStateValue()
+        //
+        double result_value = 0.0;
+        if ( ! get_terminal_state_value( SP, ball_pos,
+                                         state.ballHolder().side() == state.self().side(),
+                                         &result_value ) )
+        {
+            result_value += get_ball_position_value( SP, ball_pos );
+            if ( ShootSimulator::can_shoot_from( state.ballHolder().unum() == state.self().unum(),
+                                                 ball_pos,
+                                                 shoot_opponents,
+                                                 VALID_PLAYER_THRESHOLD ) )
+            {
+                result_value += SHOOT_VALUE;
+            }
+            result_value += get_opponent_goal_distance_value( SP, ball_pos );
+            result_value += get_our_goal_distance_value( SP, ball_pos );
+        }
+
+        //
+        // length penalty. same as getLengthPenalty()
+        //
+        result_value += path_length_penalty + get_spent_time_penalty( state.spentTime() );
+
+        //
+        // action type penalty. same as getActionTypePenalty()
+        //
+        {
+            double penalty = 0.0;
+
+            if ( depth >= 2 )
+            {
+                double value = parent_move_angle_value;
+                if ( parent_is_dribble )
+                {
+                    value += get_move_angle_penalty( parent_move_angle,
+                                                     ( ball_pos - parent_ball_pos ).th() );
+                }
+                penalty += value;
+            }
+
+            if ( pair.action().type() == CooperativeAction::Shoot )
+            {
+                penalty += shoot_spot_value;
+                if ( depth >= 2 )
+                {
+                    penalty += shoot_opponent_value;
+                }
+            }
+            else
+            {
+                penalty += ( depth == 1
+                             ? get_first_dribble_value( first_state, pair, gliders )
+                             : front_dribble_value );
+            }
+
+            result_value += penalty;
+        }
+
+        //
+        // first action penalty
+        //
+        result_value += ( depth == 1
+                          ? pair.penalty()
+                          : parent_path.front().penalty() );
+
+        values[i] = result_value;
+    }
+
+#ifdef DEBUG_CHECK_BATCH
+    {
+        std::vector< double > expected( size );
+        FieldEvaluator::evaluateBatch( first_state, parent_path, children, &expected[0] );
+        for ( size_t i = 0; i < size; ++i )
+        {
+            if ( std::fabs( values[i] - expected[i] ) > 1.0e-6 )
+            {
+                std::cerr << __FILE__ << ":" << __LINE__
+                          << " (evaluateBatch) mismatch. depth=" << depth
+                          << " index=" << i
+                          << " batch=" << values[i]
+                          << " evaluate=" << expected[i]
+                          << std::endl;
+            }
+        }
+    }
+#endif
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -452,7 +847,7 @@ FieldEvaluator2016::getFirstActionPenaltyImpl( const PredictState & first_state,
  */
 double
 FieldEvaluator2016::evaluateImpl( const PredictState & first_state,
-                                  const std::vector< ActionStatePair > & path ) const
+                                  const ActionStatePath & path ) const
 {
     //
     // state evaluation
@@ -553,63 +948,26 @@ FieldEvaluator2016::evaluateImpl( const PredictState & first_state,
  * \return
  */
 double
-FieldEvaluator2016::getStateValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2016::getStateValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
     const ServerParam & SP = ServerParam::i();
 
     //
-    // ball is in opponent goal
-    //
-    if ( state.ball().pos().x > + ( SP.pitchHalfLength() - 0.1 )
-         && state.ball().pos().absY() < SP.goalHalfWidth() + 2.0 )
-    {
-#ifdef DEBUG_PRINT
-        dlog.addText( Logger::PLAN,
-                      "(eval) ball is in opponent goal %f", GOAL_VALUE );
-#endif
-        return GOAL_VALUE;
-    }
-
-    //
-    // ball is in our goal
-    //
-    if ( state.ball().pos().x < - ( SP.pitchHalfLength() - 0.1 )
-         && state.ball().pos().absY() < SP.goalHalfWidth() )
-    {
-#ifdef DEBUG_PRINT
-        dlog.addText( Logger::PLAN,
-                      "(eval) ball is in our goal" );
-#endif
-
-        return CONCEDED_VALUE;
-    }
-
-
-    //
-    // out of pitch
-    //
-    if ( state.ball().pos().absX() > SP.pitchHalfLength()
-         || state.ball().pos().absY() > SP.pitchHalfWidth() )
-    {
-#ifdef DEBUG_PRINT
-        dlog.addText( Logger::PLAN,
-                      "(eval) out of pitch" );
-#endif
-        return -50.0 + state.ball().pos().x;
-    }
-
-
-    //
-    // opponent has ball
+    // ball is in goal, out of pitch or opponent has ball
     //
-    if ( state.ballHolder().side() != state.self().side() )
     {
+        double terminal_value = 0.0;
+        if ( get_terminal_state_value( SP, state.ball().pos(),
+                                       state.ballHolder().side() == state.self().side(),
+                                       &terminal_value ) )
+        {
 #ifdef DEBUG_PRINT
-        dlog.addText( Logger::PLAN,
-                      "(eval) opponent has ball" );
+            dlog.addText( Logger::PLAN,
+                          "(eval) terminal state %f", terminal_value );
 #endif
-        return -50.0 + state.ball().pos().x;
+            return terminal_value;
+        }
     }
 
     double result_value = 0.0;
@@ -735,7 +1093,7 @@ FieldEvaluator2016::getStateValue( const std::vector< ActionStatePair > & path )
 
  */
 double
-FieldEvaluator2016::getBallPositionValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2016::getBallPositionValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
     double value = 0.0;
@@ -760,35 +1118,7 @@ FieldEvaluator2016::getBallPositionValue( const std::vector< ActionStatePair > &
         value = state.ball().pos().x + ServerParam::i().pitchLength();
     }
 #elif 1
-    if ( state.ball().pos().x > 25.0 )
-    {
-        value = ServerParam::i().pitchHalfLength() + ServerParam::i().pitchLength();
-
-        // penalty for the distance from corners
-        double d2
-            = std::pow( state.ball().pos().x - ServerParam::i().pitchHalfLength(), 2 )
-            + std::pow( state.ball().pos().absY() - ServerParam::i().pitchHalfWidth(), 2 );
-        if ( d2 < std::pow( 15.0, 2 ) )
-        {
-            //double dec = std::exp( -d2 / ( 2.0 * std::pow( 10.0, 2 ) ) ) * 30.0;
-            double dec = std::exp( -d2 / ( 2.0 * std::pow( 10.0, 2 ) ) ) * 5.0;
-            value -= dec;
-#ifdef DEBUG_PRINT
-            dlog.addText( Logger::PLAN,
-                          "(eval) corner penalty %f (%f)", -dec, value );
-#endif
-        }
-    }
-    else if ( state.ball().pos().x > 20.0 )
-    {
-        double rate = ( 25.0 - state.ball().pos().x ) / 5.0;
-        value = ( state.ball().pos().x + ServerParam::i().pitchLength() ) * rate
-            + ( ServerParam::i().pitchHalfLength() + ServerParam::i().pitchLength() ) * ( 1.0 - rate );
-    }
-    else
-    {
-        value = state.ball().pos().x + ServerParam::i().pitchLength();
-    }
+    value = get_ball_position_value( ServerParam::i(), state.ball().pos() );
 #else
     value = state.ball().pos().x + ServerParam::i().pitchLength();
 #endif
@@ -801,7 +1131,7 @@ FieldEvaluator2016::getBallPositionValue( const std::vector< ActionStatePair > &
 
  */
 double
-FieldEvaluator2016::getShootChanceValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2016::getShootChanceValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
@@ -822,14 +1152,14 @@ FieldEvaluator2016::getShootChanceValue( const std::vector< ActionStatePair > &
 
  */
 double
-FieldEvaluator2016::getFrontSpaceValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2016::getFrontSpaceValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
     const Vector2D pos = state.ballHolder().pos();
 
     double free_angle = 90.0;
-    for ( PredictPlayerObject::Cont::const_iterator o = state.theirPlayers().begin(), end = state.theirPlayers().end();
+    for ( PredictState::PlayerCont::const_iterator o = state.theirPlayers().begin(), end = state.theirPlayers().end();
           o != end;
           ++o )
     {
@@ -859,7 +1189,7 @@ FieldEvaluator2016::getFrontSpaceValue( const std::vector< ActionStatePair > & p
 
  */
 double
-FieldEvaluator2016::getOverDefenseLineValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2016::getOverDefenseLineValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
@@ -892,19 +1222,11 @@ FieldEvaluator2016::getOverDefenseLineValue( const std::vector< ActionStatePair
 
  */
 double
-FieldEvaluator2016::getOpponentGoalDistanceValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2016::getOpponentGoalDistanceValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
-    double value = 0.0;
-
-    const double their_goal_dist = ServerParam::i().theirTeamGoalPos().dist( state.ball().pos() );
-    if ( their_goal_dist <= 30.0 )
-    {
-        value = ( 30.0 - their_goal_dist ) * THEIR_GOAL_DIST_RATE;
-    }
-
-    return value;
+    return get_opponent_goal_distance_value( ServerParam::i(), state.ball().pos() );
 }
 
 /*-------------------------------------------------------------------*/
@@ -912,19 +1234,11 @@ FieldEvaluator2016::getOpponentGoalDistanceValue( const std::vector< ActionState
 
  */
 double
-FieldEvaluator2016::getOurGoalDistanceValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2016::getOurGoalDistanceValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
-    double value = 0.0;
-
-    const double our_goal_dist = ServerParam::i().ourTeamGoalPos().dist( state.ball().pos() );
-    if ( our_goal_dist <= 30.0 )
-    {
-        value = ( 30.0 - our_goal_dist ) * -3.28763719460485;
-    }
-
-    return value;
+    return get_our_goal_distance_value( ServerParam::i(), state.ball().pos() );
 }
 
 /*-------------------------------------------------------------------*/
@@ -933,7 +1247,7 @@ FieldEvaluator2016::getOurGoalDistanceValue( const std::vector< ActionStatePair
  */
 double
 FieldEvaluator2016::getLengthPenalty( const PredictState & first_state,
-                                      const std::vector< ActionStatePair > & path ) const
+                                      const ActionStatePath & path ) const
 {
     (void)first_state;
 
@@ -942,12 +1256,7 @@ FieldEvaluator2016::getLengthPenalty( const PredictState & first_state,
     //
     // penalty by path length
     //
-    double path_length_penalty = 0.0;
-
-    if ( path.size() >= 2 ) path_length_penalty -= 3.0;
-    if ( path.size() >= 3 ) path_length_penalty -= 4.0;
-    if ( path.size() >= 4 ) path_length_penalty -= 5.0;
-    if ( path.size() >= 5 ) path_length_penalty -= 6.0;
+    const double path_length_penalty = get_path_length_penalty( path.size() );
 
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::PLAN,
@@ -959,9 +1268,7 @@ FieldEvaluator2016::getLengthPenalty( const PredictState & first_state,
     //
     // penalty by spent time
     //
-    const double spent_time_penalty = -0.15 * last_state.spentTime();
-    //const double spent_time_penalty = -0.3 * last_state.spentTime();
-
+    const double spent_time_penalty = get_spent_time_penalty( last_state.spentTime() );
 
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::PLAN,
@@ -978,7 +1285,7 @@ FieldEvaluator2016::getLengthPenalty( const PredictState & first_state,
 
  */
 double
-FieldEvaluator2016::getOpponentDistancePenalty( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2016::getOpponentDistancePenalty( const ActionStatePath & path ) const
 {
     //const double PATH_OPPENENT_DIST_PENALTY = -1.0e+4;
     const double PATH_OPPENENT_DIST_PENALTY = -1.0;
@@ -1048,13 +1355,10 @@ FieldEvaluator2016::getOpponentDistancePenalty( const std::vector< ActionStatePa
  */
 double
 FieldEvaluator2016::getActionTypePenalty( const PredictState & first_state,
-                                          const std::vector< ActionStatePair > & path ) const
+                                          const ActionStatePath & path ) const
 {
     double penalty = 0.0;
 
-    const CooperativeAction & first_action = path.front().action();
-    const PredictState & next_state = path.front().state();
-
     if ( path.size() >= 2 )
     {
         double value = 0.0;
@@ -1066,11 +1370,7 @@ FieldEvaluator2016::getActionTypePenalty( const PredictState & first_state,
             AngleDeg next_move_angle = next_move.th();
             if ( path[i-1].action().type() == CooperativeAction::Dribble )
             {
-                double angle_diff = ( prev_move_angle - next_move_angle ).abs();
-                if ( angle_diff > 120.0 )
-                {
-                    value -= ( angle_diff - 120.0 );
-                }
+                value += get_move_angle_penalty( prev_move_angle, next_move_angle );
             }
             prev_move = next_move;
             prev_move_angle = next_move_angle;
@@ -1088,8 +1388,7 @@ FieldEvaluator2016::getActionTypePenalty( const PredictState & first_state,
         const PredictState & shoot_state = ( path.size() == 1
                                              ? first_state
                                              : path[path.size()-2].state() );
-        //double value = - shoot_state.ball().pos().dist( best_shoot_spot );
-        double value = -0.5 * shoot_state.ball().pos().dist( Vector2D( 52.5, 0 ) );
+        double value = get_shoot_spot_penalty( shoot_state.ball().pos() );
         penalty += value;
 #ifdef DEBUG_PRINT
         dlog.addText( Logger::PLAN,
@@ -1101,7 +1400,7 @@ FieldEvaluator2016::getActionTypePenalty( const PredictState & first_state,
             double opponent_dist = get_opponent_dist( first_state,
                                                       path.front().state().ball().pos(),
                                                       0 );
-            value = -1.0 * std::exp( -std::pow( opponent_dist, 2 ) / ( 2.0 * std::pow( 1.0, 2 ) ) );
+            value = get_shoot_opponent_penalty( opponent_dist );
             penalty += value;
 #ifdef DEBUG_PRINT
             dlog.addText( Logger::PLAN,
@@ -1112,28 +1411,18 @@ FieldEvaluator2016::getActionTypePenalty( const PredictState & first_state,
     }
     else
     {
-        if ( first_action.type() == CooperativeAction::Dribble )
-        {
-            // if ( next_state.ball().pos().x < next_state.offsideLineX() - 10.0
-            //      && next_state.ball().pos().x < 36.0 )
-            if ( next_state.ball().pos().x < 0.0
-                 || Strategy::i().opponentType() == Strategy::Type_Gliders )
-            {
-                double opponent_dist = get_opponent_dist( first_state,
-                                                          next_state.ball().pos(),
-                                                          0 );
-                if ( opponent_dist < 5.0 )
-                {
-                    double value = -5.0 * std::exp( -std::pow( opponent_dist, 2 ) / ( 2.0 * std::pow( 2.0, 2 ) ) );
-                    penalty += value;
+        double value = get_first_dribble_value( first_state,
+                                                path.front(),
+                                                Strategy::i().opponentType() == Strategy::Type_Gliders );
+        penalty += value;
 #ifdef DEBUG_PRINT
-                    dlog.addText( Logger::PLAN,
-                                  "(eval) __ penalty for opponent dist after dribble %f (%f)",
-                                  value, penalty );
-#endif
-                }
-            }
+        if ( value != 0.0 )
+        {
+            dlog.addText( Logger::PLAN,
+                          "(eval) __ penalty for opponent dist after dribble %f (%f)",
+                          value, penalty );
         }
+#endif
     }
 
     return penalty;
@@ -1144,7 +1433,7 @@ FieldEvaluator2016::getActionTypePenalty( const PredictState & first_state,
 
  */
 double
-FieldEvaluator2016::getBallPositionForOurGoalieValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2016::getBallPositionForOurGoalieValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
@@ -1184,7 +1473,7 @@ FieldEvaluator2016::getBallPositionForOurGoalieValue( const std::vector< ActionS
 
  */
 double
-FieldEvaluator2016::getOverAttackLineValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2016::getOverAttackLineValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
@@ -1203,7 +1492,7 @@ FieldEvaluator2016::getOverAttackLineValue( const std::vector< ActionStatePair >
 
  */
 double
-FieldEvaluator2016::getCongestionValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2016::getCongestionValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
@@ -1227,7 +1516,7 @@ FieldEvaluator2016::getCongestionValue( const std::vector< ActionStatePair > & p
 
  */
 double
-FieldEvaluator2016::getPassCountValue( const std::vector< ActionStatePair > & path ) const
+FieldEvaluator2016::getPassCountValue( const ActionStatePath & path ) const
 {
     const PredictState & state = path.back().state();
 
@@ -53,7 +53,13 @@ public:
 
     virtual
     double evaluate( const PredictState & first_state,
-                     const std::vector< ActionStatePair > & path );
+                     const ActionStatePath & path );
+
+    virtual
+    void evaluateBatch( const PredictState & first_state,
+                        const ActionStatePath & parent_path,
+                        const std::vector< ActionStatePair > & children,
+                        double * values );
 
     virtual
     double getFirstActionPenalty( const PredictState & first_state,
@@ -62,37 +68,37 @@ public:
 private:
 
     double evaluateImpl( const PredictState & first_state,
-                         const std::vector< ActionStatePair > & path ) const;
+                         const ActionStatePath & path ) const;
     double getFirstActionPenaltyImpl( const PredictState & first_state,
                                       const ActionStatePair & first_pair );
 
 
-    double getStateValue( const std::vector< ActionStatePair > & path ) const;
+    double getStateValue( const ActionStatePath & path ) const;
 
     //
     // evaluation rules
     //
-    double getBallPositionValue( const std::vector< ActionStatePair > & path ) const;
-    double getShootChanceValue( const std::vector< ActionStatePair > & path ) const;
-    double getFrontSpaceValue( const std::vector< ActionStatePair > & path ) const;
-    double getOverDefenseLineValue( const std::vector< ActionStatePair > & path ) const;
-    double getOpponentGoalDistanceValue( const std::vector< ActionStatePair > & path ) const;
-    double getOurGoalDistanceValue( const std::vector< ActionStatePair > & path ) const;
-    double getBallPositionForOurGoalieValue( const std::vector< ActionStatePair > & path ) const;
-    double getOverAttackLineValue( const std::vector< ActionStatePair > & path ) const;
-    double getCongestionValue( const std::vector< ActionStatePair > & path ) const;
-    double getPassCountValue( const std::vector< ActionStatePair > & path ) const;
+    double getBallPositionValue( const ActionStatePath & path ) const;
+    double getShootChanceValue( const ActionStatePath & path ) const;
+    double getFrontSpaceValue( const ActionStatePath & path ) const;
+    double getOverDefenseLineValue( const ActionStatePath & path ) const;
+    double getOpponentGoalDistanceValue( const ActionStatePath & path ) const;
+    double getOurGoalDistanceValue( const ActionStatePath & path ) const;
+    double getBallPositionForOurGoalieValue( const ActionStatePath & path ) const;
+    double getOverAttackLineValue( const ActionStatePath & path ) const;
+    double getCongestionValue( const ActionStatePath & path ) const;
+    double getPassCountValue( const ActionStatePath & path ) const;
     //
     // additional penalty
     //
 
     double getLengthPenalty( const PredictState & first_state,
-                             const std::vector< ActionStatePair > & path ) const;
+                             const ActionStatePath & path ) const;
 
-    double getOpponentDistancePenalty( const std::vector< ActionStatePair > & path ) const;
+    double getOpponentDistancePenalty( const ActionStatePath & path ) const;
 
     double getActionTypePenalty( const PredictState & first_state,
-                                 const std::vector< ActionStatePair > & path ) const;
+                                 const ActionStatePath & path ) const;
 
 };
 
@@ -65,7 +65,7 @@ FieldEvaluatorDefault::~FieldEvaluatorDefault()
  */
 double
 FieldEvaluatorDefault::evaluate( const PredictState & /*first_state*/,
-                                 const std::vector< ActionStatePair > & path )
+                                 const ActionStatePath & path )
 {
     const ServerParam & SP = ServerParam::i();
 
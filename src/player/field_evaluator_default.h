@@ -41,7 +41,7 @@ public:
 
     virtual
     double evaluate( const PredictState & first_state,
-                     const std::vector< ActionStatePair > & path );
+                     const ActionStatePath & path );
 
 private:
 
@@ -51,7 +51,10 @@
 
 #include <svmrank/svm_struct_api.h>
 
+#include <iostream>
 #include <sstream>
+#include <algorithm>
+#include <cmath>
 
 using namespace rcsc;
 
@@ -180,7 +183,7 @@ get_opponent_dist( const PredictState & state,
 
     double min_dist = MAX_DIST;
 
-    for ( PredictPlayerObject::Cont::const_iterator it = state.theirPlayers().begin(),
+    for ( PredictState::PlayerCont::const_iterator it = state.theirPlayers().begin(),
               end = state.theirPlayers().end();
           it != end;
           ++it )
@@ -218,6 +221,7 @@ get_opponent_dist( const PredictState & state,
 
  */
 FieldEvaluatorSVMRank::FieldEvaluatorSVMRank()
+    : M_compiled( false )
 {
     M_model = svmrank::read_struct_model( Options::i().svmrankEvaluatorModel().c_str(),
                                           &M_learn_param );
@@ -235,6 +239,7 @@ FieldEvaluatorSVMRank::FieldEvaluatorSVMRank()
         M_model.w = M_model.svm_model->lin_weights;
     }
 
+    compileModel();
 }
 
 /*-------------------------------------------------------------------*/
@@ -280,18 +285,355 @@ FieldEvaluatorSVMRank::getFirstActionPenalty( const PredictState & /*first_state
  */
 double
 FieldEvaluatorSVMRank::evaluate( const PredictState & first_state,
-                                 const std::vector< ActionStatePair > & path )
+                                 const ActionStatePath & path )
 {
     if ( path.empty() )
     {
         return 0.0;
     }
 
-    std::vector< double > features;
-    features.resize( FEATURE_SIZE, 0.0 );
+    double features[FEATURE_SIZE];
+    std::fill( features, features + FEATURE_SIZE, 0.0 );
 
     createFeatureVector( first_state, path, features );
 
+    double value = predict( features );
+
+    if ( path.size() == 1
+         && path.front().action().type() == CooperativeAction::Hold
+         && ! std::strcmp( path.front().action().description(), "defaultHold" ) )
+    {
+        // no data to be written
+    }
+    else
+    {
+#if 0
+        debugWriteFeatures( features );
+#endif
+        writeRankData( first_state.self().unum(), first_state.currentTime(),
+                       value, features );
+    }
+
+    return value;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief evaluate all children of one node.
+  The result is same as evaluate(), but the features depending only on
+  the parent path are computed once, and the ball position and
+  congestion features are computed over the structure-of-arrays.
+ */
+void
+FieldEvaluatorSVMRank::evaluateBatch( const PredictState & first_state,
+                                      const ActionStatePath & parent_path,
+                                      const std::vector< ActionStatePair > & children,
+                                      double * values )
+{
+    const size_t size = children.size();
+    if ( size == 0 )
+    {
+        return;
+    }
+
+    if ( dlog.isEnabled( Logger::PLAN )
+         || ! share_opponents( children ) )
+    {
+        // the rank data is written by evaluate()
+        FieldEvaluator::evaluateBatch( first_state, parent_path, children, values );
+        return;
+    }
+
+    const ServerParam & SP = ServerParam::i();
+    const size_t depth = parent_path.size() + 1;
+
+    //
+    // features depending only on the first state and the parent path
+    //
+
+    double shared_features[FEATURE_SIZE];
+    std::fill( shared_features, shared_features + FEATURE_SIZE, 0.0 );
+    shared_features[ FIRST_BALL_X ] = first_state.ball().pos().x;
+    shared_features[ FIRST_BALL_Y ] = first_state.ball().pos().y;
+    shared_features[ FIRST_BALL_ABSY ] = first_state.ball().pos().absY();
+    shared_features[ OFFSIDE_LINE_X ] = first_state.offsideLineX();
+    shared_features[ THEIR_DEFENSE_LINE_X ] = first_state.theirDefensePlayerLineX();
+    if ( depth >= 2 )
+    {
+        setFirstActionFeatures( first_state, parent_path, shared_features );
+    }
+    shared_features[ SEQUENCE_SIZE ] = depth;
+
+    // used only if the child is a shoot action
+    const PredictState & shoot_state = ( depth == 1
+                                         ? first_state
+                                         : parent_path.back().state() );
+    const double shoot_dist_feature
+        = std::max( 0.0, 25.0 - shoot_state.ball().pos().dist( Vector2D( 52.5, 0 ) ) );
+    double shoot_opponent_feature = 0.0;
+    if ( depth >= 2 )
+    {
+        double opponent_dist = get_opponent_dist( first_state,
+                                                  first_state.ball().pos(),
+                                                  0 );
+        shoot_opponent_feature = std::exp( -std::pow( opponent_dist, 2 )
+                                           / ( 2.0 * std::pow( 1.0, 2 ) ) );
+    }
+
+    // the opponents for the shoot chance. all children have the same opponents.
+    const PredictState & front_state = children.front().state();
+    const AbstractPlayerObject::Cont shoot_opponents
+        = front_state.getPlayers( new OpponentOrUnknownPlayerPredicate( front_state.self().side() ) );
+
+    //
+    // structure-of-arrays of the candidates
+    //
+
+    std::vector< double > ball_x( size );
+    std::vector< double > ball_y( size );
+    std::vector< double > spot_dist( size );
+    std::vector< double > congestion( size );
+
+    for ( size_t i = 0; i < size; ++i )
+    {
+        ball_x[i] = children[i].state().ball().pos().x;
+        ball_y[i] = children[i].state().ball().pos().y;
+    }
+
+    {
+        const double spot_x = SP.pitchHalfLength() - ServerParam::DEFAULT_PENALTY_SPOT_DIST;
+        for ( size_t i = 0; i < size; ++i )
+        {
+            spot_dist[i] = std::sqrt( std::pow( spot_x - ball_x[i], 2 ) + std::pow( ball_y[i], 2 ) );
+        }
+    }
+
+    FieldAnalyzer::get_congestion_batch( front_state, &ball_x[0], &ball_y[0], size, &congestion[0] );
+
+    //
+    // set the remaining features and predict the value
+    //
+
+    double features[FEATURE_SIZE];
+
+    for ( size_t i = 0; i < size; ++i )
+    {
+        const ActionStatePair & pair = children[i];
+        const PredictState & state = pair.state();
+        const double x = ball_x[i];
+        const double abs_y = std::fabs( ball_y[i] );
+
+        std::copy( shared_features, shared_features + FEATURE_SIZE, features );
+
+        features[ LAST_BALL_X ] = x;
+        features[ LAST_BALL_Y ] = ball_y[i];
+        features[ LAST_BALL_ABSY ] = abs_y;
+
+        if ( depth == 1 )
+        {
+            const ActionStatePair * first_pair = &pair;
+            setFirstActionFeatures( first_state, ActionStatePath( &first_pair, 1 ), features );
+        }
+
+        if ( pair.action().type() == CooperativeAction::Shoot )
+        {
+            features[ SHOOT_DIST ] = shoot_dist_feature;
+            if ( depth >= 2 )
+            {
+                features[ FIRST_STATE_OPPONENT_DIST_FOR_SHOOT ] = shoot_opponent_feature;
+            }
+        }
+
+        // same as setLastStateFeatures()
+        if ( x > + ( SP.pitchHalfLength() - 0.1 )
+             && abs_y < SP.goalHalfWidth() + 2.0 )
+        {
+            features[ BALL_IN_THEIR_GOAL ] = 1.0;
+        }
+
+        if ( x < - ( SP.pitchHalfLength() - 0.1 )
+             && abs_y < SP.goalHalfWidth() )
+        {
+            features[ BALL_IN_OUR_GOAL ] = 1.0;
+        }
+
+        features[ LAST_BALL_DIST_FROM_PENALTY_SPOT ] = spot_dist[i];
+
+        if ( ShootSimulator::can_shoot_from( state.ballHolder().unum() == state.self().unum(),
+                                             state.ball().pos(),
+                                             shoot_opponents,
+                                             VALID_PLAYER_THRESHOLD ) )
+        {
+            features[ LAST_STATE_SHOOTABLE ] = 1.0;
+        }
+
+        features[ LAST_STATE_CONGESTION ] = congestion[i];
+
+        features[ SPENT_TIME ] = state.spentTime();
+
+        values[i] = predict( features );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief copy the model into the dense arrays.
+  The feature values are given to svmrank as float. The dense arrays
+  keep the same precision, so that the fast path returns the same value
+  as the generic classifier.
+ */
+void
+FieldEvaluatorSVMRank::compileModel()
+{
+    M_compiled = false;
+    M_linear_scorer.clear();
+    M_support_vectors.clear();
+    M_support_vector_norms.clear();
+    M_support_vector_alphas.clear();
+
+    const svmrank::MODEL * model = M_model.svm_model;
+    if ( ! model )
+    {
+        return;
+    }
+
+    //
+    // linear kernel: the weight vector has already been computed.
+    //
+    if ( model->kernel_parm.kernel_type == svmrank::LINEAR )
+    {
+        M_compiled = M_linear_scorer.assign( model, FEATURE_SIZE );
+        return;
+    }
+
+    //
+    // non-linear kernel: the custom kernel and the combined support vectors are not supported.
+    //
+    if ( model->kernel_parm.kernel_type != svmrank::POLY
+         && model->kernel_parm.kernel_type != svmrank::RBF
+         && model->kernel_parm.kernel_type != svmrank::SIGMOID )
+    {
+        std::cerr << "(FieldEvaluatorSVMRank) unsupported kernel type "
+                  << model->kernel_parm.kernel_type
+                  << ". use the generic classifier." << std::endl;
+        return;
+    }
+
+    // supvec[0] is not used in svmrank.
+    for ( long i = 1; i < model->sv_num; ++i )
+    {
+        const svmrank::SVECTOR * sv = model->supvec[i]->fvec;
+        if ( ! sv
+             || sv->next
+             || sv->kernel_id != 0 )
+        {
+            std::cerr << "(FieldEvaluatorSVMRank) unsupported support vector format."
+                      << " use the generic classifier." << std::endl;
+            M_support_vectors.clear();
+            M_support_vector_norms.clear();
+            M_support_vector_alphas.clear();
+            return;
+        }
+
+        const size_t offset = M_support_vectors.size();
+        M_support_vectors.resize( offset + FEATURE_SIZE, 0.0f );
+
+        for ( const svmrank::WORD * w = sv->words; w->wnum != 0; ++w )
+        {
+            // the features out of range never appear in the input. they are counted only in the norm.
+            if ( 1 <= w->wnum && w->wnum <= FEATURE_SIZE )
+            {
+                M_support_vectors[offset + w->wnum - 1] = w->weight;
+            }
+        }
+
+        M_support_vector_norms.push_back( sv->twonorm_sq );
+        M_support_vector_alphas.push_back( model->alpha[i] * sv->factor );
+    }
+
+    M_compiled = true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+FieldEvaluatorSVMRank::predict( const double * features ) const
+{
+    if ( ! M_compiled )
+    {
+        return predictGeneric( features );
+    }
+
+    if ( M_linear_scorer.isValid() )
+    {
+        return M_linear_scorer.score( features );
+    }
+
+    return predictKernel( features );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+FieldEvaluatorSVMRank::predictKernel( const double * features ) const
+{
+    const svmrank::KERNEL_PARM & param = M_model.svm_model->kernel_parm;
+
+    float x[FEATURE_SIZE];
+    double x_norm = 0.0;
+    for ( size_t i = 0; i < FEATURE_SIZE; ++i )
+    {
+        x[i] = static_cast< float >( features[i] );
+        x_norm += x[i] * x[i];
+    }
+
+    const size_t sv_size = M_support_vector_alphas.size();
+
+    double dist = 0.0;
+    for ( size_t k = 0; k < sv_size; ++k )
+    {
+        const float * sv = &M_support_vectors[k * FEATURE_SIZE];
+
+        double prod = 0.0;
+        for ( size_t i = 0; i < FEATURE_SIZE; ++i )
+        {
+            prod += sv[i] * x[i];
+        }
+
+        double value = 0.0;
+        switch ( param.kernel_type ) {
+        case svmrank::POLY:
+            value = std::pow( param.coef_lin * prod + param.coef_const,
+                              static_cast< double >( param.poly_degree ) );
+            break;
+        case svmrank::RBF:
+            value = std::exp( -param.rbf_gamma * ( M_support_vector_norms[k] - 2.0 * prod + x_norm ) );
+            break;
+        case svmrank::SIGMOID:
+            value = std::tanh( param.coef_lin * prod + param.coef_const );
+            break;
+        default:
+            break;
+        }
+
+        dist += value * M_support_vector_alphas[k];
+    }
+
+    return dist - M_model.svm_model->b;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief predict the value by the classifier of svmrank.
+  This method allocates the sparse vector for each call.
+ */
+double
+FieldEvaluatorSVMRank::predictGeneric( const double * features ) const
+{
     svmrank::WORD words[FEATURE_SIZE + 1];
     for ( size_t i = 0; i < FEATURE_SIZE; ++i )
     {
@@ -319,21 +661,6 @@ FieldEvaluatorSVMRank::evaluate( const PredictState & first_state,
 
     svmrank::free_svector( doc.fvec );
 
-    if ( path.size() == 1
-         && path.front().action().type() == CooperativeAction::Hold
-         && ! std::strcmp( path.front().action().description(), "defaultHold" ) )
-    {
-        // no data to be written
-    }
-    else
-    {
-#if 0
-        debugWriteFeatures( features );
-#endif
-        writeRankData( first_state.self().unum(), first_state.currentTime(),
-                       value, features );
-    }
-
     return value;
 }
 
@@ -345,11 +672,18 @@ void
 FieldEvaluatorSVMRank::writeRankData( const int unum,
                                       const GameTime & current,
                                       const double value,
-                                      const std::vector< double > & features )
+                                      const double * features )
 {
     static std::string s_query_id = "";
     static GameTime s_time( 0, 0 );
 
+    // the rank data is written only to the debug log.
+    // skip the static data update, because the evaluator can be called by the worker threads.
+    if ( ! dlog.isEnabled( Logger::PLAN ) )
+    {
+        return;
+    }
+
     if ( current.cycle() >= 10000
          || current.stopped() > 0 )
     {
@@ -386,7 +720,7 @@ FieldEvaluatorSVMRank::writeRankData( const int unum,
 
     std::ostringstream ostr;
     ostr << value << " qid:" << s_query_id;
-    for ( size_t i = 0; i < features.size(); ++i )
+    for ( size_t i = 0; i < FEATURE_SIZE; ++i )
     {
         ostr << ' '
              << i + 1 << ':' << features[i];
@@ -402,8 +736,8 @@ FieldEvaluatorSVMRank::writeRankData( const int unum,
  */
 void
 FieldEvaluatorSVMRank::createFeatureVector( const PredictState & first_state,
-                                            const std::vector< ActionStatePair > & path,
-                                            std::vector< double > & features )
+                                            const ActionStatePath & path,
+                                            double * features )
 {
     features[ FIRST_BALL_X ] = first_state.ball().pos().x;
     features[ FIRST_BALL_Y ] = first_state.ball().pos().y;
@@ -426,8 +760,8 @@ FieldEvaluatorSVMRank::createFeatureVector( const PredictState & first_state,
  */
 void
 FieldEvaluatorSVMRank::setFirstActionFeatures( const PredictState & first_state,
-                                               const std::vector< ActionStatePair > & path,
-                                               std::vector< double > & features )
+                                               const ActionStatePath & path,
+                                               double * features )
 {
     const CooperativeAction & first_action = path.front().action();
     const PredictState & next_state = path.front().state();
@@ -528,8 +862,8 @@ FieldEvaluatorSVMRank::setFirstActionFeatures( const PredictState & first_state,
 
  */
 void
-FieldEvaluatorSVMRank::setLastStateFeatures( const std::vector< ActionStatePair > & path,
-                                             std::vector< double > & features )
+FieldEvaluatorSVMRank::setLastStateFeatures( const ActionStatePath & path,
+                                             double * features )
 {
     const PredictState & state = path.back().state();
     const ServerParam & SP = ServerParam::i();
@@ -591,8 +925,8 @@ FieldEvaluatorSVMRank::setLastStateFeatures( const std::vector< ActionStatePair
 
  */
 void
-FieldEvaluatorSVMRank::setSequenceFeatures( const std::vector< ActionStatePair > & path,
-                                            std::vector< double > & features )
+FieldEvaluatorSVMRank::setSequenceFeatures( const ActionStatePath & path,
+                                            double * features )
 {
     features[ SEQUENCE_SIZE ] = path.size();
     features[ SPENT_TIME ] = path.back().state().spentTime();
@@ -604,8 +938,8 @@ FieldEvaluatorSVMRank::setSequenceFeatures( const std::vector< ActionStatePair >
  */
 void
 FieldEvaluatorSVMRank::setLastActionFeatures( const PredictState & first_state,
-                                              const std::vector< ActionStatePair > & path,
-                                              std::vector< double > & features )
+                                              const ActionStatePath & path,
+                                              double * features )
 {
     if ( path.back().action().type() == CooperativeAction::Shoot )
     {
@@ -632,7 +966,7 @@ FieldEvaluatorSVMRank::setLastActionFeatures( const PredictState & first_state,
 
  */
 void
-FieldEvaluatorSVMRank::debugWriteFeatures( const std::vector< double > & features )
+FieldEvaluatorSVMRank::debugWriteFeatures( const double * features )
 {
     dlog.addText( Logger::PLAN, "(eval) %d (FIRST_BALL_X) %f", FIRST_BALL_X, features[ FIRST_BALL_X ] );
     dlog.addText( Logger::PLAN, "(eval) %d (FIRST_BALL_Y) %f", FIRST_BALL_Y, features[ FIRST_BALL_Y ] );
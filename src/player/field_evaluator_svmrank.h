@@ -29,6 +29,7 @@
 
 #include "field_evaluator.h"
 #include "predict_state.h"
+#include "linear_rank_scorer.h"
 
 #include <svmrank/svm_struct_api_types.h>
 
@@ -50,6 +51,16 @@ private:
     svmrank::STRUCTMODEL M_model;
     svmrank::STRUCT_LEARN_PARM M_learn_param;
 
+    //
+    // the model compiled into the dense arrays for the allocation-free prediction
+    //
+
+    LinearRankScorer M_linear_scorer; //!< dense weight vector for the linear kernel
+    std::vector< float > M_support_vectors; //!< dense support vectors for the non-linear kernel. (feature size) values per vector
+    std::vector< double > M_support_vector_norms; //!< squared norm of each support vector
+    std::vector< double > M_support_vector_alphas; //!< alpha * factor of each support vector
+    bool M_compiled; //!< if false, the generic classifier of svmrank is used
+
 public:
     FieldEvaluatorSVMRank();
 
@@ -61,7 +72,13 @@ public:
 
     virtual
     double evaluate( const PredictState & first_state,
-                     const std::vector< ActionStatePair > & path );
+                     const ActionStatePath & path );
+
+    virtual
+    void evaluateBatch( const PredictState & first_state,
+                        const ActionStatePath & parent_path,
+                        const std::vector< ActionStatePair > & children,
+                        double * values );
 
     virtual
     double getFirstActionPenalty( const PredictState & first_state,
@@ -69,28 +86,34 @@ public:
 
 private:
 
+    void compileModel();
+
+    double predict( const double * features ) const;
+    double predictKernel( const double * features ) const;
+    double predictGeneric( const double * features ) const;
+
     void writeRankData( const int unum,
                         const rcsc::GameTime & current,
                         const double value,
-                        const std::vector< double > & features );
+                        const double * features );
 
     void createFeatureVector( const PredictState & first_state,
-                              const std::vector< ActionStatePair > & path,
-                              std::vector< double > & features );
-    svmrank::PATTERN convertTOSVMRankPattern( const std::vector< double > & features );
+                              const ActionStatePath & path,
+                              double * features );
+    svmrank::PATTERN convertTOSVMRankPattern( const double * features );
 
     void setFirstActionFeatures( const PredictState & first_state,
-                                 const std::vector< ActionStatePair > & path,
-                                 std::vector< double > & features );
+                                 const ActionStatePath & path,
+                                 double * features );
     void setLastActionFeatures( const PredictState & first_state,
-                                const std::vector< ActionStatePair > & path,
-                                std::vector< double > & features );
-    void setLastStateFeatures( const std::vector< ActionStatePair > & path,
-                               std::vector< double > & features );
-    void setSequenceFeatures( const std::vector< ActionStatePair > & path,
-                              std::vector< double > & features );
-
-    void debugWriteFeatures( const std::vector< double > & features );
+                                const ActionStatePath & path,
+                                double * features );
+    void setLastStateFeatures( const ActionStatePath & path,
+                               double * features );
+    void setSequenceFeatures( const ActionStatePath & path,
+                              double * features );
+
+    void debugWriteFeatures( const double * features );
 };
 
 #endif
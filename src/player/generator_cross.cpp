@@ -35,6 +35,7 @@
 
 #include "generator_cross.h"
 
+#include "ball_trajectory_table.h"
 #include "field_analyzer.h"
 
 #include <rcsc/action/kick_table.h>
@@ -47,6 +48,8 @@
 #include <rcsc/soccer_math.h>
 #include <rcsc/timer.h>
 
+#define USE_OPPONENT_GRID
+
 // #define USE_POINTTO
 
 // #define DEBUG_PROFILE
@@ -140,6 +143,8 @@ GeneratorCross::clear()
     M_first_point.invalidate();
     M_receiver_candidates.clear();
     M_opponents.clear();
+    M_opponent_grid_indices.clear();
+    M_use_opponent_grid = false;
     M_dash_line_courses.clear();
     M_courses.clear();
 }
@@ -381,6 +386,12 @@ GeneratorCross::updateOpponents( const WorldModel & wm )
     const Vector2D goal = ServerParam::i().theirTeamGoalPos();
     const AngleDeg goal_angle_from_ball = ( goal - M_first_point ).th();
 
+#ifdef USE_OPPONENT_GRID
+    M_use_opponent_grid = FieldAnalyzer::i().opponentGrid().isValid( wm );
+#else
+    M_use_opponent_grid = false;
+#endif
+
     for ( AbstractPlayerObject::Cont::const_iterator p = wm.theirPlayers().begin(),
               end = wm.theirPlayers().end();
           p != end;
@@ -408,6 +419,7 @@ GeneratorCross::updateOpponents( const WorldModel & wm )
         }
 
         M_opponents.push_back( *p );
+        M_opponent_grid_indices.push_back( static_cast< size_t >( p - wm.theirPlayers().begin() ) );
 
 #ifdef DEBUG_PRINT
         dlog.addText( Logger::CROSS,
@@ -622,6 +634,7 @@ GeneratorCross::createCrossOnDashLine( const WorldModel & wm,
 #endif
 
     const ServerParam & SP = ServerParam::i();
+    const BallTrajectoryTable & ball_table = BallTrajectoryTable::i();
     const PlayerType * ptype = receiver->playerTypePtr();
 
     Vector2D receiver_pos = receiver->pos();
@@ -714,12 +727,12 @@ GeneratorCross::createCrossOnDashLine( const WorldModel & wm,
 
         int kick_count = 1;
         int ball_move_step = n_dash;
-        double first_ball_speed = SP.firstBallSpeed( ball_move_dist, ball_move_step );
+        double first_ball_speed = ball_table.firstSpeed( ball_move_dist, ball_move_step );
 
         while ( first_ball_speed > SP.ballSpeedMax() )
         {
             ++ball_move_step;
-            first_ball_speed = SP.firstBallSpeed( ball_move_dist, ball_move_step );
+            first_ball_speed = ball_table.firstSpeed( ball_move_dist, ball_move_step );
         }
 
 #ifdef DEBUG_PRINT
@@ -758,7 +771,7 @@ GeneratorCross::createCrossOnDashLine( const WorldModel & wm,
             int one_kick_ball_move_step = SP.ballMoveStep( max_one_step_speed, ball_move_dist );
             if ( one_kick_ball_move_step > 0 )
             {
-                double one_kick_first_ball_speed = SP.firstBallSpeed( ball_move_dist, one_kick_ball_move_step );
+                double one_kick_first_ball_speed = ball_table.firstSpeed( ball_move_dist, one_kick_ball_move_step );
 #ifdef DEBUG_PRINT
                 dlog.addText( Logger::CROSS,
                               "%d: try 1step kick. first_ball_speed=%.3f move_step=%d",
@@ -787,7 +800,7 @@ GeneratorCross::createCrossOnDashLine( const WorldModel & wm,
                     // adjust first ball speed
                     //
                     double two_kick_speed = std::min( SP.ballSpeedMax(),
-                                                      SP.firstBallSpeed( ball_move_dist, ball_move_step - 1 ) );
+                                                      ball_table.firstSpeed( ball_move_dist, ball_move_step - 1 ) );
                     kick_count = 2;
                     --ball_move_step;
                     first_ball_speed = two_kick_speed;
@@ -869,6 +882,7 @@ GeneratorCross::createCross( const WorldModel & wm,
     static const double DIST_STEP = 0.9;
 
     const ServerParam & SP = ServerParam::i();
+    const BallTrajectoryTable & ball_table = BallTrajectoryTable::i();
 
     const double min_first_ball_speed = SP.ballSpeedMax() * 0.67; // Magic Number
     const double max_first_ball_speed = ( wm.gameMode().type() == GameMode::PlayOn
@@ -956,7 +970,7 @@ GeneratorCross::createCross( const WorldModel & wm,
 
                 ++M_total_count;
 
-                double first_ball_speed = SP.firstBallSpeed( ball_move_dist, step );
+                double first_ball_speed = ball_table.firstSpeed( ball_move_dist, step );
                 if ( first_ball_speed < min_first_ball_speed )
                 {
 #ifdef DEBUG_PRINT_FAILED_COURSE
@@ -1000,7 +1014,7 @@ GeneratorCross::createCross( const WorldModel & wm,
                     }
                 }
 
-                double receive_ball_speed = first_ball_speed * std::pow( SP.ballDecay(), step );
+                double receive_ball_speed = ball_table.speedAfter( first_ball_speed, step );
                 if ( receive_ball_speed < MIN_RECEIVE_BALL_SPEED )
                 {
 #ifdef DEBUG_PRINT_FAILED_COURSE
@@ -1082,13 +1096,39 @@ GeneratorCross::getSafetyLevel( const double first_ball_speed,
                   M_total_count, first_ball_speed, ball_move_angle.degree(), n_kick, ball_step );
 #endif
 
+    //
+    // broad phase by the opponent grid.
+    // the opponents out of the capsule always satisfy the "too far" condition
+    // in getOpponentSafetyLevel() at every step, so they are always Safe.
+    //
+    const OpponentGrid & grid = FieldAnalyzer::i().opponentGrid();
+    OpponentGrid::Mask candidates = 0;
+    if ( M_use_opponent_grid )
+    {
+        const ServerParam & SP = ServerParam::i();
+        const double max_control_area = std::max( SP.catchableArea(), grid.maxKickableArea() );
+        candidates = grid.query( M_first_point,
+                                 BallTrajectoryTable::i().inertiaPoint( M_first_point,
+                                                                        first_ball_vel,
+                                                                        ball_step ),
+                                 ball_step,
+                                 OpponentGrid::NO_COUNT_CAP,
+                                 max_control_area + 0.15 + 1.0 + 0.01 );
+    }
+
     CooperativeAction::SafetyLevel result = CooperativeAction::Safe;
+    int skip_count = 0;
 
-    for ( AbstractPlayerObject::Cont::const_iterator o = M_opponents.begin(), end = M_opponents.end();
-          o != end;
-          ++o )
+    for ( size_t i = 0; i < M_opponents.size(); ++i )
     {
-        CooperativeAction::SafetyLevel level = getOpponentSafetyLevel( *o, first_ball_vel, ball_move_angle, n_kick, ball_step );
+        if ( M_use_opponent_grid
+             && ! grid.contains( candidates, M_opponent_grid_indices[i] ) )
+        {
+            ++skip_count;
+            continue;
+        }
+
+        CooperativeAction::SafetyLevel level = getOpponentSafetyLevel( M_opponents[i], first_ball_vel, ball_move_angle, n_kick, ball_step );
         if ( result > level )
         {
             result = level;
@@ -1099,6 +1139,11 @@ GeneratorCross::getSafetyLevel( const double first_ball_speed,
         }
     }
 
+    if ( M_use_opponent_grid )
+    {
+        grid.addSkipCount( static_cast< int >( M_opponents.size() ), skip_count );
+    }
+
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::CROSS,
                   "%d: safe=%d",
@@ -1167,11 +1212,11 @@ GeneratorCross::getOpponentSafetyLevel( const AbstractPlayerObject * opponent,
 
     CooperativeAction::SafetyLevel result = CooperativeAction::Safe;
 
-    Vector2D ball_pos = inertia_n_step_point( M_first_point,
-                                              first_ball_vel,
-                                              min_step - 1,
-                                              SP.ballDecay() );
-    Vector2D ball_vel = first_ball_vel * std::pow( SP.ballDecay(), min_step - 1 );
+    const BallTrajectoryTable & ball_table = BallTrajectoryTable::i();
+    Vector2D ball_pos = ball_table.inertiaPoint( M_first_point,
+                                                 first_ball_vel,
+                                                 min_step - 1 );
+    Vector2D ball_vel = first_ball_vel * ball_table.decayPow( min_step - 1 );
     for ( int step = min_step; step <= ball_step; ++step )
     {
         ball_pos += ball_vel;
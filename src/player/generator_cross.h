@@ -71,6 +71,8 @@ private:
 
     rcsc::AbstractPlayerObject::Cont M_receiver_candidates;
     rcsc::AbstractPlayerObject::Cont M_opponents;
+    std::vector< size_t > M_opponent_grid_indices; //!< index of each opponent in WorldModel::theirPlayers()
+    bool M_use_opponent_grid; //!< if true, the opponents are pruned by FieldAnalyzer::opponentGrid()
 
     Cont M_dash_line_courses;
     Cont M_courses;
@@ -36,6 +36,8 @@
 #include "generator_keep_dribble.h"
 
 #include "act_dribble.h"
+#include "ball_trajectory_table.h"
+#include "dash_profile_cache.h"
 #include "field_analyzer.h"
 
 #include <rcsc/player/world_model.h>
@@ -51,6 +53,9 @@
 
 #include <cmath>
 
+#define USE_OPPONENT_GRID
+#define USE_DASH_PROFILE_CACHE
+
 // #define DEBUG_PROFILE
 
 // #define DEBUG_PRINT_COMMON
@@ -1321,7 +1326,7 @@ GeneratorKeepDribble::simulateKickDashes( const WorldModel & wm )
 
     for ( int iy = 0; iy < 2; ++iy )
     {
-        const double ball_vel_y = SP.firstBallSpeed( target_y[iy] - first_ball_rel_pos.y, self_cache.size() );
+        const double ball_vel_y = BallTrajectoryTable::i().firstSpeed( target_y[iy] - first_ball_rel_pos.y, self_cache.size() );
 
 #ifdef DEBUG_PRINT_SIMULATE_KICK_DASHES
         dlog.addText( Logger::DRIBBLE,
@@ -1520,8 +1525,8 @@ GeneratorKeepDribble::simulateKick2Dashes( const WorldModel & wm )
                                          ptype.playerSize(),
                                          ptype.kickableMargin() );
         const double max_kick_effect2 = std::pow( kprate * ServerParam::i().maxPower(), 2 );
-        const double ball_vel_y = ServerParam::i().firstBallSpeed( target_y[iy] - first_ball_rel_pos.y,
-                                                                   self_cache.size() );
+        const double ball_vel_y = BallTrajectoryTable::i().firstSpeed( target_y[iy] - first_ball_rel_pos.y,
+                                                                       self_cache.size() );
 
         for ( double target_x = target_x_max; target_x > 0.1; target_x -= 0.1 )
         {
@@ -2004,7 +2009,7 @@ GeneratorKeepDribble::simulateTurnKickDashes( const WorldModel & wm,
 
     for ( int iy = 0; iy < 2; ++iy )
     {
-        const double ball_vel_y = SP.firstBallSpeed( target_y[iy] - first_ball_rel_pos.y, self_cache.size() );
+        const double ball_vel_y = BallTrajectoryTable::i().firstSpeed( target_y[iy] - first_ball_rel_pos.y, self_cache.size() );
 
         for ( double target_x = target_x_max; target_x > target_x_min - 0.1; target_x -= 0.1 )
         {
@@ -2155,18 +2160,39 @@ GeneratorKeepDribble::createSelfCacheRelative( const PlayerType & ptype,
     // dash simulation
     //
 
-    for ( int i = 0; i < dash_count; ++i )
+#ifdef USE_DASH_PROFILE_CACHE
+    if ( dash_count <= DashProfileCache::MAX_DASH )
     {
-        double dash_power = stamina_model.getSafetyDashPower( ptype, SP.maxDashPower(), 100.0 );
-        double dash_accel = dash_power * ptype.dashPowerRate() * stamina_model.effort();
+        const DashProfileCache::Profile & profile
+            = DashProfileCache::instance().get( ptype, stamina_model, SP.maxDashPower(), 100.0, dash_count );
 
-        self_vel.x += dash_accel;
-        self_pos += self_vel;
-        self_vel *= ptype.playerDecay();
+        for ( int i = 0; i < dash_count; ++i )
+        {
+            double dash_accel = profile.dash_power_[i] * ptype.dashPowerRate() * profile.effort_[i];
 
-        stamina_model.simulateDash( ptype, dash_power );
+            self_vel.x += dash_accel;
+            self_pos += self_vel;
+            self_vel *= ptype.playerDecay();
 
-        self_cache.push_back( self_pos );
+            self_cache.push_back( self_pos );
+        }
+    }
+    else
+#endif
+    {
+        for ( int i = 0; i < dash_count; ++i )
+        {
+            double dash_power = stamina_model.getSafetyDashPower( ptype, SP.maxDashPower(), 100.0 );
+            double dash_accel = dash_power * ptype.dashPowerRate() * stamina_model.effort();
+
+            self_vel.x += dash_accel;
+            self_pos += self_vel;
+            self_vel *= ptype.playerDecay();
+
+            stamina_model.simulateDash( ptype, dash_power );
+
+            self_cache.push_back( self_pos );
+        }
     }
 }
 
@@ -2261,7 +2287,7 @@ GeneratorKeepDribble::simulateKickTurnsDashes( const WorldModel & wm,
 
     for ( int iy = 0; iy < 2; ++iy )
     {
-        const double ball_vel_y = SP.firstBallSpeed( target_y[iy] - first_ball_rel_pos.y, self_cache.size() );
+        const double ball_vel_y = BallTrajectoryTable::i().firstSpeed( target_y[iy] - first_ball_rel_pos.y, self_cache.size() );
 
         for ( double target_x = target_x_max; target_x > target_x_min; target_x -= 0.1 )
         {
@@ -2269,8 +2295,7 @@ GeneratorKeepDribble::simulateKickTurnsDashes( const WorldModel & wm,
 
             const double ball_vel_x
                 = ( self_cache[2].x + target_x - first_ball_rel_pos.x )
-                / ( ( 1.0 - std::pow( SP.ballDecay(), 3 ) )
-                    / ( 1.0 - SP.ballDecay() ) );
+                / BallTrajectoryTable::i().sumFactor( 3 );
             const Vector2D ball_vel_by_kick( ball_vel_x, ball_vel_y );
 
             if ( ball_vel_by_kick.r2() > ball_speed_max2 )
@@ -2622,7 +2647,7 @@ GeneratorKeepDribble::simulateCollideTurnKickDashes( const WorldModel & wm,
 
     for ( int iy = 0; iy < 2; ++iy )
     {
-        const double ball_vel_y = SP.firstBallSpeed( target_y[iy] - first_ball_rel_pos.y, self_cache.size() );
+        const double ball_vel_y = BallTrajectoryTable::i().firstSpeed( target_y[iy] - first_ball_rel_pos.y, self_cache.size() );
 
         for ( double target_x = target_x_max; target_x > target_x_min - 0.1; target_x -= 0.1 )
         {
@@ -2731,13 +2756,46 @@ GeneratorKeepDribble::getSafetyLevel( const WorldModel & wm,
     // const bool over_penalty_line = ( ball_pos.x > SP.theirPenaltyAreaLineX()
     //                                  || ServerParam::i().theirTeamGoalPos().dist2( ball_pos ) < std::pow( 20.0, 2 ) );
 
+    //
+    // broad phase by the opponent grid.
+    // the opponents out of the circle always satisfy the "too far"
+    // condition below, so they never change the result.
+    //
+    const OpponentGrid & grid = FieldAnalyzer::i().opponentGrid();
+#ifdef USE_OPPONENT_GRID
+    const bool use_grid = grid.isValid( wm );
+#else
+    const bool use_grid = false;
+#endif
+    OpponentGrid::Mask candidates = 0;
+    if ( use_grid )
+    {
+        const double max_control_area = std::max( SP.tackleDist() - 0.1,
+                                                  std::max( SP.catchableArea(),
+                                                            grid.maxKickableArea() ) + 0.1 );
+        candidates = grid.query( ball_pos, ball_pos,
+                                 step,
+                                 OpponentGrid::NO_COUNT_CAP,
+                                 max_control_area * 2.0 + 0.01 );
+    }
+
     CooperativeAction::SafetyLevel result = CooperativeAction::Safe;
+    int check_count = 0;
+    int skip_count = 0;
 
     for ( PlayerObject::Cont::const_iterator o = wm.opponentsFromSelf().begin(),
               end = wm.opponentsFromSelf().end();
           o != end;
           ++o )
     {
+        ++check_count;
+        if ( use_grid
+             && ! grid.contains( candidates, *o ) )
+        {
+            ++skip_count;
+            continue;
+        }
+
         const PlayerType * ptype = (*o)->playerTypePtr();
         const double actual_control_area = ( (*o)->goalie() && penalty_area
                                              ? SP.catchableArea() + 0.1
@@ -2834,5 +2892,10 @@ GeneratorKeepDribble::getSafetyLevel( const WorldModel & wm,
         }
     }
 
+    if ( use_grid )
+    {
+        grid.addSkipCount( check_count, skip_count );
+    }
+
     return result;
 }
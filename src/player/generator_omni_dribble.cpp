@@ -36,6 +36,7 @@
 #include "generator_omni_dribble.h"
 
 #include "act_dribble.h"
+#include "dash_profile_cache.h"
 #include "field_analyzer.h"
 
 #include <rcsc/player/world_model.h>
@@ -53,6 +54,9 @@
 
 #include <cmath>
 
+#define USE_OPPONENT_GRID
+#define USE_DASH_PROFILE_CACHE
+
 // #define DEBUG_PROFILE
 // #define DEBUG_PRINT
 // #define DEBUG_PRINT_SUCCESS_COURSE
@@ -441,21 +445,46 @@ GeneratorOmniDribble::createSelfCache( const WorldModel & wm,
     const double dash_dir_rate = SP.dashDirRate( dash_dir );
     const Vector2D unit_vec = Vector2D::polar2vector( 1.0, dash_angle );
 
-    for ( int i = 0; i < n_dash; ++i )
+#ifdef USE_DASH_PROFILE_CACHE
+    if ( n_dash <= DashProfileCache::MAX_DASH )
+    {
+        const DashProfileCache::Profile & profile
+            = DashProfileCache::instance().get( ptype, stamina_model, SP.maxDashPower(),
+                                                DashProfileCache::DEFAULT_STAMINA_BUFFER, n_dash );
+
+        for ( int i = 0; i < n_dash; ++i )
+        {
+            Vector2D dash_accel = unit_vec * ( profile.dash_power_[i]
+                                               * dash_dir_rate
+                                               * ptype.dashPowerRate()
+                                               * profile.effort_[i] );
+
+            my_vel += dash_accel;
+            my_pos += my_vel;
+            my_vel *= ptype.playerDecay();
+
+            self_cache.push_back( my_pos );
+        }
+    }
+    else
+#endif
     {
-        double dash_power = stamina_model.getSafetyDashPower( ptype, SP.maxDashPower() );
-        Vector2D dash_accel = unit_vec * ( dash_power
-                                           * dash_dir_rate
-                                           * ptype.dashPowerRate()
-                                           * stamina_model.effort() );
+        for ( int i = 0; i < n_dash; ++i )
+        {
+            double dash_power = stamina_model.getSafetyDashPower( ptype, SP.maxDashPower() );
+            Vector2D dash_accel = unit_vec * ( dash_power
+                                               * dash_dir_rate
+                                               * ptype.dashPowerRate()
+                                               * stamina_model.effort() );
 
-        my_vel += dash_accel;
-        my_pos += my_vel;
-        my_vel *= ptype.playerDecay();
+            my_vel += dash_accel;
+            my_pos += my_vel;
+            my_vel *= ptype.playerDecay();
 
-        stamina_model.simulateDash( ptype, dash_power );
+            stamina_model.simulateDash( ptype, dash_power );
 
-        self_cache.push_back( my_pos );
+            self_cache.push_back( my_pos );
+        }
     }
 }
 
@@ -590,7 +619,32 @@ GeneratorOmniDribble::getSafetyLevel( const WorldModel & wm,
                                       const int n_dash,
                                       const Vector2D & last_ball_pos )
 {
+    //
+    // broad phase by the opponent grid.
+    // Safe requires opp_dash >= my_dash + 7 in getOpponentSafetyLevel()
+    // because opp_step is reduced by at most 2 steps. one more step is
+    // added to the reach step for the rounding of the dash distance table.
+    //
+    const OpponentGrid & grid = FieldAnalyzer::i().opponentGrid();
+#ifdef USE_OPPONENT_GRID
+    const bool use_grid = grid.isValid( wm );
+#else
+    const bool use_grid = false;
+#endif
+    OpponentGrid::Mask candidates = 0;
+    if ( use_grid )
+    {
+        const double max_control_area = std::max( ServerParam::i().catchableArea(),
+                                                  grid.maxKickableArea() );
+        candidates = grid.query( last_ball_pos, last_ball_pos,
+                                 1 + n_dash + 6,
+                                 0,
+                                 max_control_area + 0.01 );
+    }
+
     CooperativeAction::SafetyLevel result = CooperativeAction::Safe;
+    int check_count = 0;
+    int skip_count = 0;
 
     for ( PlayerObject::Cont::const_iterator o = wm.opponentsFromSelf().begin(),
               end = wm.opponentsFromSelf().end();
@@ -599,6 +653,14 @@ GeneratorOmniDribble::getSafetyLevel( const WorldModel & wm,
     {
         if ( (*o)->distFromSelf() > 20.0 ) continue;
 
+        ++check_count;
+        if ( use_grid
+             && ! grid.contains( candidates, *o ) )
+        {
+            ++skip_count;
+            continue;
+        }
+
         int step = 0;
         CooperativeAction::SafetyLevel level = getOpponentSafetyLevel( n_dash,
                                                                        last_ball_pos,
@@ -621,6 +683,11 @@ GeneratorOmniDribble::getSafetyLevel( const WorldModel & wm,
         }
     }
 
+    if ( use_grid )
+    {
+        grid.addSkipCount( check_count, skip_count );
+    }
+
     return result;
 }
 
@@ -35,7 +35,11 @@
 #include "generator_pass.h"
 
 #include "act_pass.h"
+#include "ball_trajectory_table.h"
 #include "field_analyzer.h"
+#include "intercept_probability.h"
+#include "opponent_reach_filter.h"
+#include "options.h"
 
 #include <rcsc/player/world_model.h>
 #include <rcsc/player/intercept_table.h>
@@ -46,12 +50,15 @@
 #include <rcsc/math_util.h>
 #include <rcsc/timer.h>
 
+#include <iostream>
 #include <algorithm>
 #include <limits>
 #include <sstream>
 #include <cmath>
 
 #define USE_FILTER
+#define USE_OPPONENT_REACH_FILTER
+#define USE_OPPONENT_GRID
 
 // #define USE_POINTTO
 // #define USE_PRE_CHECK_RECEIVER
@@ -80,6 +87,10 @@ namespace {
 const double KICK_COUNT_FACTOR = 0.99;
 const double OFFENSIVE_PROB_FACTOR = 0.8;
 
+const int DIRECT_PASS_MIN_RECEIVE_STEP = 3;
+const int LEADING_PASS_MIN_RECEIVE_STEP = 4;
+const int THROUGH_PASS_MIN_RECEIVE_STEP = 6;
+
 inline
 void
 debug_paint_pass( const int count,
@@ -188,6 +199,19 @@ struct ThroughPassSorter {
       }
 };
 
+/*!
+  \brief convert the opponent intercept probability to the safety level.
+ */
+inline
+CooperativeAction::SafetyLevel
+get_intercept_probability_level( const double prob )
+{
+    if ( prob >= 0.45 ) return CooperativeAction::Failure;
+    if ( prob >= 0.25 ) return CooperativeAction::Dangerous;
+    if ( prob >= 0.15 ) return CooperativeAction::MaybeDangerous;
+    return CooperativeAction::Safe;
+}
+
 struct SafetyLevelNotEqual {
     CooperativeAction::SafetyLevel level_;
 
@@ -352,6 +376,32 @@ GeneratorPass::Opponent::Opponent( const AbstractPlayerObject * p )
 
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief course creation task for one receiver
+ */
+struct GeneratorPass::CourseTask
+    : public ActionChainWorkerPool::Task {
+
+    GeneratorPass * worker_;
+    const WorldModel * wm_;
+    const Receiver * receiver_;
+    int type_count_[3]; //!< the number of checked courses for direct, leading and through pass
+
+    CourseTask()
+        : worker_( static_cast< GeneratorPass * >( 0 ) ),
+          wm_( static_cast< const WorldModel * >( 0 ) ),
+          receiver_( static_cast< const Receiver * >( 0 ) )
+      {
+          type_count_[0] = type_count_[1] = type_count_[2] = 0;
+      }
+
+    void run()
+      {
+          worker_->createReceiverCourses( *wm_, *receiver_, type_count_ );
+      }
+};
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -361,10 +411,25 @@ GeneratorPass::GeneratorPass()
       M_total_count( 0 ),
       M_pass_type( ActPass::UNKNOWN ),
       M_passer( static_cast< AbstractPlayerObject * >( 0 ) ),
-      M_start_time( -1, 0 )
+      M_start_time( -1, 0 ),
+#ifdef USE_OPPONENT_REACH_FILTER
+      M_use_opponent_filter( true ),
+#else
+      M_use_opponent_filter( false ),
+#endif
+#ifdef USE_OPPONENT_GRID
+      M_use_opponent_grid( true ),
+#else
+      M_use_opponent_grid( false ),
+#endif
+      M_use_intercept_probability( false ),
+      M_ball_trajectory_step( -1 )
 {
     M_receiver_candidates.reserve( 11 );
     M_opponents.reserve( 16 );
+    M_opponent_inertia_x.reserve( 16 * ( MAX_TABLE_STEP + 1 ) );
+    M_opponent_inertia_y.reserve( 16 * ( MAX_TABLE_STEP + 1 ) );
+    M_opponent_reach_dist2.reserve( 16 * ( MAX_TABLE_STEP + 1 ) );
     for ( int i = 0; i < 11; ++i )
     {
         M_direct_pass[i].reserve( 2 );
@@ -387,6 +452,23 @@ GeneratorPass::instance()
     return s_instance;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+GeneratorPass::setThreadSize( const size_t size )
+{
+    if ( size > 1 )
+    {
+        M_worker_pool = boost::shared_ptr< ActionChainWorkerPool >( new ActionChainWorkerPool( size ) );
+    }
+    else
+    {
+        M_worker_pool.reset();
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -401,6 +483,21 @@ GeneratorPass::clear()
     M_first_point.invalidate();
     M_receiver_candidates.clear();
     M_opponents.clear();
+    M_opponent_inertia_x.clear();
+    M_opponent_inertia_y.clear();
+    M_opponent_reach_dist2.clear();
+    M_ball_trajectory_step = -1;
+    clearCourses();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+GeneratorPass::clearCourses()
+{
+    M_total_count = 0;
     M_direct_size = M_leading_size = M_through_size = 0;
     for ( int i = 0; i < 11; ++i )
     {
@@ -456,6 +553,14 @@ GeneratorPass::generate( const WorldModel & wm )
     }
 
     updateOpponents( wm );
+    updateLimits();
+
+    M_use_intercept_probability = ( Options::i().passInterceptProbability()
+                                    && InterceptProbability::i().isValid() );
+
+#ifdef DEBUG_PROFILE_OPPONENT_FILTER
+    benchmarkOpponentFilter( wm );
+#endif
 
     createCourses( wm );
 
@@ -879,6 +984,88 @@ GeneratorPass::updateOpponents( const WorldModel & wm )
                       o.bonus_distance_ );
 #endif
     }
+
+    if ( M_use_opponent_filter )
+    {
+        updateOpponentTable();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief compute the limits of the pass courses.
+  They depend only on ServerParam, but are not function-local statics,
+  because the courses are created by the worker threads.
+ */
+void
+GeneratorPass::updateLimits()
+{
+    const ServerParam & SP = ServerParam::i();
+
+    const double max_pass_dist = inertia_final_distance( SP.ballSpeedMax(),
+                                                         SP.ballDecay() );
+
+    M_limits.min_direct_pass_dist_ = SP.defaultKickableArea() * 2.2;
+    M_limits.max_direct_pass_dist_ = 0.8 * max_pass_dist;
+    M_limits.max_direct_receive_ball_speed_
+        = SP.ballSpeedMax() * std::pow( SP.ballDecay(), DIRECT_PASS_MIN_RECEIVE_STEP );
+
+    M_limits.max_leading_pass_dist_ = 0.8 * max_pass_dist;
+    M_limits.max_leading_receive_ball_speed_
+        = SP.ballSpeedMax() * std::pow( SP.ballDecay(), LEADING_PASS_MIN_RECEIVE_STEP );
+
+    M_limits.max_through_pass_dist_ = 0.9 * max_pass_dist;
+    M_limits.max_through_receive_ball_speed_
+        = SP.ballSpeedMax() * std::pow( SP.ballDecay(), THROUGH_PASS_MIN_RECEIVE_STEP );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the opponent table for the reach filter.
+  The reach distance is the upper bound of the distance that the
+  opponent can be regarded as reachable in getOpponentSafetyLevel().
+  If the ball is out of this distance, the step is always skipped
+  there. Then, only the remaining steps have to be checked precisely.
+ */
+void
+GeneratorPass::updateOpponentTable()
+{
+    static const double DIST_BUF = 0.01; // buffer for the rounding error of the ball trajectory
+
+    const ServerParam & SP = ServerParam::i();
+    const size_t table_size = M_opponents.size() * ( MAX_TABLE_STEP + 1 );
+
+    M_opponent_inertia_x.resize( table_size );
+    M_opponent_inertia_y.resize( table_size );
+    M_opponent_reach_dist2.resize( table_size );
+
+    size_t index = 0;
+    for ( OpponentCont::const_iterator o = M_opponents.begin(),
+              o_end = M_opponents.end();
+          o != o_end;
+          ++o )
+    {
+        const AbstractPlayerObject * pl = o->player_;
+        const PlayerType * ptype = pl->playerTypePtr();
+
+        // maximum control area, including the goalie catch and the tackle extension.
+        // 0.5 is the maximum distance buffer subtracted from the dash distance.
+        const double max_control_area = std::max( ptype->kickableArea(),
+                                                  std::max( SP.catchableArea() + 0.1,
+                                                            SP.tackleDist() - 0.2 ) );
+        const double reach_buf = max_control_area + 0.5 + DIST_BUF;
+        const int pos_count = std::min( pl->posCount(), 5 );
+
+        for ( int step = 0; step <= MAX_TABLE_STEP; ++step, ++index )
+        {
+            const Vector2D pos = ptype->inertiaPoint( o->pos_, o->vel_, step );
+            const double reach_dist = ptype->realSpeedMax() * ( step + pos_count ) + reach_buf;
+
+            M_opponent_inertia_x[index] = pos.x;
+            M_opponent_inertia_y[index] = pos.y;
+            M_opponent_reach_dist2[index] = std::pow( reach_dist, 2 );
+        }
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -888,6 +1075,18 @@ GeneratorPass::updateOpponents( const WorldModel & wm )
 void
 GeneratorPass::createCourses( const WorldModel & wm )
 {
+#ifdef USE_FILTER
+    // the workers never fill M_courses, so the parallel mode is
+    // available only if the courses are selected from the buckets.
+    if ( M_worker_pool
+         && M_receiver_candidates.size() > 1
+         && ! dlog.isEnabled( Logger::LEVEL_ANY ) )
+    {
+        createCoursesParallel( wm );
+        return;
+    }
+#endif
+
     const ReceiverCont::iterator end = M_receiver_candidates.end();
 
     M_pass_type = ActPass::DIRECT;
@@ -921,6 +1120,193 @@ GeneratorPass::createCourses( const WorldModel & wm )
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the courses for each receiver on the worker threads.
+  The result is same as the single thread mode including the index of
+  each course.
+ */
+void
+GeneratorPass::createCoursesParallel( const WorldModel & wm )
+{
+    const size_t size = M_receiver_candidates.size();
+
+    while ( M_workers.size() < size )
+    {
+        M_workers.push_back( boost::shared_ptr< GeneratorPass >( new GeneratorPass() ) );
+        M_tasks.push_back( boost::shared_ptr< CourseTask >( new CourseTask() ) );
+    }
+    M_task_ptrs.resize( size );
+
+    for ( size_t i = 0; i < size; ++i )
+    {
+        M_workers[i]->copyInput( *this );
+        M_tasks[i]->worker_ = M_workers[i].get();
+        M_tasks[i]->wm_ = &wm;
+        M_tasks[i]->receiver_ = &M_receiver_candidates[i];
+        M_task_ptrs[i] = M_tasks[i].get();
+    }
+
+    M_worker_pool->run( &M_task_ptrs[0], size );
+
+    //
+    // merge the buckets in the order of the single thread mode,
+    // that is, the pass type major and the receiver minor order.
+    // the index of each course is renumbered by the same order.
+    //
+    std::vector< CooperativeAction::Ptr > * buckets[3] = { M_direct_pass,
+                                                           M_leading_pass,
+                                                           M_through_pass };
+    for ( int t = 0; t < 3; ++t )
+    {
+        for ( size_t i = 0; i < size; ++i )
+        {
+            const CourseTask & task = *M_tasks[i];
+            GeneratorPass & worker = *task.worker_;
+
+            int local_offset = 0;
+            for ( int k = 0; k < t; ++k )
+            {
+                local_offset += task.type_count_[k];
+            }
+
+            const int unum = task.receiver_->player_->unum();
+            if ( 1 <= unum && unum <= 11 )
+            {
+                std::vector< CooperativeAction::Ptr > * worker_buckets[3] = { worker.M_direct_pass,
+                                                                              worker.M_leading_pass,
+                                                                              worker.M_through_pass };
+                const std::vector< CooperativeAction::Ptr > & src = worker_buckets[t][unum - 1];
+                std::vector< CooperativeAction::Ptr > & dst = buckets[t][unum - 1];
+
+                for ( std::vector< CooperativeAction::Ptr >::const_iterator it = src.begin(), end = src.end();
+                      it != end;
+                      ++it )
+                {
+                    (*it)->setIndex( (*it)->index() - local_offset + M_total_count );
+                    dst.push_back( *it );
+                }
+            }
+
+            M_total_count += task.type_count_[t];
+        }
+    }
+
+    for ( size_t i = 0; i < size; ++i )
+    {
+        GeneratorPass & worker = *M_workers[i];
+        M_direct_size += worker.M_direct_size;
+        M_leading_size += worker.M_leading_size;
+        M_through_size += worker.M_through_size;
+        worker.clearCourses();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief copy the input data of the course creation
+ */
+void
+GeneratorPass::copyInput( const GeneratorPass & src )
+{
+    M_passer = src.M_passer;
+    M_start_time = src.M_start_time;
+    M_first_point = src.M_first_point;
+    M_limits = src.M_limits;
+    M_receiver_candidates = src.M_receiver_candidates;
+    M_opponents = src.M_opponents;
+    M_use_opponent_filter = src.M_use_opponent_filter;
+    M_opponent_inertia_x = src.M_opponent_inertia_x;
+    M_opponent_inertia_y = src.M_opponent_inertia_y;
+    M_opponent_reach_dist2 = src.M_opponent_reach_dist2;
+    M_use_opponent_grid = src.M_use_opponent_grid;
+    M_use_intercept_probability = src.M_use_intercept_probability;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create all types of courses for one receiver.
+  \param type_count the number of checked courses for each pass type
+ */
+void
+GeneratorPass::createReceiverCourses( const WorldModel & wm,
+                                      const Receiver & receiver,
+                                      int * type_count )
+{
+    clearCourses();
+
+    M_pass_type = ActPass::DIRECT;
+    createDirectPass( wm, receiver );
+    type_count[0] = M_total_count;
+
+    if ( wm.ourStaminaCapacity( receiver.player_->unum() ) > 1.0 )
+    {
+        M_pass_type = ActPass::LEADING;
+        createLeadingPass( wm, receiver );
+    }
+    type_count[1] = M_total_count - type_count[0];
+
+    if ( wm.ourStaminaCapacity( receiver.player_->unum() ) > 1.0 )
+    {
+        M_pass_type = ActPass::THROUGH;
+        createThroughPass( wm, receiver );
+    }
+    type_count[2] = M_total_count - type_count[0] - type_count[1];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief compare the elapsed time of createCourses() with and without
+  the opponent reach filter. The created courses are cleared after the
+  measurement.
+ */
+void
+GeneratorPass::benchmarkOpponentFilter( const WorldModel & wm )
+{
+    const bool use_filter = M_use_opponent_filter;
+
+    if ( M_opponent_reach_dist2.empty() )
+    {
+        updateOpponentTable();
+    }
+
+    std::vector< int > levels[2];
+    double elapsed[2];
+
+    for ( int i = 0; i < 2; ++i )
+    {
+        M_use_opponent_filter = ( i == 1 );
+
+        Timer timer;
+        createCourses( wm );
+        elapsed[i] = timer.elapsedReal();
+
+        for ( int unum = 0; unum < 11; ++unum )
+        {
+            const std::vector< CooperativeAction::Ptr > * passes[3] = { &M_direct_pass[unum],
+                                                                        &M_leading_pass[unum],
+                                                                        &M_through_pass[unum] };
+            for ( int t = 0; t < 3; ++t )
+            {
+                for ( std::vector< CooperativeAction::Ptr >::const_iterator it = passes[t]->begin(),
+                          end = passes[t]->end();
+                      it != end;
+                      ++it )
+                {
+                    levels[i].push_back( (*it)->safetyLevel() );
+                }
+            }
+        }
+
+        clearCourses();
+    }
+
+    M_use_opponent_filter = use_filter;
+
+    print_opponent_filter_benchmark( "GeneratorPass", Logger::PASS, wm,
+                                     elapsed, levels[1].size(), levels[0] == levels[1] );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -929,19 +1315,14 @@ void
 GeneratorPass::createDirectPass( const WorldModel & wm,
                                  const Receiver & receiver )
 {
-    static const int MIN_RECEIVE_STEP = 3;
+    static const int MIN_RECEIVE_STEP = DIRECT_PASS_MIN_RECEIVE_STEP;
 #ifdef CREATE_SEVERAL_CANDIDATES_ON_SAME_POINT
     static const int MAX_RECEIVE_STEP = 15; // Magic Number
 #endif
 
-    static const double MIN_DIRECT_PASS_DIST
-        = ServerParam::i().defaultKickableArea() * 2.2;
-    static const double MAX_DIRECT_PASS_DIST
-        = 0.8 * inertia_final_distance( ServerParam::i().ballSpeedMax(),
-                                        ServerParam::i().ballDecay() );
-    static const double MAX_RECEIVE_BALL_SPEED
-        = ServerParam::i().ballSpeedMax()
-        * std::pow( ServerParam::i().ballDecay(), MIN_RECEIVE_STEP );
+    const double MIN_DIRECT_PASS_DIST = M_limits.min_direct_pass_dist_;
+    const double MAX_DIRECT_PASS_DIST = M_limits.max_direct_pass_dist_;
+    const double MAX_RECEIVE_BALL_SPEED = M_limits.max_direct_receive_ball_speed_;
 
     const ServerParam & SP = ServerParam::i();
 
@@ -1067,20 +1448,16 @@ void
 GeneratorPass::createLeadingPass( const WorldModel & wm,
                                   const Receiver & receiver )
 {
-    static const double OUR_GOAL_DIST_THR2 = std::pow( 16.0, 2 );
+    static const double OUR_GOAL_DIST_THR2 = 16.0 * 16.0;
 
-    static const int MIN_RECEIVE_STEP = 4;
+    static const int MIN_RECEIVE_STEP = LEADING_PASS_MIN_RECEIVE_STEP;
 #ifdef CREATE_SEVERAL_CANDIDATES_ON_SAME_POINT
     static const int MAX_RECEIVE_STEP = 20;
 #endif
 
     static const double MIN_LEADING_PASS_DIST = 3.0;
-    static const double MAX_LEADING_PASS_DIST
-        = 0.8 * inertia_final_distance( ServerParam::i().ballSpeedMax(),
-                                        ServerParam::i().ballDecay() );
-    static const double MAX_RECEIVE_BALL_SPEED
-        = ServerParam::i().ballSpeedMax()
-        * std::pow( ServerParam::i().ballDecay(), MIN_RECEIVE_STEP );
+    const double MAX_LEADING_PASS_DIST = M_limits.max_leading_pass_dist_;
+    const double MAX_RECEIVE_BALL_SPEED = M_limits.max_leading_receive_ball_speed_;
 
     static const int ANGLE_DIVS = 24;
     static const double ANGLE_STEP = 360.0 / ANGLE_DIVS;
@@ -1278,18 +1655,14 @@ void
 GeneratorPass::createThroughPass( const WorldModel & wm,
                                   const Receiver & receiver )
 {
-    static const int MIN_RECEIVE_STEP = 6;
+    static const int MIN_RECEIVE_STEP = THROUGH_PASS_MIN_RECEIVE_STEP;
 #ifdef CREATE_SEVERAL_CANDIDATES_ON_SAME_POINT
     static const int MAX_RECEIVE_STEP = 35;
 #endif
 
     static const double MIN_THROUGH_PASS_DIST = 5.0;
-    static const double MAX_THROUGH_PASS_DIST
-        = 0.9 * inertia_final_distance( ServerParam::i().ballSpeedMax(),
-                                        ServerParam::i().ballDecay() );
-    static const double MAX_RECEIVE_BALL_SPEED
-        = ServerParam::i().ballSpeedMax()
-        * std::pow( ServerParam::i().ballDecay(), MIN_RECEIVE_STEP );
+    const double MAX_THROUGH_PASS_DIST = M_limits.max_through_pass_dist_;
+    const double MAX_RECEIVE_BALL_SPEED = M_limits.max_through_receive_ball_speed_;
 
     static const int ANGLE_DIVS = 14;
     static const double MIN_ANGLE = -40.0;
@@ -1584,13 +1957,13 @@ GeneratorPass::createPassCommon( const WorldModel & wm,
                                  const AngleDeg & ball_move_angle,
                                  const char * description )
 {
-    const ServerParam & SP = ServerParam::i();
+    const BallTrajectoryTable & ball_table = BallTrajectoryTable::i();
 
     for ( int step = min_step; step <= max_step; ++step )
     {
         ++M_total_count;
 
-        const double first_ball_speed = SP.firstBallSpeed( ball_move_dist, step );
+        const double first_ball_speed = ball_table.firstSpeed( ball_move_dist, step );
 
         //#if (defined DEBUG_PRINT_DIRECT_PASS) || (defined DEBUG_PRINT_LEADING_PASS) || (defined DEBUG_PRINT_THROUGH_PASS) || (defined DEBUG_PRINT_FAILED_PASS)
 #ifdef DEBUG_PRINT_COMMON
@@ -1633,7 +2006,7 @@ GeneratorPass::createPassCommon( const WorldModel & wm,
             continue;
         }
 
-        const double receive_ball_speed = first_ball_speed * std::pow( SP.ballDecay(), step );
+        const double receive_ball_speed = ball_table.speedAfter( first_ball_speed, step );
         if ( receive_ball_speed < min_receive_ball_speed )
         {
 #ifdef DEBUG_PRINT_FAILED_PASS
@@ -1731,7 +2104,7 @@ GeneratorPass::createPassCommon( const WorldModel & wm,
                           M_first_point.x, M_first_point.y,
                           receive_point.x, receive_point.y,
                           first_ball_speed,
-                          first_ball_speed * std::pow( ServerParam::i().ballDecay(), step ),
+                          ball_table.speedAfter( first_ball_speed, step ),
                           ball_move_angle.degree() );
             debug_paint_pass( M_total_count, receive_point, safety_level, "#0F0");
 #endif
@@ -1749,7 +2122,7 @@ GeneratorPass::createPassCommon( const WorldModel & wm,
                           M_first_point.x, M_first_point.y,
                           receive_point.x, receive_point.y,
                           first_ball_speed,
-                          first_ball_speed * std::pow( ServerParam::i().ballDecay(), step ),
+                          ball_table.speedAfter( first_ball_speed, step ),
                           ball_move_angle.degree() );
             debug_paint_pass( M_total_count, receive_point, safety_level, "#F00" );
         }
@@ -1903,15 +2276,72 @@ GeneratorPass::getSafetyLevel( const WorldModel & wm,
                   n_kick, ball_move_step );
 #endif
 
+    //
+    // create the ball trajectory shared by all opponents
+    //
+    M_ball_trajectory_step = -1;
+    if ( M_use_opponent_filter
+         && ball_move_step <= MAX_TABLE_STEP
+         && ! M_opponent_reach_dist2.empty() )
+    {
+        const double ball_decay = ServerParam::i().ballDecay();
+        Vector2D ball_pos = first_ball_pos;
+        Vector2D ball_vel = first_ball_vel;
+
+        M_ball_trajectory_x[0] = ball_pos.x;
+        M_ball_trajectory_y[0] = ball_pos.y;
+        for ( int step = 1; step <= ball_move_step; ++step )
+        {
+            ball_pos += ball_vel;
+            ball_vel *= ball_decay;
+            M_ball_trajectory_x[step] = ball_pos.x;
+            M_ball_trajectory_y[step] = ball_pos.y;
+        }
+        M_ball_trajectory_step = ball_move_step;
+    }
+
+    //
+    // broad phase by the opponent grid.
+    // the opponents out of the capsule never satisfy the reach condition
+    // of the opponent table, so they are always Safe.
+    //
+    const OpponentGrid & grid = FieldAnalyzer::i().opponentGrid();
+    const bool use_grid = ( M_use_opponent_grid
+                            && grid.isValid( wm ) );
+    OpponentGrid::Mask candidates = 0;
+    if ( use_grid )
+    {
+        const ServerParam & SP = ServerParam::i();
+        const double max_control_area = std::max( grid.maxKickableArea(),
+                                                  std::max( SP.catchableArea() + 0.1,
+                                                            SP.tackleDist() - 0.2 ) );
+        candidates = grid.query( first_ball_pos,
+                                 BallTrajectoryTable::i().inertiaPoint( first_ball_pos,
+                                                                        first_ball_vel,
+                                                                        ball_move_step ),
+                                 ball_move_step,
+                                 5,
+                                 max_control_area + 0.5 + 0.01 );
+    }
+
     CooperativeAction::SafetyLevel result = CooperativeAction::Safe;
+    int skip_count = 0;
 
     for ( OpponentCont::const_iterator o = M_opponents.begin(),
               o_end = M_opponents.end();
           o != o_end;
           ++o )
     {
+        if ( use_grid
+             && ! grid.contains( candidates, static_cast< size_t >( o - M_opponents.begin() ) ) )
+        {
+            ++skip_count;
+            continue;
+        }
+
         CooperativeAction::SafetyLevel level = getOpponentSafetyLevel( wm,
                                                                        *o,
+                                                                       static_cast< size_t >( o - M_opponents.begin() ),
                                                                        first_ball_pos,
                                                                        first_ball_vel,
                                                                        first_ball_speed,
@@ -1929,6 +2359,11 @@ GeneratorPass::getSafetyLevel( const WorldModel & wm,
         }
     }
 
+    if ( use_grid )
+    {
+        grid.addSkipCount( static_cast< int >( M_opponents.size() ), skip_count );
+    }
+
     //return ( 1.0 - failure_prob ) * kick_decay;
     return result;
 }
@@ -1940,6 +2375,7 @@ GeneratorPass::getSafetyLevel( const WorldModel & wm,
 CooperativeAction::SafetyLevel
 GeneratorPass::getOpponentSafetyLevel( const WorldModel & wm,
                                        const Opponent & opponent,
+                                       const size_t opponent_index,
                                        const Vector2D & first_ball_pos,
                                        const Vector2D & first_ball_vel,
                                        const double /*first_ball_speed*/,
@@ -1987,32 +2423,73 @@ GeneratorPass::getOpponentSafetyLevel( const WorldModel & wm,
         min_step = 1;
     }
 
+    //const int max_step = n_kick - 1 + ball_move_step;
+    const int max_step = ball_move_step;
+
+    //
+    // coarse filter by the structure-of-arrays opponent table.
+    // the steps not marked here are always skipped in the loop below.
+    //
+    const double * table_x = static_cast< const double * >( 0 );
+    const double * table_y = static_cast< const double * >( 0 );
+    unsigned char reach_steps[MAX_TABLE_STEP + 1];
+
+    if ( M_ball_trajectory_step >= max_step )
+    {
+        const size_t offset = opponent_index * ( MAX_TABLE_STEP + 1 );
+        table_x = &M_opponent_inertia_x[offset];
+        table_y = &M_opponent_inertia_y[offset];
+
+        if ( mark_opponent_reach_steps( table_x,
+                                        table_y,
+                                        &M_opponent_reach_dist2[offset],
+                                        M_ball_trajectory_x,
+                                        M_ball_trajectory_y,
+                                        min_step, max_step,
+                                        reach_steps ) == 0 )
+        {
+#ifdef DEBUG_PRINT_COMMON
+            dlog.addText( Logger::PASS,
+                          "%d: opponent[%d](%.1f %.1f) never reach (filter).",
+                          M_total_count,
+                          pl->unum(), opponent.pos_.x, opponent.pos_.y );
+#endif
+            return CooperativeAction::Safe;
+        }
+    }
+
     const bool aggressive = ( M_pass_type == ActPass::THROUGH
                               || receive_point.x > 35.0
                               || receive_point.x > wm.offsideLineX() - 3.0 );
 
     CooperativeAction::SafetyLevel result = CooperativeAction::Safe;
 
-    Vector2D ball_pos = inertia_n_step_point( first_ball_pos,
-                                              first_ball_vel,
-                                              min_step - 1,
-                                              SP.ballDecay() );
-    Vector2D ball_vel = first_ball_vel * std::pow( SP.ballDecay(), min_step - 1 );
+    const BallTrajectoryTable & ball_table = BallTrajectoryTable::i();
+    Vector2D ball_pos = ball_table.inertiaPoint( first_ball_pos,
+                                                 first_ball_vel,
+                                                 min_step - 1 );
+    Vector2D ball_vel = first_ball_vel * ball_table.decayPow( min_step - 1 );
 
-    //const int max_step = n_kick - 1 + ball_move_step;
-    const int max_step = ball_move_step;
     for ( int step = min_step; step <= max_step; ++step )
     {
         ball_pos += ball_vel;
         ball_vel *= SP.ballDecay();
 
+        if ( table_x
+             && ! reach_steps[step] )
+        {
+            continue;
+        }
+
         const bool goalie = ( pl->goalie()
                               && ball_pos.x > SP.theirPenaltyAreaLineX()
                               && ball_pos.absY() < SP.penaltyAreaHalfWidth() );
         double control_area = ( goalie
                                 ? SP.catchableArea() + 0.1
                                 : ptype->kickableArea() );
-        const Vector2D opponent_pos = ptype->inertiaPoint( opponent.pos_, opponent.vel_, step );
+        const Vector2D opponent_pos = ( table_x
+                                        ? Vector2D( table_x[step], table_y[step] )
+                                        : ptype->inertiaPoint( opponent.pos_, opponent.vel_, step ) );
         const double ball_dist = opponent_pos.dist( ball_pos );
         double dash_dist = ball_dist;
 
@@ -2126,6 +2603,7 @@ GeneratorPass::getOpponentSafetyLevel( const WorldModel & wm,
         int opponent_step = ( opponent_turn == 0
                               ? opponent_dash
                               : opponent_turn + opponent_dash + 1 );
+        int count_bonus = 0; // reduced step by the accuracy count
         if ( pl->isTackling() )
         {
             opponent_step += 2; // magic number
@@ -2141,12 +2619,13 @@ GeneratorPass::getOpponentSafetyLevel( const WorldModel & wm,
         }
         else if ( aggressive )
         {
-            opponent_step -= bound( 0,
-                                    //static_cast< int >( std::floor( pl->posCount() * 0.5 ) ),
-                                    //static_cast< int >( std::floor( pl->posCount() * 0.7 ) ),
-                                    static_cast< int >( std::floor( pl->posCount() * 0.3 ) ),
-                                    //4 );
-                                    2 );
+            count_bonus = bound( 0,
+                                 //static_cast< int >( std::floor( pl->posCount() * 0.5 ) ),
+                                 //static_cast< int >( std::floor( pl->posCount() * 0.7 ) ),
+                                 static_cast< int >( std::floor( pl->posCount() * 0.3 ) ),
+                                 //4 );
+                                 2 );
+            opponent_step -= count_bonus;
             if ( ball_pos.x > opponent_pos.x + 15.0 )
             {
                 if ( opponent_step > 15 ) opponent_step += 1;
@@ -2155,14 +2634,29 @@ GeneratorPass::getOpponentSafetyLevel( const WorldModel & wm,
         }
         else
         {
-            opponent_step -= bound( 0,
-                                    static_cast< int >( std::floor( pl->posCount() * 0.7 ) ),
-                                    5 );
+            count_bonus = bound( 0,
+                                 static_cast< int >( std::floor( pl->posCount() * 0.7 ) ),
+                                 5 );
+            opponent_step -= count_bonus;
         }
 
         CooperativeAction::SafetyLevel level = CooperativeAction::Safe;
 
-        if ( opponent_step <= std::max( 0, step - 3 ) ) level = CooperativeAction::Failure;
+        if ( M_use_intercept_probability )
+        {
+            // the table takes the accuracy count into account.
+            const int situation
+                = InterceptProbability::get_situation( ( pl->body() - ( ball_pos - opponent_pos ).th() ).abs(),
+                                                       ball_vel.r(),
+                                                       ( ball_vel.th() - ( opponent_pos - ball_pos ).th() ).abs(),
+                                                       ball_dist );
+            level = get_intercept_probability_level( InterceptProbability::i().probability( InterceptProbability::OPPONENT,
+                                                                                            pl->posCount(),
+                                                                                            opponent_step + count_bonus,
+                                                                                            situation,
+                                                                                            step ) );
+        }
+        else if ( opponent_step <= std::max( 0, step - 3 ) ) level = CooperativeAction::Failure;
         else if ( opponent_step <= std::max( 0, step - 2 ) ) level = CooperativeAction::Failure;
         else if ( opponent_step <= std::max( 0, step - 1 ) ) level = CooperativeAction::Failure;
         else if ( opponent_step <= step ) level = CooperativeAction::Failure;
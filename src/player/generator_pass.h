@@ -32,11 +32,14 @@
 #define GENRATOR_PASS_H
 
 #include "act_pass.h"
+#include "action_chain_worker_pool.h"
 
 #include <rcsc/player/abstract_player_object.h>
 #include <rcsc/geom/vector_2d.h>
 #include <rcsc/game_time.h>
 
+#include <boost/shared_ptr.hpp>
+
 #include <vector>
 
 namespace rcsc {
@@ -86,6 +89,25 @@ public:
 
 private:
 
+    enum {
+        MAX_TABLE_STEP = 50 //!< the maximum ball move step stored in the opponent table
+    };
+
+    struct CourseTask;
+
+    /*!
+      \brief the limits of the pass courses that depend only on ServerParam
+     */
+    struct Limits {
+        double min_direct_pass_dist_;
+        double max_direct_pass_dist_;
+        double max_direct_receive_ball_speed_;
+        double max_leading_pass_dist_;
+        double max_leading_receive_ball_speed_;
+        double max_through_pass_dist_;
+        double max_through_receive_ball_speed_;
+    };
+
     rcsc::GameTime M_update_time;
     int M_total_count;
     int M_pass_type;
@@ -93,10 +115,29 @@ private:
     const rcsc::AbstractPlayerObject * M_passer; //!< estimated passer player
     rcsc::GameTime M_start_time; //!< pass action start time
     rcsc::Vector2D M_first_point; //!< first ball point
+    Limits M_limits; //!< updated in generate() before the courses are created
 
     ReceiverCont M_receiver_candidates;
     OpponentCont M_opponents;
 
+    //
+    // structure-of-arrays opponent table used by the reach filter.
+    // index = opponent_index * ( MAX_TABLE_STEP + 1 ) + step
+    //
+    bool M_use_opponent_filter;
+    std::vector< double > M_opponent_inertia_x; //!< opponent position after n steps
+    std::vector< double > M_opponent_inertia_y;
+    std::vector< double > M_opponent_reach_dist2; //!< squared distance that the opponent may reach the ball
+
+    bool M_use_opponent_grid; //!< if true, the opponents are pruned by FieldAnalyzer::opponentGrid()
+
+    bool M_use_intercept_probability; //!< if true, the opponent safety is evaluated by InterceptProbability
+
+    //! ball trajectory of the current pass candidate. index = step
+    double M_ball_trajectory_x[MAX_TABLE_STEP + 1];
+    double M_ball_trajectory_y[MAX_TABLE_STEP + 1];
+    int M_ball_trajectory_step; //!< the last step of the ball trajectory. -1 means no trajectory.
+
     int M_direct_size;
     int M_leading_size;
     int M_through_size;
@@ -106,6 +147,16 @@ private:
     std::vector< CooperativeAction::Ptr > M_through_pass[11];
     std::vector< CooperativeAction::Ptr > M_courses;
 
+    //
+    // parallel course creation.
+    // each receiver is processed by its own worker instance that has
+    // the copy of the input data, and the results are merged in the
+    // same order as the single thread mode.
+    //
+    boost::shared_ptr< ActionChainWorkerPool > M_worker_pool; //!< null if single thread
+    std::vector< boost::shared_ptr< GeneratorPass > > M_workers;
+    std::vector< boost::shared_ptr< CourseTask > > M_tasks;
+    std::vector< ActionChainWorkerPool::Task * > M_task_ptrs;
 
     // private for singleton
     GeneratorPass();
@@ -119,6 +170,12 @@ public:
     static
     GeneratorPass & instance();
 
+    /*!
+      \brief set the number of threads used by the course creation
+      \param size the number of threads. 1 means the single thread mode.
+     */
+    void setThreadSize( const size_t size );
+
     void generate( const rcsc::WorldModel & wm );
 
     const std::vector< CooperativeAction::Ptr > & courses( const rcsc::WorldModel & wm )
@@ -130,6 +187,7 @@ public:
 private:
 
     void clear();
+    void clearCourses();
 
     /*!
       \brief estimate passer player and set it to M_passer.
@@ -139,8 +197,16 @@ private:
 
     void updateReceivers( const rcsc::WorldModel & wm );
     void updateOpponents( const rcsc::WorldModel & wm );
+    void updateOpponentTable();
+    void updateLimits();
 
     void createCourses( const rcsc::WorldModel & wm );
+    void createCoursesParallel( const rcsc::WorldModel & wm );
+    void copyInput( const GeneratorPass & src );
+    void createReceiverCourses( const rcsc::WorldModel & wm,
+                                const Receiver & receiver,
+                                int * type_count );
+    void benchmarkOpponentFilter( const rcsc::WorldModel & wm );
 
     void createDirectPass( const rcsc::WorldModel & wm ,
                            const Receiver & receiver );
@@ -179,6 +245,7 @@ private:
                                                    const int ball_move_step );
     CooperativeAction::SafetyLevel getOpponentSafetyLevel( const rcsc::WorldModel & wm,
                                                            const Opponent & opponent,
+                                                           const size_t opponent_index,
                                                            const rcsc::Vector2D & first_ball_pos,
                                                            const rcsc::Vector2D & first_ball_vel,
                                                            const double first_ball_speed,
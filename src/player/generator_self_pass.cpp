@@ -36,6 +36,7 @@
 #include "generator_self_pass.h"
 
 #include "act_dribble.h"
+#include "ball_trajectory_table.h"
 #include "field_analyzer.h"
 
 #include <rcsc/action/kick_table.h>
@@ -355,8 +356,8 @@ GeneratorSelfPass::createCourses( const WorldModel & wm )
                           n_turn, n_dash,
                           receive_pos.x, receive_pos.y );
 #endif
-            const double first_speed = SP.firstBallSpeed( ball_pos.dist( receive_pos ),
-                                                          n_kick + n_turn + n_dash );
+            const double first_speed = BallTrajectoryTable::i().firstSpeed( ball_pos.dist( receive_pos ),
+                                                                            n_kick + n_turn + n_dash );
             const Vector2D first_vel = ( receive_pos - ball_pos ).setLengthVector( first_speed );
 
             CooperativeAction::SafetyLevel safety_level = getSafetyLevel( wm,
@@ -637,9 +638,8 @@ GeneratorSelfPass::canKickOneStep( const WorldModel & wm,
     //
     // check kick possibility
     //
-    double first_speed = calc_first_term_geom_series( ball_pos.dist( receive_pos ),
-                                                      SP.ballDecay(),
-                                                      1 + n_turn + n_dash );
+    double first_speed = BallTrajectoryTable::i().firstSpeed( ball_pos.dist( receive_pos ),
+                                                              1 + n_turn + n_dash );
     Vector2D max_vel = KickTable::calc_max_velocity( target_angle,
                                                      wm.self().kickRate(),
                                                      ball_vel );
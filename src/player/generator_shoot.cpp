@@ -35,7 +35,9 @@
 
 #include "generator_shoot.h"
 
+#include "ball_trajectory_table.h"
 #include "field_analyzer.h"
+#include "opponent_reach_filter.h"
 
 #include <rcsc/action/kick_table.h>
 
@@ -48,7 +50,12 @@
 #include <rcsc/math_util.h>
 #include <rcsc/timer.h>
 
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+
 #define SEARCH_UNTIL_MAX_SPEED_AT_SAME_POINT
+#define USE_OPPONENT_REACH_FILTER
 
 // #define DEBUG_PROFILE
 // #define DEBUG_PRINT
@@ -62,6 +69,9 @@ using namespace rcsc;
 
 namespace {
 
+//! the number of target points on the goal line
+const int DIST_DIVS = 25;
+
 int
 predict_goalie_turn_step( const PlayerType * ptype,
                           const AngleDeg & player_body,
@@ -114,6 +124,11 @@ predict_goalie_turn_step( const PlayerType * ptype,
 
  */
 GeneratorShoot::GeneratorShoot()
+#ifdef USE_OPPONENT_REACH_FILTER
+    : M_use_opponent_filter( true )
+#else
+    : M_use_opponent_filter( false )
+#endif
 {
     M_courses.reserve( 32 );
 
@@ -223,6 +238,111 @@ GeneratorShoot::generate( const WorldModel & wm )
     MSecTimer timer;
 #endif
 
+    updateOpponents( wm );
+
+#ifdef DEBUG_PROFILE_OPPONENT_FILTER
+    benchmarkOpponentFilter( wm );
+#endif
+
+    createCourses( wm );
+
+    evaluateCourses( wm );
+
+
+#ifdef DEBUG_PROFILE
+    dlog.addText( Logger::SHOOT,
+                  __FILE__": PROFILE %d/%d. elapsed=%.3f [ms]",
+                  (int)M_courses.size(),
+                  DIST_DIVS,
+                  timer.elapsedReal() );
+#endif
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+GeneratorShoot::updateOpponents( const WorldModel & wm )
+{
+    static const double DIST_BUF = 0.01; // buffer for the rounding error of the ball trajectory
+
+    const ServerParam & SP = ServerParam::i();
+
+    const double opponent_x_thr = SP.theirPenaltyAreaLineX() - 30.0;
+    const double opponent_y_thr = SP.penaltyAreaHalfWidth();
+
+    M_opponents.clear();
+
+    for ( PlayerObject::Cont::const_iterator o = wm.opponentsFromSelf().begin(),
+              end = wm.opponentsFromSelf().end();
+          o != end;
+          ++o )
+    {
+        if ( (*o)->isTackling() ) continue;
+        if ( (*o)->pos().x < opponent_x_thr ) continue;
+        if ( (*o)->pos().absY() > opponent_y_thr ) continue;
+
+        M_opponents.push_back( *o );
+    }
+
+    const size_t table_size = M_opponents.size() * ( MAX_TABLE_STEP + 1 );
+
+    M_opponent_inertia_x.resize( table_size );
+    M_opponent_inertia_y.resize( table_size );
+    M_goalie_reach_dist2.resize( table_size );
+    M_opponent_reach_dist2.resize( table_size );
+
+    size_t index = 0;
+    for ( std::vector< const PlayerObject * >::const_iterator o = M_opponents.begin(),
+              end = M_opponents.end();
+          o != end;
+          ++o )
+    {
+        const PlayerType * ptype = (*o)->playerTypePtr();
+
+        //
+        // the radius that the player may reach the ball.
+        // the dash distance never exceeds realSpeedMax() per cycle, so the
+        // balls out of the radius are skipped in the original step loops.
+        //
+        // goalie: n_dash > cycle + 2 + posCount is skipped.
+        // the dash distance is reduced by the control area, 0.2 and the seen noise.
+        //
+        const double goalie_buf = std::max( ptype->reliableCatchableDist(), ptype->kickableArea() )
+            + 0.2
+            + (*o)->distFromSelf() * 0.04
+            + DIST_BUF;
+        //
+        // field player: n_dash > cycle + posCount is skipped.
+        // the dash distance is reduced by the kickable area at most.
+        //
+        const double opponent_buf = ptype->kickableArea() + DIST_BUF;
+
+        for ( int step = 0; step <= MAX_TABLE_STEP; ++step, ++index )
+        {
+            const Vector2D pos = (*o)->inertiaPoint( step );
+
+            M_opponent_inertia_x[index] = pos.x;
+            M_opponent_inertia_y[index] = pos.y;
+            M_goalie_reach_dist2[index]
+                = std::pow( ptype->realSpeedMax() * ( step + 2 + (*o)->posCount() ) + goalie_buf, 2 );
+            M_opponent_reach_dist2[index]
+                = std::pow( ptype->realSpeedMax() * ( step + (*o)->posCount() ) + opponent_buf, 2 );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+GeneratorShoot::createCourses( const WorldModel & wm )
+{
+    const ServerParam & SP = ServerParam::i();
+
     Vector2D goal_l( SP.pitchHalfLength(), -SP.goalHalfWidth() );
     Vector2D goal_r( SP.pitchHalfLength(), +SP.goalHalfWidth() );
     double goal_l_dist = goal_l.dist( M_first_ball_pos );
@@ -248,7 +368,6 @@ GeneratorShoot::generate( const WorldModel & wm )
         goal_r.x = wm.self().pos().x + 1.5;
     }
 
-    const int DIST_DIVS = 25;
     const double dist_step = std::fabs( goal_l.y - goal_r.y ) / ( DIST_DIVS - 1 );
 
 #ifdef DEBUG_PRINT
@@ -272,19 +391,53 @@ GeneratorShoot::generate( const WorldModel & wm )
 #endif
         createShoot( wm, target_point );
     }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief compare the elapsed time of createCourses() with and without
+  the opponent reach filter. The created courses are cleared after the
+  measurement.
+ */
+void
+GeneratorShoot::benchmarkOpponentFilter( const WorldModel & wm )
+{
+    const bool use_filter = M_use_opponent_filter;
 
+    Container courses[2];
+    double elapsed[2];
 
-    evaluateCourses( wm );
+    for ( int i = 0; i < 2; ++i )
+    {
+        M_use_opponent_filter = ( i == 1 );
 
+        Timer timer;
+        createCourses( wm );
+        elapsed[i] = timer.elapsedReal();
 
-#ifdef DEBUG_PROFILE
-    dlog.addText( Logger::SHOOT,
-                  __FILE__": PROFILE %d/%d. elapsed=%.3f [ms]",
-                  (int)M_courses.size(),
-                  DIST_DIVS,
-                  timer.elapsedReal() );
-#endif
+        courses[i] = M_courses;
+        clear();
+    }
+
+    M_use_opponent_filter = use_filter;
+
+    bool same = ( courses[0].size() == courses[1].size() );
+    for ( size_t i = 0; same && i < courses[0].size(); ++i )
+    {
+        const Course & c0 = courses[0][i];
+        const Course & c1 = courses[1][i];
+        same = ( c0.index_ == c1.index_
+                 && c0.target_point_.x == c1.target_point_.x
+                 && c0.target_point_.y == c1.target_point_.y
+                 && c0.first_ball_speed_ == c1.first_ball_speed_
+                 && c0.ball_reach_step_ == c1.ball_reach_step_
+                 && c0.goalie_never_reach_ == c1.goalie_never_reach_
+                 && c0.opponent_never_reach_ == c1.opponent_never_reach_
+                 && c0.kick_step_ == c1.kick_step_ );
+    }
 
+    print_opponent_filter_benchmark( "GeneratorShoot", Logger::SHOOT, wm,
+                                     elapsed, courses[1].size(), same );
 }
 
 /*-------------------------------------------------------------------*/
@@ -489,27 +642,57 @@ GeneratorShoot::createShoot( const WorldModel & wm,
 
     // estimate opponent interception
 
-    const double opponent_x_thr = SP.theirPenaltyAreaLineX() - 30.0;
-    const double opponent_y_thr = SP.penaltyAreaHalfWidth();
+    //
+    // the ball trajectory shared by all opponents.
+    // the steps beyond the table are checked without the filter.
+    //
+    const int last_step = course.ball_reach_step_ - 1;
+    const bool use_filter = ( M_use_opponent_filter
+                              && last_step <= MAX_TABLE_STEP );
+    if ( use_filter )
+    {
+        const BallTrajectoryTable & ball_table = BallTrajectoryTable::i();
+        for ( int step = 1; step <= last_step; ++step )
+        {
+            const Vector2D ball_pos = ball_table.inertiaPoint( M_first_ball_pos,
+                                                               course.first_ball_vel_,
+                                                               step );
+            M_ball_trajectory_x[step] = ball_pos.x;
+            M_ball_trajectory_y[step] = ball_pos.y;
+        }
+    }
 
-    for ( PlayerObject::Cont::const_iterator o = wm.opponentsFromSelf().begin(),
-              end = wm.opponentsFromSelf().end();
-          o != end;
-          ++o )
+    unsigned char goalie_reach_steps[MAX_TABLE_STEP + 1];
+    unsigned char opponent_reach_steps[MAX_TABLE_STEP + 1];
+
+    for ( size_t i = 0; i < M_opponents.size(); ++i )
     {
-        if ( (*o)->isTackling() ) continue;
-        if ( (*o)->pos().x < opponent_x_thr ) continue;
-        if ( (*o)->pos().absY() > opponent_y_thr ) continue;
+        const PlayerObject * o = M_opponents[i];
 
         // behind of shoot course
-        if ( ( ball_move_angle - (*o)->angleFromSelf() ).abs() > 90.0 )
+        if ( ( ball_move_angle - o->angleFromSelf() ).abs() > 90.0 )
         {
             continue;
         }
 
-        if ( (*o)->goalie() )
+        const size_t offset = i * ( MAX_TABLE_STEP + 1 );
+
+        if ( o->goalie() )
         {
-            if ( maybeGoalieCatch( *o, course ) )
+            const unsigned char * reach_steps = static_cast< const unsigned char * >( 0 );
+            if ( use_filter )
+            {
+                mark_opponent_reach_steps( &M_opponent_inertia_x[offset],
+                                           &M_opponent_inertia_y[offset],
+                                           &M_goalie_reach_dist2[offset],
+                                           M_ball_trajectory_x,
+                                           M_ball_trajectory_y,
+                                           1, last_step,
+                                           goalie_reach_steps );
+                reach_steps = goalie_reach_steps;
+            }
+
+            if ( maybeGoalieCatch( o, course, reach_steps ) )
             {
 #ifdef DEBUG_PRINT
                 dlog.addText( Logger::SHOOT,
@@ -525,10 +708,23 @@ GeneratorShoot::createShoot( const WorldModel & wm,
         // check field player
         //
 
-        if ( (*o)->posCount() > 10 ) continue;
-        if ( (*o)->isGhost() && (*o)->posCount() > 5 ) continue;
+        if ( o->posCount() > 10 ) continue;
+        if ( o->isGhost() && o->posCount() > 5 ) continue;
 
-        if ( opponentCanReach( *o, course ) )
+        const unsigned char * reach_steps = static_cast< const unsigned char * >( 0 );
+        if ( use_filter )
+        {
+            mark_opponent_reach_steps( &M_opponent_inertia_x[offset],
+                                       &M_opponent_inertia_y[offset],
+                                       &M_opponent_reach_dist2[offset],
+                                       M_ball_trajectory_x,
+                                       M_ball_trajectory_y,
+                                       1, last_step,
+                                       opponent_reach_steps );
+            reach_steps = opponent_reach_steps;
+        }
+
+        if ( opponentCanReach( o, course, reach_steps ) )
         {
 #ifdef DEBUG_PRINT
                 dlog.addText( Logger::SHOOT,
@@ -549,7 +745,8 @@ GeneratorShoot::createShoot( const WorldModel & wm,
  */
 bool
 GeneratorShoot::maybeGoalieCatch( const PlayerObject * goalie,
-                                  Course & course )
+                                  Course & course,
+                                  const unsigned char * reach_steps )
 {
     static const Rect2D penalty_area( Vector2D( ServerParam::i().theirPenaltyAreaLineX(),
                                                 -ServerParam::i().penaltyAreaHalfWidth() ),
@@ -558,6 +755,7 @@ GeneratorShoot::maybeGoalieCatch( const PlayerObject * goalie,
     static const double CONTROL_AREA_BUF = 0.15;  // buffer for kick table
 
     const ServerParam & SP = ServerParam::i();
+    const BallTrajectoryTable & ball_table = BallTrajectoryTable::i();
 
     const PlayerType * ptype = goalie->playerTypePtr();
 
@@ -598,10 +796,9 @@ GeneratorShoot::maybeGoalieCatch( const PlayerObject * goalie,
 
     for ( int cycle = min_cycle; cycle < max_cycle; ++cycle )
     {
-        const Vector2D ball_pos = inertia_n_step_point( M_first_ball_pos,
-                                                        course.first_ball_vel_,
-                                                        cycle,
-                                                        SP.ballDecay() );
+        const Vector2D ball_pos = ball_table.inertiaPoint( M_first_ball_pos,
+                                                           course.first_ball_vel_,
+                                                           cycle );
         if ( ball_pos.x > SP.pitchHalfLength() )
         {
 #ifdef DEBUG_PRINT
@@ -612,6 +809,13 @@ GeneratorShoot::maybeGoalieCatch( const PlayerObject * goalie,
             break;
         }
 
+        if ( reach_steps
+             && ! reach_steps[cycle] )
+        {
+            // out of the reach radius. same as the dash step check below.
+            continue;
+        }
+
         const bool in_penalty_area = penalty_area.contains( ball_pos );
 
         const double control_area = ( in_penalty_area
@@ -735,9 +939,11 @@ GeneratorShoot::maybeGoalieCatch( const PlayerObject * goalie,
  */
 bool
 GeneratorShoot::opponentCanReach( const PlayerObject * opponent,
-                                  Course & course )
+                                  Course & course,
+                                  const unsigned char * reach_steps )
 {
     const ServerParam & SP = ServerParam::i();
+    const BallTrajectoryTable & ball_table = BallTrajectoryTable::i();
 
     const PlayerType * ptype = opponent->playerTypePtr();
     const double control_area = ptype->kickableArea();
@@ -776,10 +982,16 @@ GeneratorShoot::opponentCanReach( const PlayerObject * opponent,
 
     for ( int cycle = min_cycle; cycle < max_cycle; ++cycle )
     {
-        Vector2D ball_pos = inertia_n_step_point( M_first_ball_pos,
-                                                  course.first_ball_vel_,
-                                                  cycle,
-                                                  SP.ballDecay() );
+        if ( reach_steps
+             && ! reach_steps[cycle] )
+        {
+            // out of the reach radius. same as the dash step check below.
+            continue;
+        }
+
+        Vector2D ball_pos = ball_table.inertiaPoint( M_first_ball_pos,
+                                                     course.first_ball_vel_,
+                                                     cycle );
 
         Vector2D inertia_pos = opponent->inertiaPoint( cycle );
         double target_dist = inertia_pos.dist( ball_pos );
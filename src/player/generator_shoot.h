@@ -120,6 +120,10 @@ public:
 
 private:
 
+    enum {
+        MAX_TABLE_STEP = 50 //!< the maximum ball step in the opponent reach tables
+    };
+
     //! search count
     int M_total_count;
 
@@ -129,6 +133,24 @@ private:
     //! cached calculated shoot pathes
     Container M_courses;
 
+    //! if true, the opponent reach tables are used to skip the ball steps
+    bool M_use_opponent_filter;
+
+    //! the opponents checked in this cycle
+    std::vector< const rcsc::PlayerObject * > M_opponents;
+
+    //! opponent inertia points. index = opponent_index * ( MAX_TABLE_STEP + 1 ) + step
+    std::vector< double > M_opponent_inertia_x;
+    std::vector< double > M_opponent_inertia_y;
+    //! squared radius that the goalie may catch the ball. same index as the inertia points
+    std::vector< double > M_goalie_reach_dist2;
+    //! squared radius that the field player may kick the ball. same index as the inertia points
+    std::vector< double > M_opponent_reach_dist2;
+
+    //! ball trajectory of the current course
+    double M_ball_trajectory_x[MAX_TABLE_STEP + 1];
+    double M_ball_trajectory_y[MAX_TABLE_STEP + 1];
+
     // private for singleton
     GeneratorShoot();
 
@@ -164,6 +186,24 @@ private:
 
     void clear();
 
+    /*!
+      \brief update the opponent list and the opponent reach tables
+      \param wm world model
+     */
+    void updateOpponents( const rcsc::WorldModel & wm );
+
+    /*!
+      \brief create the courses for all target points on the goal line
+      \param wm world model
+     */
+    void createCourses( const rcsc::WorldModel & wm );
+
+    /*!
+      \brief compare the elapsed time with and without the opponent reach filter
+      \param wm world model
+     */
+    void benchmarkOpponentFilter( const rcsc::WorldModel & wm );
+
     void createShoot( const rcsc::WorldModel & wm,
                       const rcsc::Vector2D & target_point );
 
@@ -174,10 +214,12 @@ private:
                       const double & ball_move_dist );
 
     bool maybeGoalieCatch( const rcsc::PlayerObject * goalie,
-                           Course & course );
+                           Course & course,
+                           const unsigned char * reach_steps );
 
     bool opponentCanReach( const rcsc::PlayerObject * opponent,
-                           Course & course );
+                           Course & course,
+                           const unsigned char * reach_steps );
 
     void evaluateCourses( const rcsc::WorldModel & wm );
 };
@@ -31,21 +31,30 @@
 #include "helios_player.h"
 
 #include "options.h"
+#include "shared_data_store.h"
 
 #include "statistics.h"
+#include "stage_profiler.h"
 #include "strategy.h"
 #include "mark_analyzer.h"
 #include "field_analyzer.h"
 
 #include "action_chain_holder.h"
+#include "ball_trajectory_table.h"
+#include "dash_profile_cache.h"
 #include "field_evaluator.h"
 #include "field_evaluator_default.h"
 #include "field_evaluator2013.h"
 #include "field_evaluator2016.h"
 #include "field_evaluator_svmrank.h"
+#include "intercept_evaluator2013.h"
+#include "intercept_evaluator2015.h"
+#include "intercept_scorer.h"
+#include "reach_cycle_table.h"
 
 #include "generator_center_forward_free_move.h"
 #include "generator_clear.h"
+#include "generator_pass.h"
 
 #include "soccer_role.h"
 
@@ -67,7 +76,7 @@
 #include "view_tactical.h"
 
 // #include "goalie_optimal_position.h"
-// #include "intercept_probability.h"
+#include "intercept_probability.h"
 
 #include <rcsc/action/basic_actions.h>
 #include <rcsc/action/bhv_emergency.h>
@@ -97,6 +106,7 @@
 #include <rcsc/param/cmd_line_parser.h>
 
 #include <iostream>
+#include <algorithm>
 #include <sstream>
 #include <string>
 #include <cstdlib>
@@ -232,6 +242,11 @@ HeliosPlayer::initImpl( CmdLineParser & cmd_parser )
 
     const Options & opt = Options::i();
 
+    if ( opt.stageProfile() )
+    {
+        StageProfiler::instance().setEnabled( true );
+    }
+
     if ( ! Strategy::instance().init() )
     {
         std::cerr << config().teamName()
@@ -247,8 +262,27 @@ HeliosPlayer::initImpl( CmdLineParser & cmd_parser )
                   << opt.kickConfFile() << "]" << std::endl;
     }
 
-    if ( opt.ballTableFile().empty()
-         || ! FieldAnalyzer::instance().init( opt.ballTableFile() ) )
+    //
+    // attach the read only data tables published by another process.
+    // if not available, the tables are read from the files.
+    //
+    SharedDataStore & shared_data = SharedDataStore::instance();
+    std::string shared_data_key;
+    if ( ! opt.sharedDataName().empty() )
+    {
+        std::vector< std::string > files;
+        files.push_back( opt.ballTableFile() );
+        InterceptProbability::get_file_paths( opt.interceptConfDir(), &files );
+        shared_data_key = SharedDataStore::make_key( files );
+
+        shared_data.attach( opt.sharedDataName(), shared_data_key );
+    }
+
+    const bool shared_ball_table = ( shared_data.isAttached()
+                                     && FieldAnalyzer::instance().attach( shared_data ) );
+    if ( ! shared_ball_table
+         && ( opt.ballTableFile().empty()
+              || ! FieldAnalyzer::instance().init( opt.ballTableFile() ) ) )
     {
         std::cerr << config().teamName()
                   << ": ***ERROR*** Could not initialize the ball model table."
@@ -269,6 +303,50 @@ HeliosPlayer::initImpl( CmdLineParser & cmd_parser )
         return false;
     }
 
+    GeneratorPass::instance().setThreadSize( std::max( 1, opt.passGeneratorThreads() ) );
+
+    if ( opt.interceptEvaluatorName() == "2013" )
+    {
+        InterceptScorer::instance().setEvaluator( InterceptEvaluator::Ptr( new InterceptEvaluator2013() ) );
+    }
+    else if ( opt.interceptEvaluatorName() == "2015" )
+    {
+        InterceptScorer::instance().setEvaluator( InterceptEvaluator::Ptr( new InterceptEvaluator2015( false ) ) );
+    }
+    else
+    {
+        std::cerr << config().teamName()
+                  << ": ***WARNING*** Unknown intercept evaluator name ["
+                  << opt.interceptEvaluatorName() << "]" << std::endl;
+    }
+
+    if ( opt.passInterceptProbability()
+         && ! ( shared_data.isAttached()
+                && InterceptProbability::instance().attach( shared_data ) )
+         && ! InterceptProbability::instance().read( opt.interceptConfDir() ) )
+    {
+        std::cerr << config().teamName()
+                  << ": ***WARNING*** Could not read the intercept probability tables: ["
+                  << opt.interceptConfDir() << "]" << std::endl;
+    }
+
+    //
+    // publish the tables read from the files for the other processes
+    //
+    if ( ! opt.sharedDataName().empty()
+         && ! shared_data.isAttached() )
+    {
+        FieldAnalyzer::i().ballMoveModel().publish( shared_data );
+        InterceptProbability::i().publish( shared_data );
+
+        if ( shared_data.publish( opt.sharedDataName(), shared_data_key ) )
+        {
+            std::cerr << config().teamName()
+                      << ": published the data tables to [" << opt.sharedDataName() << "]"
+                      << std::endl;
+        }
+    }
+
     return true;
 }
 
@@ -290,6 +368,45 @@ HeliosPlayer::handleExit()
               << " ave_time=" << Statistics::instance().averageActionSearchMSec()
               << std::endl;
 #endif
+    if ( Options::i().chainSearchBudgetMSec() > 0.0 )
+    {
+        std::cout << config().teamName() << ' ' << world().self().unum() << ':'
+                  << " action search budget=" << Options::i().chainSearchBudgetMSec()
+                  << " count=" << Statistics::instance().totalActionSearchCount()
+                  << " time_over=" << Statistics::instance().actionSearchTimeOverCount()
+                  << " max_time=" << Statistics::instance().maxActionSearchMSec()
+                  << " ave_time=" << Statistics::instance().averageActionSearchMSec()
+                  << std::endl;
+    }
+    if ( Options::i().chainSearchTranspositionGrid() > 0.0 )
+    {
+        std::cout << config().teamName() << ' ' << world().self().unum() << ':'
+                  << " transposition lookup=" << Statistics::instance().transpositionLookupCount()
+                  << " hit_rate=" << Statistics::instance().transpositionHitRate()
+                  << " cut=" << Statistics::instance().transpositionCutCount()
+                  << " memory=" << Statistics::instance().transpositionMemorySize()
+                  << std::endl;
+    }
+    if ( Options::i().chainSearchWarmStart() )
+    {
+        std::cout << config().teamName() << ' ' << world().self().unum() << ':'
+                  << " warm start count=" << Statistics::instance().warmStartCount()
+                  << " hit=" << Statistics::instance().warmStartHitCount()
+                  << " hit_rate=" << Statistics::instance().warmStartHitRate()
+                  << std::endl;
+    }
+    if ( Options::i().chainSearchBenchmark() )
+    {
+        std::cout << config().teamName() << ' ' << world().self().unum() << ": ";
+        ActionChainHolder::i().printBenchmark( std::cout );
+    }
+    if ( StageProfiler::instance().isEnabled() )
+    {
+        std::cout << config().teamName() << ' ' << world().self().unum() << ": ";
+        StageProfiler::instance().print( std::cout );
+        std::cout << config().teamName() << ' ' << world().self().unum() << ": ";
+        DashProfileCache::i().print( std::cout );
+    }
     PlayerAgent::handleExit();
 }
 
@@ -301,12 +418,23 @@ HeliosPlayer::handleExit()
 void
 HeliosPlayer::actionImpl()
 {
+    StageProfiler::Scope total_profile( StageProfiler::ACTION_TOTAL );
+
     //
     // update strategy and analyzer
     //
-    Strategy::instance().update( world() );
-    MarkAnalyzer::instance().update( world() );
-    FieldAnalyzer::instance().update( world() );
+    {
+        StageProfiler::Scope profile( StageProfiler::STRATEGY_UPDATE );
+        Strategy::instance().update( world() );
+    }
+    {
+        StageProfiler::Scope profile( StageProfiler::MARK_ANALYZER_UPDATE );
+        MarkAnalyzer::instance().update( world() );
+    }
+    {
+        StageProfiler::Scope profile( StageProfiler::FIELD_ANALYZER_UPDATE );
+        FieldAnalyzer::instance().update( world() );
+    }
 
     //
     // handle special situations
@@ -343,10 +471,15 @@ HeliosPlayer::actionImpl()
     //
     // search the best action sequence
     //
-    ActionChainHolder::instance().update( world() );
-
+    {
+        StageProfiler::Scope profile( StageProfiler::ACTION_CHAIN_UPDATE );
+        ActionChainHolder::instance().update( world() );
+    }
 
-    GeneratorClear::instance().generate( world() );
+    {
+        StageProfiler::Scope profile( StageProfiler::GENERATOR_CLEAR );
+        GeneratorClear::instance().generate( world() );
+    }
 
     //
     // override execute if role accept
@@ -355,6 +488,7 @@ HeliosPlayer::actionImpl()
          || role->acceptExecution( world() ) )
     {
         //writeInterceptDecisionLog( role->shortName() );
+        StageProfiler::Scope profile( StageProfiler::ROLE_EXECUTE );
         role->execute( this );
         return;
     }
@@ -366,6 +500,7 @@ HeliosPlayer::actionImpl()
     {
         dlog.addText( Logger::TEAM,
                       __FILE__": penalty kick" );
+        StageProfiler::Scope profile( StageProfiler::ROLE_EXECUTE );
         Bhv_PenaltyKick().execute( this );
         return;
     }
@@ -373,6 +508,7 @@ HeliosPlayer::actionImpl()
     //
     // other set play behavior
     //
+    StageProfiler::Scope profile( StageProfiler::ROLE_EXECUTE );
     Bhv_SetPlay().execute( this );
 }
 
@@ -635,6 +771,10 @@ HeliosPlayer::handleActionEnd()
     //
 
     Statistics::instance().processPostActionCallbacks();
+
+    FieldAnalyzer::i().opponentGrid().writeDebugLog();
+
+    StageProfiler::instance().endCycle( world().time() );
 }
 
 /*-------------------------------------------------------------------*/
@@ -691,6 +831,22 @@ HeliosPlayer::handleInitMessage()
     }
 
     ActionChainHolder::instance().init( field_evaluator, action_generator );
+
+    if ( Options::i().stageProfileTrace() )
+    {
+        std::string path = Options::i().logDir();
+        if ( ! path.empty()
+             && path[path.length() - 1] != '/' )
+        {
+            path += '/';
+        }
+
+        std::ostringstream ostr;
+        ostr << world().teamName() << '-' << world().self().unum() << "-profile.dat";
+        path += ostr.str();
+
+        StageProfiler::instance().openTrace( path );
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -700,6 +856,8 @@ HeliosPlayer::handleInitMessage()
 void
 HeliosPlayer::handleServerParam()
 {
+    BallTrajectoryTable::instance().create();
+
     if ( ServerParam::i().keepawayMode() )
     {
         std::cerr << "set Keepaway mode communication." << std::endl;
@@ -739,6 +897,20 @@ void
 HeliosPlayer::handlePlayerType()
 {
     // TODO: create kick table for each player type.
+
+    ReachCycleTable::instance().create();
+
+    if ( Options::i().reachCycleTableValidation()
+         && ReachCycleTable::i().size() == PlayerParam::i().playerTypes() )
+    {
+        if ( ! ReachCycleTable::i().validate( 10000 ) )
+        {
+            std::cerr << world().teamName() << ' '
+                      << world().self().unum() << ": "
+                      << " ReachCycleTable validation failed."
+                      << std::endl;
+        }
+    }
 }
 
 /*-------------------------------------------------------------------*/
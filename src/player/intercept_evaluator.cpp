@@ -0,0 +1,241 @@
+// -*-c++-*-
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "intercept_evaluator.h"
+
+#include <rcsc/player/intercept_table.h>
+#include <rcsc/player/world_model.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/geom/segment_2d.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace rcsc;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+InterceptEvaluator::BallPath::update( const WorldModel & wm,
+                                      const std::vector< InterceptInfo > & candidates )
+{
+    const double ball_decay = ServerParam::i().ballDecay();
+    const double first_ball_speed = wm.ball().vel().r();
+
+    int max_step = 0;
+    for ( std::vector< InterceptInfo >::const_iterator it = candidates.begin(), end = candidates.end();
+          it != end;
+          ++it )
+    {
+        max_step = std::max( max_step, std::max( it->reachCycle(), it->reachStep() ) );
+    }
+
+    x_.resize( max_step + 1 );
+    y_.resize( max_step + 1 );
+    speed_.resize( max_step + 1 );
+
+    for ( int step = 0; step <= max_step; ++step )
+    {
+        const Vector2D pos = wm.ball().inertiaPoint( step );
+        x_[step] = pos.x;
+        y_[step] = pos.y;
+        speed_[step] = first_ball_speed * std::pow( ball_decay, step );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+InterceptEvaluator::evaluateBatch( const WorldModel & wm,
+                                   const BallPath &,
+                                   const std::vector< InterceptInfo > & candidates,
+                                   double * values )
+{
+    const size_t size = candidates.size();
+    for ( size_t i = 0; i < size; ++i )
+    {
+        values[i] = evaluate( wm, candidates[i] );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+InterceptEvaluator::is_out_of_pitch( const Vector2D & ball_pos )
+{
+    const ServerParam & SP = ServerParam::i();
+
+    const double max_x = ( SP.keepawayMode()
+                           ? SP.keepawayLength() * 0.5 - 1.0
+                           : SP.pitchHalfLength() - 1.0 );
+    const double max_y = ( SP.keepawayMode()
+                           ? SP.keepawayWidth() * 0.5 - 1.0
+                           : SP.pitchHalfWidth() - 1.0 );
+
+    return ( ball_pos.absX() > max_x
+             || ball_pos.absY() > max_y );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+InterceptEvaluator::shoot_spot_value( const Vector2D & ball_pos )
+{
+    const double spot_x_dist = std::fabs( ball_pos.x - 44.0 );
+    const double spot_y_dist = ball_pos.absY() * 0.5;
+    const double spot_dist = std::sqrt( std::pow( spot_x_dist, 2 ) + std::pow( spot_y_dist, 2 ) );
+    return spot_dist * -0.2;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+InterceptEvaluator::opponent_step_value( const WorldModel & wm,
+                                         const Vector2D & ball_pos,
+                                         const int reach_cycle )
+{
+    if ( wm.gameMode().type() == GameMode::GoalKick_
+         && wm.gameMode().side() == wm.ourSide()
+         && ball_pos.x < ServerParam::i().ourPenaltyAreaLineX() - 2.0
+         && ball_pos.absY() < ServerParam::i().penaltyAreaHalfWidth() - 2.0 )
+    {
+        // no penalty
+        return 0.0;
+    }
+
+    const int opponent_step = wm.interceptTable()->opponentReachStep();
+    if ( opponent_step <= reach_cycle + 3 )
+    {
+        return ( opponent_step - ( reach_cycle + 3 ) ) * 5.0;
+    }
+
+    return 0.0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+InterceptEvaluator::teammate_step_value( const WorldModel & wm,
+                                         const int reach_cycle )
+{
+    const int teammate_step = wm.interceptTable()->teammateReachStep();
+    if ( teammate_step <= reach_cycle + 3 )
+    {
+        return ( teammate_step - ( reach_cycle + 3 ) ) * 0.5;
+    }
+
+    return 0.0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+InterceptEvaluator::move_dist_value( const WorldModel & wm,
+                                     const Vector2D & ball_pos,
+                                     const InterceptInfo & action )
+{
+    const double move_dist = action.selfPos().dist( wm.self().pos() );
+
+    double value = 0.0;
+    if ( ball_pos.x < wm.offsideLineX() )
+    {
+        value += move_dist * -0.3;
+    }
+    if ( action.ballDist() > wm.self().playerType().kickableArea() - 0.3 )
+    {
+        value += move_dist * -0.5;
+    }
+
+    return value;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+InterceptEvaluator::ball_dist_value( const WorldModel & wm,
+                                     const InterceptInfo & action )
+{
+    const double kickable_area = wm.self().playerType().kickableArea();
+    if ( action.ballDist() > kickable_area - 0.4 )
+    {
+        return ( action.ballDist() - ( kickable_area - 0.4 ) ) * -3.0 - 0.5;
+    }
+
+    return 0.0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+InterceptEvaluator::ball_speed_value( const WorldModel & wm,
+                                      const AngleDeg & body_angle,
+                                      const Vector2D & ball_pos,
+                                      const double ball_speed )
+{
+    const double fast_speed_thr = wm.self().playerType().realSpeedMax() * 0.8;
+    const double slow_ball_speed_thr = 0.55; // magic number
+
+    if ( ( body_angle - wm.ball().vel().th() ).abs() < 30.0
+         && Segment2D( wm.ball().pos(), ball_pos ).dist( wm.self().pos() )
+         < wm.self().playerType().kickableArea() - 0.3 )
+    {
+        if ( ball_speed < fast_speed_thr )
+        {
+            return ( fast_speed_thr - ball_speed ) * -20.0;
+        }
+    }
+    else
+    {
+        if ( ball_speed < slow_ball_speed_thr )
+        {
+            return std::pow( slow_ball_speed_thr - ball_speed, 2 ) * -70.0;
+        }
+    }
+
+    return 0.0;
+}
@@ -27,8 +27,12 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include <vector>
+
 namespace rcsc {
+class AngleDeg;
 class InterceptInfo;
+class Vector2D;
 class WorldModel;
 }
 
@@ -46,6 +50,25 @@ public:
         double value_;
     };
 
+    /*!
+      \struct BallPath
+      \brief the ball positions and speeds shared by all candidates in the same cycle.
+      The values are same as WorldModel::ball().inertiaPoint() and
+      the first ball speed multiplied by std::pow( ballDecay, step ).
+     */
+    struct BallPath {
+        std::vector< double > x_; //!< ball x. index = step
+        std::vector< double > y_; //!< ball y. index = step
+        std::vector< double > speed_; //!< ball speed. index = step
+
+        /*!
+          \brief compute the ball path until the maximum reach step of the candidates
+          \param wm world model
+          \param candidates intercept candidates
+         */
+        void update( const rcsc::WorldModel & wm,
+                     const std::vector< rcsc::InterceptInfo > & candidates );
+    };
 
 protected:
 
@@ -73,6 +96,100 @@ public:
     double evaluate( const rcsc::WorldModel & wm,
                      const rcsc::InterceptInfo & action ) = 0;
 
+    /*!
+      \brief evaluate all candidates at once.
+      The default implementation calls evaluate() for each candidate.
+      \param wm world model
+      \param path ball path updated for the candidates
+      \param candidates intercept candidates
+      \param values array to store the results. its size must be candidates.size().
+     */
+    virtual
+    void evaluateBatch( const rcsc::WorldModel & wm,
+                        const BallPath & path,
+                        const std::vector< rcsc::InterceptInfo > & candidates,
+                        double * values );
+
+protected:
+
+    //
+    // the terms shared by evaluate() and evaluateBatch() of the derived classes
+    //
+
+    /*!
+      \brief check if the ball position is out of the pitch
+      \param ball_pos ball position at the reach cycle
+      \return true if out of the pitch
+     */
+    static
+    bool is_out_of_pitch( const rcsc::Vector2D & ball_pos );
+
+    /*!
+      \brief get the value for the shoot spot distance
+      \param ball_pos ball position at the reach cycle
+      \return value
+     */
+    static
+    double shoot_spot_value( const rcsc::Vector2D & ball_pos );
+
+    /*!
+      \brief get the value for the opponent reach step.
+      no penalty for our goal kick in our penalty area.
+      \param wm world model
+      \param ball_pos ball position at the reach cycle
+      \param reach_cycle reach cycle of the candidate
+      \return value
+     */
+    static
+    double opponent_step_value( const rcsc::WorldModel & wm,
+                                const rcsc::Vector2D & ball_pos,
+                                const int reach_cycle );
+
+    /*!
+      \brief get the value for the teammate reach step
+      \param wm world model
+      \param reach_cycle reach cycle of the candidate
+      \return value
+     */
+    static
+    double teammate_step_value( const rcsc::WorldModel & wm,
+                                const int reach_cycle );
+
+    /*!
+      \brief get the value for the move distance
+      \param wm world model
+      \param ball_pos ball position at the reach cycle
+      \param action candidate
+      \return value
+     */
+    static
+    double move_dist_value( const rcsc::WorldModel & wm,
+                            const rcsc::Vector2D & ball_pos,
+                            const rcsc::InterceptInfo & action );
+
+    /*!
+      \brief get the value for the ball distance
+      \param wm world model
+      \param action candidate
+      \return value
+     */
+    static
+    double ball_dist_value( const rcsc::WorldModel & wm,
+                            const rcsc::InterceptInfo & action );
+
+    /*!
+      \brief get the value for the ball speed at the reach step
+      \param wm world model
+      \param body_angle body angle after the turn
+      \param ball_pos ball position at the reach cycle
+      \param ball_speed ball speed at the reach step
+      \return value
+     */
+    static
+    double ball_speed_value( const rcsc::WorldModel & wm,
+                             const rcsc::AngleDeg & body_angle,
+                             const rcsc::Vector2D & ball_pos,
+                             const double ball_speed );
 
 };
 
@@ -0,0 +1,261 @@
+// -*-c++-*-
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "intercept_evaluator2013.h"
+
+#include <rcsc/player/intercept_table.h>
+#include <rcsc/player/world_model.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/common/logger.h>
+
+#include <algorithm>
+#include <cmath>
+
+// #define DEBUG_PRINT
+
+using namespace rcsc;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+InterceptEvaluator2013::InterceptEvaluator2013()
+    : M_count( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+InterceptEvaluator2013::evaluate( const WorldModel & wm,
+                                  const InterceptInfo & action )
+{
+    const Vector2D ball_pos = wm.ball().inertiaPoint( action.reachCycle() );
+    const double ball_speed = wm.ball().vel().r() * std::pow( ServerParam::i().ballDecay(), action.reachStep() );
+
+    return evaluateImpl( wm, action, ball_pos, ball_speed );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+InterceptEvaluator2013::evaluateBatch( const WorldModel & wm,
+                                       const BallPath & path,
+                                       const std::vector< InterceptInfo > & candidates,
+                                       double * values )
+{
+    const size_t size = candidates.size();
+    for ( size_t i = 0; i < size; ++i )
+    {
+        const InterceptInfo & info = candidates[i];
+        values[i] = evaluateImpl( wm, info,
+                                  Vector2D( path.x_[info.reachCycle()], path.y_[info.reachCycle()] ),
+                                  path.speed_[info.reachStep()] );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+InterceptEvaluator2013::evaluateImpl( const WorldModel & wm,
+                                      const InterceptInfo & action,
+                                      const Vector2D & ball_pos,
+                                      const double ball_speed )
+{
+    ++M_count;
+
+    const double kickable_area = wm.self().playerType().kickableArea();
+    const AngleDeg body_angle = wm.self().body() + action.turnAngle();
+
+    double value = 0.0;
+
+    if ( is_out_of_pitch( ball_pos ) )
+    {
+        value = -1000.0 - action.reachCycle();
+#ifdef DEBUG_PRINT
+        dlog.addText( Logger::INTERCEPT,
+                      "%d: (InterceptEval2013) out of pitch = %.3f",
+                      M_count, value );
+#endif
+        return value;
+    }
+
+    double tmp_val;
+
+    //
+    // shoot spot distance
+    //
+    tmp_val = shoot_spot_value( ball_pos );
+    value += tmp_val;
+#ifdef DEBUG_PRINT
+    dlog.addText( Logger::INTERCEPT,
+                  "%d: (InterceptEval2013) shoot spot dist = %.3f (%.3f)",
+                  M_count, tmp_val, value );
+#endif
+
+    //
+    // opponent step
+    //
+    tmp_val = opponent_step_value( wm, ball_pos, action.reachCycle() );
+    value += tmp_val;
+#ifdef DEBUG_PRINT
+    dlog.addText( Logger::INTERCEPT,
+                  "%d: (InterceptEval2013) opponent diff = %.3f (%.3f)",
+                  M_count, tmp_val, value );
+#endif
+
+    //
+    // teammate step
+    //
+    tmp_val = teammate_step_value( wm, action.reachCycle() );
+    value += tmp_val;
+#ifdef DEBUG_PRINT
+    dlog.addText( Logger::INTERCEPT,
+                  "%d: (InterceptEval2013) teammate diff = %.3f (%.3f)",
+                  M_count, tmp_val, value );
+#endif
+
+    //
+    // turn angle
+    //
+    if ( action.actionType() == InterceptInfo::TURN_FORWARD_DASH
+         || action.actionType() == InterceptInfo::TURN_BACK_DASH )
+    {
+        if ( action.ballDist() > kickable_area - 0.3
+             && action.turnCycle() > 0 )
+        {
+            tmp_val = std::fabs( action.turnAngle() ) * -0.025;
+            value += tmp_val;
+#ifdef DEBUG_PRINT
+            dlog.addText( Logger::INTERCEPT,
+                          "%d: (InterceptEval2013) turn penalty = %.3f (angle=%.1f) (%.3f)",
+                          M_count, tmp_val, action.turnAngle(), value );
+#endif
+        }
+    }
+
+    //
+    // move distance
+    //
+    tmp_val = move_dist_value( wm, ball_pos, action );
+    value += tmp_val;
+#ifdef DEBUG_PRINT
+    dlog.addText( Logger::INTERCEPT,
+                  "%d: (InterceptEval2013) move dist penalty = %.3f (%.3f)",
+                  M_count, tmp_val, value );
+#endif
+
+    //
+    // ball distance
+    //
+    tmp_val = ball_dist_value( wm, action );
+    if ( tmp_val != 0.0 )
+    {
+        value += tmp_val;
+#ifdef DEBUG_PRINT
+        dlog.addText( Logger::INTERCEPT,
+                      "%d: (InterceptEval2013) ball dist penalty(1) = %.3f (%.3f)",
+                      M_count, tmp_val, value );
+#endif
+    }
+
+    //
+    // stamina
+    //
+    {
+        tmp_val = ( action.stamina() - wm.self().stamina() ) * 0.0001;
+        value += tmp_val;
+#ifdef DEBUG_PRINT
+        dlog.addText( Logger::INTERCEPT,
+                      "%d: (InterceptEval2013) stamina penalty = %.3f (%.3f)",
+                      M_count, tmp_val, value );
+#endif
+    }
+
+    //
+    // turn
+    //
+    if ( action.turnStep() > 0 )
+    {
+        tmp_val = -0.01;
+        value += tmp_val;
+#ifdef DEBUG_PRINT
+        dlog.addText( Logger::INTERCEPT,
+                      "%d: (InterceptEval2013) turn penalty = %.3f (%.3f)",
+                      M_count, tmp_val, value );
+#endif
+    }
+
+    if ( action.turnStep() > 0
+         && action.dashPower() < 0.0 )
+    {
+        tmp_val = std::max( 0.0, body_angle.abs() - 90.0 ) * -0.1;
+        value += tmp_val;
+#ifdef DEBUG_PRINT
+        dlog.addText( Logger::INTERCEPT,
+                      "%d: (InterceptEval2013) turn back penalty = %.3f (%.3f)",
+                      M_count, tmp_val, value );
+#endif
+
+        if ( ( wm.self().body() - body_angle ).abs() > 90.0 )
+        {
+            tmp_val = -0.001;
+            value += tmp_val;
+#ifdef DEBUG_PRINT
+            dlog.addText( Logger::INTERCEPT,
+                          "%d: (InterceptEval2013) turn back penalty(2) = %.3f (%.3f)",
+                          M_count, tmp_val, value );
+#endif
+        }
+    }
+
+    //
+    // ball speed
+    //
+    tmp_val = ball_speed_value( wm, body_angle, ball_pos, ball_speed );
+    if ( tmp_val != 0.0 )
+    {
+        value += tmp_val;
+#ifdef DEBUG_PRINT
+        dlog.addText( Logger::INTERCEPT,
+                      "%d: (InterceptEval2013) ball speed penalty = %.3f (%.3f)",
+                      M_count, tmp_val, value );
+#endif
+    }
+
+    return value;
+}
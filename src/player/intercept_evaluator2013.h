@@ -0,0 +1,71 @@
+// -*-c++-*-
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef INTERCEPT_EVALUATOR_2013_H
+#define INTERCEPT_EVALUATOR_2013_H
+
+#include "intercept_evaluator.h"
+
+/*!
+  \class InterceptEvaluator2013
+  \brief the evaluation function used by Body_Intercept2013
+ */
+class InterceptEvaluator2013
+    : public InterceptEvaluator {
+private:
+    int M_count;
+
+public:
+
+    InterceptEvaluator2013();
+
+    virtual
+    double evaluate( const rcsc::WorldModel & wm,
+                     const rcsc::InterceptInfo & action );
+
+    virtual
+    void evaluateBatch( const rcsc::WorldModel & wm,
+                        const BallPath & path,
+                        const std::vector< rcsc::InterceptInfo > & candidates,
+                        double * values );
+
+private:
+
+    /*!
+      \brief evaluate the candidate. shared by evaluate() and evaluateBatch().
+      \param wm world model
+      \param action candidate
+      \param ball_pos ball position at the reach cycle
+      \param ball_speed ball speed at the reach step
+      \return evaluation value
+     */
+    double evaluateImpl( const rcsc::WorldModel & wm,
+                         const rcsc::InterceptInfo & action,
+                         const rcsc::Vector2D & ball_pos,
+                         const double ball_speed );
+};
+
+#endif
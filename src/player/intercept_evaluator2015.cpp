@@ -35,7 +35,9 @@
 #include <rcsc/common/server_param.h>
 #include <rcsc/common/logger.h>
 
+#include <algorithm>
 #include <iostream>
+#include <cmath>
 #include <limits>
 
 #define DEBUG_PRINT
@@ -69,6 +71,42 @@ InterceptEvaluator2015::~InterceptEvaluator2015()
 double
 InterceptEvaluator2015::evaluate( const WorldModel & wm,
                                   const InterceptInfo & action )
+{
+    const Vector2D ball_pos = wm.ball().inertiaPoint( action.reachCycle() );
+    const double ball_speed = wm.ball().vel().r() * std::pow( ServerParam::i().ballDecay(), action.reachStep() );
+
+    return evaluateImpl( wm, action, ball_pos, ball_speed );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+InterceptEvaluator2015::evaluateBatch( const WorldModel & wm,
+                                       const BallPath & path,
+                                       const std::vector< InterceptInfo > & candidates,
+                                       double * values )
+{
+    const size_t size = candidates.size();
+    for ( size_t i = 0; i < size; ++i )
+    {
+        const InterceptInfo & info = candidates[i];
+        values[i] = evaluateImpl( wm, info,
+                                  Vector2D( path.x_[info.reachCycle()], path.y_[info.reachCycle()] ),
+                                  path.speed_[info.reachStep()] );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+InterceptEvaluator2015::evaluateImpl( const WorldModel & wm,
+                                      const InterceptInfo & action,
+                                      const Vector2D & ball_pos,
+                                      const double ball_speed )
 {
     ++M_count;
 
@@ -83,22 +121,9 @@ InterceptEvaluator2015::evaluate( const WorldModel & wm,
         return -std::numeric_limits< double >::max();
     }
 
-    const ServerParam & SP = ServerParam::i();
-
-    const double max_x = ( SP.keepawayMode()
-                           ? SP.keepawayLength() * 0.5 - 1.0
-                           : SP.pitchHalfLength() - 1.0 );
-    const double max_y = ( SP.keepawayMode()
-                           ? SP.keepawayWidth() * 0.5 - 1.0
-                           : SP.pitchHalfWidth() - 1.0 );
-    //const double first_ball_speed = wm.ball().vel().r();
-
-    const Vector2D ball_pos = wm.ball().inertiaPoint( action.reachCycle() );
-
     double value = 0.0;
 
-    if ( ball_pos.absX() > max_x
-         || ball_pos.absY() > max_y )
+    if ( is_out_of_pitch( ball_pos ) )
     {
         value = -1000.0 - action.reachCycle();
 #ifdef DEBUG_PRINT
@@ -110,13 +135,13 @@ InterceptEvaluator2015::evaluate( const WorldModel & wm,
     }
 
     addShootSpotValue( ball_pos, &value );
-    addOpponentStepValue( wm, action, &value );
+    addOpponentStepValue( wm, action, ball_pos, &value );
     addTeammateStepValue( wm, action, &value );
-    addTurnMomentValue( wm, action, &value );
-    addTurnPenalty( wm, action, &value );
-    addMoveDistValue( wm, action, &value );
+    addTurnMomentValue( wm, action, ball_pos, &value );
+    addTurnPenalty( wm, action, ball_pos, &value );
+    addMoveDistValue( wm, action, ball_pos, &value );
     addBallDistValue( wm, action, &value );
-    addBallSpeedPenalty( wm, action, &value );
+    addBallSpeedPenalty( wm, action, ball_pos, ball_speed, &value );
 
     return value;
 }
@@ -129,10 +154,7 @@ void
 InterceptEvaluator2015::addShootSpotValue( const Vector2D & ball_pos,
                                            double * value )
 {
-    double spot_x_dist = std::fabs( ball_pos.x - 44.0 );
-    double spot_y_dist = ball_pos.absY() * 0.5;
-    double spot_dist = std::sqrt( std::pow( spot_x_dist, 2 ) + std::pow( spot_y_dist, 2 ) );
-    double tmp_val = spot_dist * -0.2;
+    double tmp_val = shoot_spot_value( ball_pos );
 
     *value += tmp_val;
 
@@ -151,34 +173,17 @@ InterceptEvaluator2015::addShootSpotValue( const Vector2D & ball_pos,
 void
 InterceptEvaluator2015::addOpponentStepValue( const WorldModel & wm,
                                               const InterceptInfo & action,
+                                              const Vector2D & ball_pos,
                                               double * value )
 {
-    const Vector2D ball_pos = wm.ball().inertiaPoint( action.reachCycle() );
-
-    double tmp_val = 0.0;
-
-    if ( wm.gameMode().type() == GameMode::GoalKick_
-         && wm.gameMode().side() == wm.ourSide()
-         && ball_pos.x < ServerParam::i().ourPenaltyAreaLineX() - 2.0
-         && ball_pos.absY() < ServerParam::i().penaltyAreaHalfWidth() - 2.0 )
-    {
-        // no penalty
-    }
-    else
-    {
-        const int opponent_step = wm.interceptTable()->opponentReachStep();
-        if ( opponent_step <= action.reachCycle() + 3 )
-        {
-            tmp_val = ( opponent_step - ( action.reachCycle() + 3 ) ) * 5.0;
-        }
-    }
+    double tmp_val = opponent_step_value( wm, ball_pos, action.reachCycle() );
 
     *value += tmp_val;
 
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::INTERCEPT,
                   "%d: (InterceptEval2015) opponent diff = %.3f (%.3f)",
-                  M_count, tmp_val, value );
+                  M_count, tmp_val, *value );
 #endif
 
 }
@@ -192,14 +197,7 @@ InterceptEvaluator2015::addTeammateStepValue( const WorldModel & wm,
                                               const InterceptInfo & action,
                                               double * value )
 {
-    const int teammate_step = wm.interceptTable()->teammateReachStep();
-
-    double tmp_val = 0.0;
-
-    if ( teammate_step <= action.reachCycle() + 3 )
-    {
-        tmp_val = ( teammate_step - ( action.reachCycle() + 3 ) ) * 0.5;
-    }
+    double tmp_val = teammate_step_value( wm, action.reachCycle() );
 
     *value += tmp_val;
 
@@ -217,6 +215,7 @@ InterceptEvaluator2015::addTeammateStepValue( const WorldModel & wm,
 void
 InterceptEvaluator2015::addTurnMomentValue( const WorldModel & wm,
                                             const InterceptInfo & action,
+                                            const Vector2D & ball_pos,
                                             double * value )
 {
     if ( action.turnCycle() == 0 )
@@ -230,7 +229,6 @@ InterceptEvaluator2015::addTurnMomentValue( const WorldModel & wm,
     }
 
     const Vector2D self_pos = wm.self().inertiaPoint( action.reachCycle() );
-    const Vector2D ball_pos = wm.ball().inertiaPoint( action.reachCycle() );
 
     const AngleDeg body_angle = ( action.dashPower() < 0
                                   ? ( ball_pos - self_pos ).th() + 180.0
@@ -255,6 +253,7 @@ InterceptEvaluator2015::addTurnMomentValue( const WorldModel & wm,
 void
 InterceptEvaluator2015::addTurnPenalty( const WorldModel & wm,
                                         const InterceptInfo & action,
+                                        const Vector2D & ball_pos,
                                         double * value )
 {
     if ( action.turnStep() == 0 )
@@ -273,7 +272,6 @@ InterceptEvaluator2015::addTurnPenalty( const WorldModel & wm,
     if ( action.dashPower() < 0.0 )
     {
         const Vector2D self_pos = wm.self().inertiaPoint( action.reachCycle() );
-        const Vector2D ball_pos = wm.ball().inertiaPoint( action.reachCycle() );
         const AngleDeg body_angle = ( ball_pos - self_pos ).th() + 180.0;
 
 
@@ -304,22 +302,10 @@ InterceptEvaluator2015::addTurnPenalty( const WorldModel & wm,
 void
 InterceptEvaluator2015::addMoveDistValue( const WorldModel & wm,
                                           const InterceptInfo & action,
+                                          const Vector2D & ball_pos,
                                           double * value )
 {
-    const Vector2D ball_pos = wm.ball().inertiaPoint( action.reachCycle() );
-
-    double move_dist = action.selfPos().dist( wm.self().pos() );
-    double tmp_val = 0.0;
-
-    if ( ball_pos.x < wm.offsideLineX() )
-    {
-        tmp_val += move_dist * -0.3; //-0.1;
-    }
-
-    if ( action.ballDist() > wm.self().playerType().kickableArea() - 0.3 )
-    {
-        tmp_val += move_dist * -0.5; //-0.2;
-    }
+    double tmp_val = move_dist_value( wm, ball_pos, action );
 
     *value += tmp_val;
 #ifdef DEBUG_PRINT
@@ -338,17 +324,15 @@ InterceptEvaluator2015::addBallDistValue( const WorldModel & wm,
                                           const InterceptInfo & action,
                                           double * value )
 {
-    if ( action.ballDist() > wm.self().playerType().kickableArea() - 0.4 )
+    double tmp_val = ball_dist_value( wm, action );
+    if ( tmp_val != 0.0 )
     {
-        double dist = action.ballDist() - ( wm.self().playerType().kickableArea() - 0.4 );
-        double tmp_val = dist * -3.0 - 0.5;
-
         *value += tmp_val;
 
 #ifdef DEBUG_PRINT
         dlog.addText( Logger::INTERCEPT,
                       "%d: (intercept eval) ball dist penalty(1) = %.3f (%.3f)",
-                      M_count, tmp_val, value );
+                      M_count, tmp_val, *value );
 #endif
     }
 }
@@ -360,49 +344,25 @@ InterceptEvaluator2015::addBallDistValue( const WorldModel & wm,
 void
 InterceptEvaluator2015::addBallSpeedPenalty( const WorldModel & wm,
                                              const InterceptInfo & action,
+                                             const Vector2D & ball_pos,
+                                             const double ball_speed,
                                              double * value )
 {
-    const double fast_speed_thr = wm.self().playerType().realSpeedMax() * 0.8;
-    const double slow_ball_speed_thr = 0.55;
-
     const Vector2D self_pos = wm.self().inertiaPoint( action.reachCycle() );
-    const Vector2D ball_pos = wm.ball().inertiaPoint( action.reachCycle() );
     const AngleDeg body_angle = ( action.turnStep() == 0
                                   ? wm.self().body()
                                   : action.dashPower() < 0.0
                                   ? ( ball_pos - self_pos ).th() + 180.0
                                   : ( ball_pos - self_pos ).th() );
-    const AngleDeg ball_vel_angle = wm.ball().vel().th();
-    const double ball_speed = wm.ball().vel().r()
-        * std::pow( ServerParam::i().ballDecay(), action.reachStep() );
-
 
-    if ( ( body_angle - ball_vel_angle ).abs() < 30.0
-         && Segment2D( wm.ball().pos(), ball_pos ).dist( wm.self().pos() )
-         < wm.self().playerType().kickableArea() - 0.3 )
+    double tmp_val = ball_speed_value( wm, body_angle, ball_pos, ball_speed );
+    if ( tmp_val != 0.0 )
     {
-        if ( ball_speed < fast_speed_thr )
-        {
-            double tmp_val = ( fast_speed_thr - ball_speed ) * -20.0;
-            *value += tmp_val;
-#ifdef DEBUG_PRINT
-            dlog.addText( Logger::INTERCEPT,
-                          "%d: (InterceptEval2015) ball speed penalty(1) = %.3f (%.3f)",
-                          M_count, tmp_val, *value );
-#endif
-        }
-    }
-    else
-    {
-        if ( ball_speed < slow_ball_speed_thr ) // magic number
-        {
-            double tmp_val = std::pow( slow_ball_speed_thr - ball_speed, 2 ) * -70.0;
-            *value += tmp_val;
+        *value += tmp_val;
 #ifdef DEBUG_PRINT
-            dlog.addText( Logger::INTERCEPT,
-                          "%d: (InterceptEval2015) ball speed penalty(2) = %.3f (%.3f)",
-                          M_count, tmp_val, *value );
+        dlog.addText( Logger::INTERCEPT,
+                      "%d: (InterceptEval2015) ball speed penalty = %.3f (%.3f)",
+                      M_count, tmp_val, *value );
 #endif
-        }
     }
 }
@@ -53,30 +53,55 @@ public:
     double evaluate( const rcsc::WorldModel & wm,
                      const rcsc::InterceptInfo & action );
 
+    virtual
+    void evaluateBatch( const rcsc::WorldModel & wm,
+                        const BallPath & path,
+                        const std::vector< rcsc::InterceptInfo > & candidates,
+                        double * values );
+
 private:
 
+    /*!
+      \brief evaluate the candidate. shared by evaluate() and evaluateBatch().
+      \param wm world model
+      \param action candidate
+      \param ball_pos ball position at the reach cycle
+      \param ball_speed ball speed at the reach step
+      \return evaluation value
+     */
+    double evaluateImpl( const rcsc::WorldModel & wm,
+                         const rcsc::InterceptInfo & action,
+                         const rcsc::Vector2D & ball_pos,
+                         const double ball_speed );
+
     void addShootSpotValue( const rcsc::Vector2D & ball_pos,
                             double * value );
     void addOpponentStepValue( const rcsc::WorldModel & wm,
                                const rcsc::InterceptInfo & action,
+                               const rcsc::Vector2D & ball_pos,
                                double * value );
     void addTeammateStepValue( const rcsc::WorldModel & wm,
                                const rcsc::InterceptInfo & action,
                                double * value );
     void addTurnMomentValue( const rcsc::WorldModel & wm,
                              const rcsc::InterceptInfo & action,
+                             const rcsc::Vector2D & ball_pos,
                              double * value );
     void addTurnPenalty( const rcsc::WorldModel & wm,
                          const rcsc::InterceptInfo & action,
+                         const rcsc::Vector2D & ball_pos,
                          double * value );
     void addMoveDistValue( const rcsc::WorldModel & wm,
                            const rcsc::InterceptInfo & action,
+                           const rcsc::Vector2D & ball_pos,
                            double * value );
     void addBallDistValue( const rcsc::WorldModel & wm,
                            const rcsc::InterceptInfo & action,
                            double * value );
     void addBallSpeedPenalty( const rcsc::WorldModel & wm,
                               const rcsc::InterceptInfo & action,
+                              const rcsc::Vector2D & ball_pos,
+                              const double ball_speed,
                               double * value );
 };
 
@@ -0,0 +1,655 @@
+// -*-c++-*-
+
+/*!
+  \file intercept_probability.cpp
+  \brief intercept probability table Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "intercept_probability.h"
+
+#include "shared_data_store.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <map>
+#include <cstdio>
+
+namespace {
+
+const char * TABLE_FILES[] = { "self_probability.txt",
+                               "teammate_probability.txt",
+                               "opponent_probability.txt" };
+
+//! prefix of the table names in SharedDataStore
+const char * SHARED_TABLE_NAMES[] = { "intercept_probability.self",
+                                      "intercept_probability.teammate",
+                                      "intercept_probability.opponent" };
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::string
+append_last_separator( const std::string & dir )
+{
+    std::string base_dir = dir;
+    if ( ! base_dir.empty()
+         && base_dir[base_dir.length() - 1] != '/' )
+    {
+        base_dir += '/';
+    }
+    return base_dir;
+}
+
+/*!
+  \brief values of one (poscount, interceptCycle) block
+ */
+struct Block {
+    std::vector< std::vector< double > > rules_;
+    std::vector< std::vector< double > > values_;
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+read_values( const std::string & line_buf,
+             const size_t offset,
+             std::vector< double > * values )
+{
+    std::istringstream istr( line_buf.substr( offset ) );
+
+    double v;
+    while ( istr >> v )
+    {
+        values->push_back( v );
+    }
+
+    return istr.eof();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the level of the value quantized by the thresholds
+  \return level [1, size + 1]
+ */
+inline
+int
+get_level( const double value,
+           const double * thresholds,
+           const int size )
+{
+    int level = 1;
+    while ( level <= size
+            && value >= thresholds[level - 1] )
+    {
+        ++level;
+    }
+    return level;
+}
+
+}
+
+const int InterceptProbability::SITUATION_SIZE;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+InterceptProbability::InterceptProbability()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+InterceptProbability &
+InterceptProbability::instance()
+{
+    static InterceptProbability s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+InterceptProbability::read( const std::string & dir )
+{
+    const std::string base_dir = append_last_separator( dir );
+
+    for ( int t = 0; t < TYPE_SIZE; ++t )
+    {
+        M_tables[t] = Table();
+    }
+
+    for ( int t = 0; t < TYPE_SIZE; ++t )
+    {
+        const std::string filepath = base_dir + TABLE_FILES[t];
+
+        std::ifstream fin( filepath.c_str() );
+        if ( ! fin.is_open() )
+        {
+            std::cerr << __FILE__ << ' ' << __LINE__
+                      << ": ERROR could not open the file. "
+                      << filepath << std::endl;
+            return false;
+        }
+
+        if ( ! readTable( fin, M_tables[t] ) )
+        {
+            std::cerr << __FILE__ << ' ' << __LINE__
+                      << ": ERROR could not read the file. "
+                      << filepath << std::endl;
+            M_tables[t] = Table();
+            return false;
+        }
+
+        M_tables[t].values_data_ = &M_tables[t].values_[0];
+        create_rule_index( M_tables[t] );
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+InterceptProbability::get_file_paths( const std::string & dir,
+                                      std::vector< std::string > * paths )
+{
+    const std::string base_dir = append_last_separator( dir );
+
+    for ( int t = 0; t < TYPE_SIZE; ++t )
+    {
+        paths->push_back( base_dir + TABLE_FILES[t] );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+InterceptProbability::attach( const SharedDataStore & store )
+{
+    Table tables[TYPE_SIZE];
+
+    for ( int t = 0; t < TYPE_SIZE; ++t )
+    {
+        const std::string name = SHARED_TABLE_NAMES[t];
+
+        size_t shape_size = 0, rules_size = 0, values_size = 0;
+        const double * shape = store.table( name + ".shape", &shape_size );
+        const double * rules = store.table( name + ".rules", &rules_size );
+        const double * values = store.table( name + ".values", &values_size );
+
+        if ( ! shape || ! rules || ! values
+             || shape_size != 4 )
+        {
+            return false;
+        }
+
+        Table & table = tables[t];
+        table.pos_count_size_ = static_cast< int >( shape[0] );
+        table.cycle_size_ = static_cast< int >( shape[1] );
+        table.rule_size_ = static_cast< int >( shape[2] );
+        table.step_size_ = static_cast< int >( shape[3] );
+
+        if ( table.pos_count_size_ < 1
+             || table.cycle_size_ < 1
+             || table.rule_size_ < 1
+             || table.step_size_ < 1 )
+        {
+            return false;
+        }
+
+        const size_t block_size = static_cast< size_t >( table.pos_count_size_ ) * table.cycle_size_;
+        if ( values_size != block_size * table.rule_size_ * table.step_size_ )
+        {
+            return false;
+        }
+
+        //
+        // rules: (the number of values, values...) for each rule
+        //
+        size_t i = 0;
+        for ( int r = 0; r < table.rule_size_; ++r )
+        {
+            if ( i >= rules_size )
+            {
+                return false;
+            }
+
+            const size_t n = static_cast< size_t >( rules[i] );
+            ++i;
+            if ( n > rules_size - i )
+            {
+                return false;
+            }
+
+            table.rules_.push_back( std::vector< double >( rules + i, rules + i + n ) );
+            i += n;
+        }
+
+        table.values_data_ = values;
+        create_rule_index( table );
+    }
+
+    for ( int t = 0; t < TYPE_SIZE; ++t )
+    {
+        M_tables[t] = tables[t];
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+InterceptProbability::publish( SharedDataStore & store ) const
+{
+    if ( ! isValid() )
+    {
+        return;
+    }
+
+    for ( int t = 0; t < TYPE_SIZE; ++t )
+    {
+        const Table & table = M_tables[t];
+        const std::string name = SHARED_TABLE_NAMES[t];
+
+        const size_t block_size = static_cast< size_t >( table.pos_count_size_ ) * table.cycle_size_;
+
+        std::vector< double > shape;
+        shape.push_back( table.pos_count_size_ );
+        shape.push_back( table.cycle_size_ );
+        shape.push_back( table.rule_size_ );
+        shape.push_back( table.step_size_ );
+
+        std::vector< double > rules;
+        for ( std::vector< std::vector< double > >::const_iterator r = table.rules_.begin();
+              r != table.rules_.end();
+              ++r )
+        {
+            rules.push_back( static_cast< double >( r->size() ) );
+            rules.insert( rules.end(), r->begin(), r->end() );
+        }
+
+        store.addTable( name + ".shape", shape );
+        store.addTable( name + ".rules", rules );
+        store.addTable( name + ".values",
+                        std::vector< double >( table.values_data_,
+                                               table.values_data_ + block_size * table.rule_size_ * table.step_size_ ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+InterceptProbability::readTable( std::istream & is,
+                                 Table & table )
+{
+    std::map< std::pair< int, int >, Block > blocks;
+
+    int pos_count = 0;
+    int cycle = -1;
+    Block * block = static_cast< Block * >( 0 );
+
+    std::string line_buf;
+    while ( std::getline( is, line_buf ) )
+    {
+        if ( line_buf.empty()
+             || line_buf[0] == '#'
+             || line_buf[0] == ';' )
+        {
+            continue;
+        }
+
+        if ( line_buf.compare( 0, 8, "poscount" ) == 0 )
+        {
+            if ( std::sscanf( line_buf.c_str(), " poscount %d ", &pos_count ) != 1
+                 || pos_count < 0 )
+            {
+                std::cerr << __FILE__ << ' ' << __LINE__
+                          << ": ERROR illegal poscount line ["
+                          << line_buf << ']' << std::endl;
+                return false;
+            }
+            block = static_cast< Block * >( 0 );
+        }
+        else if ( line_buf.compare( 0, 14, "interceptCycle" ) == 0 )
+        {
+            if ( std::sscanf( line_buf.c_str(), " interceptCycle %d ", &cycle ) != 1
+                 || cycle < 1 )
+            {
+                std::cerr << __FILE__ << ' ' << __LINE__
+                          << ": ERROR illegal interceptCycle line ["
+                          << line_buf << ']' << std::endl;
+                return false;
+            }
+            block = &blocks[std::make_pair( pos_count, cycle )];
+            if ( ! block->rules_.empty() )
+            {
+                std::cerr << __FILE__ << ' ' << __LINE__
+                          << ": ERROR duplicated block poscount=" << pos_count
+                          << " interceptCycle=" << cycle << std::endl;
+                return false;
+            }
+        }
+        else if ( line_buf.compare( 0, 4, "rule" ) == 0 )
+        {
+            if ( ! block
+                 || block->rules_.size() != block->values_.size() )
+            {
+                std::cerr << __FILE__ << ' ' << __LINE__
+                          << ": ERROR unexpected rule line ["
+                          << line_buf << ']' << std::endl;
+                return false;
+            }
+
+            block->rules_.push_back( std::vector< double >() );
+            if ( ! read_values( line_buf, 4, &block->rules_.back() ) )
+            {
+                std::cerr << __FILE__ << ' ' << __LINE__
+                          << ": ERROR illegal rule line ["
+                          << line_buf << ']' << std::endl;
+                return false;
+            }
+        }
+        else
+        {
+            if ( ! block
+                 || block->rules_.size() != block->values_.size() + 1 )
+            {
+                std::cerr << __FILE__ << ' ' << __LINE__
+                          << ": ERROR unexpected value line ["
+                          << line_buf << ']' << std::endl;
+                return false;
+            }
+
+            block->values_.push_back( std::vector< double >() );
+            if ( ! read_values( line_buf, 0, &block->values_.back() )
+                 || block->values_.back().empty() )
+            {
+                std::cerr << __FILE__ << ' ' << __LINE__
+                          << ": ERROR illegal value line ["
+                          << line_buf << ']' << std::endl;
+                return false;
+            }
+        }
+    }
+
+    if ( blocks.empty() )
+    {
+        std::cerr << __FILE__ << ' ' << __LINE__
+                  << ": ERROR no table." << std::endl;
+        return false;
+    }
+
+    //
+    // check the table size.
+    // all blocks must have the same rules and the same number of values.
+    //
+    const Block & first = blocks.begin()->second;
+
+    table.pos_count_size_ = blocks.rbegin()->first.first + 1;
+    table.cycle_size_ = 0;
+    table.rule_size_ = static_cast< int >( first.rules_.size() );
+    table.step_size_ = ( first.values_.empty()
+                         ? 0
+                         : static_cast< int >( first.values_.front().size() ) );
+    table.rules_ = first.rules_;
+
+    for ( std::map< std::pair< int, int >, Block >::const_iterator it = blocks.begin();
+          it != blocks.end();
+          ++it )
+    {
+        table.cycle_size_ = std::max( table.cycle_size_, it->first.second );
+    }
+
+    if ( static_cast< int >( blocks.size() ) != table.pos_count_size_ * table.cycle_size_
+         || table.rule_size_ == 0
+         || table.step_size_ == 0 )
+    {
+        std::cerr << __FILE__ << ' ' << __LINE__
+                  << ": ERROR missing blocks." << std::endl;
+        return false;
+    }
+
+    table.values_.resize( table.pos_count_size_ * table.cycle_size_ * table.rule_size_ * table.step_size_ );
+
+    for ( std::map< std::pair< int, int >, Block >::const_iterator it = blocks.begin();
+          it != blocks.end();
+          ++it )
+    {
+        const Block & b = it->second;
+        if ( b.rules_ != table.rules_
+             || b.values_.size() != b.rules_.size() )
+        {
+            std::cerr << __FILE__ << ' ' << __LINE__
+                      << ": ERROR illegal rules. poscount=" << it->first.first
+                      << " interceptCycle=" << it->first.second << std::endl;
+            return false;
+        }
+
+        const int block_index = it->first.first * table.cycle_size_ + it->first.second - 1;
+
+        for ( int r = 0; r < table.rule_size_; ++r )
+        {
+            if ( static_cast< int >( b.values_[r].size() ) != table.step_size_ )
+            {
+                std::cerr << __FILE__ << ' ' << __LINE__
+                          << ": ERROR illegal value size. poscount=" << it->first.first
+                          << " interceptCycle=" << it->first.second << std::endl;
+                return false;
+            }
+
+            std::copy( b.values_[r].begin(), b.values_[r].end(),
+                       table.values_.begin() + ( block_index * table.rule_size_ + r ) * table.step_size_ );
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief select the rule of each situation.
+  the rule that has the most matching features is selected.
+  the first one is selected if several rules have the same count.
+ */
+void
+InterceptProbability::create_rule_index( Table & table )
+{
+    table.rule_index_.assign( SITUATION_SIZE, 0 );
+
+    for ( int situation = 0; situation < SITUATION_SIZE; ++situation )
+    {
+        //
+        // the levels of the features. the same order as get_situation().
+        //
+        int levels[DISTANCE_FEATURE + 1];
+        int rest = situation;
+        for ( int id = BODY_FEATURE; id <= DISTANCE_FEATURE; ++id )
+        {
+            levels[id] = rest % id + 1;
+            rest /= id;
+        }
+
+        int best_count = -1;
+        for ( int r = 0; r < table.rule_size_; ++r )
+        {
+            const std::vector< double > & rule = table.rules_[r];
+
+            int count = 0;
+            for ( size_t i = 0; i + 1 < rule.size(); i += 2 )
+            {
+                const int id = static_cast< int >( rule[i] );
+                if ( BODY_FEATURE <= id && id <= DISTANCE_FEATURE
+                     && levels[id] == static_cast< int >( rule[i + 1] ) )
+                {
+                    ++count;
+                }
+            }
+
+            if ( count > best_count )
+            {
+                best_count = count;
+                table.rule_index_[situation] = r;
+            }
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+InterceptProbability::isValid() const
+{
+    for ( int t = 0; t < TYPE_SIZE; ++t )
+    {
+        if ( ! M_tables[t].values_data_ )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \return the block index. -1 if the probability is zero.
+ */
+int
+InterceptProbability::blockIndex( const Table & table,
+                                  const int pos_count,
+                                  const int intercept_cycle,
+                                  int * step ) const
+{
+    if ( ! table.values_data_ )
+    {
+        return -1;
+    }
+
+    int cycle = std::max( 1, intercept_cycle );
+
+    //
+    // the cycles over the table are approximated by shifting the
+    // distribution of the last block.
+    //
+    if ( cycle > table.cycle_size_ )
+    {
+        *step -= cycle - table.cycle_size_;
+        cycle = table.cycle_size_;
+    }
+
+    if ( *step < 1 )
+    {
+        return -1;
+    }
+
+    // the values are cumulative probabilities.
+    *step = std::min( *step, table.step_size_ );
+
+    const int p = std::min( std::max( 0, pos_count ), table.pos_count_size_ - 1 );
+
+    return p * table.cycle_size_ + cycle - 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+InterceptProbability::get_situation( const double body_angle,
+                                     const double ball_speed,
+                                     const double ball_angle,
+                                     const double ball_dist )
+{
+    static const double body_thr[] = { 90.0 };
+    static const double speed_thr[] = { 1.0, 2.0 };
+    static const double angle_thr[] = { 45.0, 90.0, 135.0 };
+    static const double dist_thr[] = { 2.0, 5.0, 10.0, 20.0 };
+
+    // mixed radix number. the radix of each digit is the number of the levels.
+    int situation = get_level( ball_dist, dist_thr, 4 ) - 1;
+    situation = situation * 4 + get_level( ball_angle, angle_thr, 3 ) - 1;
+    situation = situation * 3 + get_level( ball_speed, speed_thr, 2 ) - 1;
+    situation = situation * 2 + get_level( body_angle, body_thr, 1 ) - 1;
+
+    return situation;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+InterceptProbability::probability( const Type type,
+                                   const int pos_count,
+                                   const int intercept_cycle,
+                                   const int situation,
+                                   const int step ) const
+{
+    const Table & table = M_tables[type];
+
+    if ( situation < 0 || SITUATION_SIZE <= situation
+         || table.rule_index_.empty() )
+    {
+        return 0.0;
+    }
+
+    int s = step;
+    const int b = blockIndex( table, pos_count, intercept_cycle, &s );
+    if ( b < 0 )
+    {
+        return 0.0;
+    }
+
+    const int rule = table.rule_index_[situation];
+    return table.values_data_[( b * table.rule_size_ + rule ) * table.step_size_ + s - 1];
+}
@@ -0,0 +1,216 @@
+// -*-c++-*-
+
+/*!
+  \file intercept_probability.h
+  \brief intercept probability table Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+
+#ifndef INTERCEPT_PROBABILITY_H
+#define INTERCEPT_PROBABILITY_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+class SharedDataStore;
+
+/*!
+  \class InterceptProbability
+  \brief the statistical intercept probability tables.
+
+  The tables are read from the files in Options::interceptConfDir():
+  self_probability.txt, teammate_probability.txt and opponent_probability.txt.
+
+  Each file consists of the blocks for the accuracy count of the player
+  ("poscount", omitted in the self file) and the predicted intercept
+  cycle ("interceptCycle"). Each block has the same set of rules, and
+  each rule has the cumulative probability that the player actually
+  intercepts the ball within the n-th cycle.
+
+  The rule header "rule id level id level ... value" is the list of the
+  pairs of the feature id and its level (1, 2, ...), followed by one
+  value that is not used here. In the shipped files, the level of the
+  feature k ranges over [1, k]. The rule of each situation is the rule
+  that has the most matching features. It is looked up from the table
+  indexed by the situation, which is created at load time.
+
+  All values are stored in the flat arrays indexed by
+  [poscount][interceptCycle - 1][rule][n - 1].
+  The flat arrays can be shared with the other processes by SharedDataStore.
+*/
+class InterceptProbability {
+public:
+
+    /*!
+      \brief table type
+     */
+    enum Type {
+        SELF,
+        TEAMMATE,
+        OPPONENT,
+        TYPE_SIZE
+    };
+
+    /*!
+      \brief feature id in the rule header. the value is the number of the levels.
+     */
+    enum Feature {
+        BODY_FEATURE = 2, //!< body angle to the ball: < 90, otherwise
+        BALL_SPEED_FEATURE = 3, //!< ball speed: < 1.0, < 2.0, otherwise
+        BALL_ANGLE_FEATURE = 4, //!< angle between the ball velocity and the player: 45 degree steps
+        DISTANCE_FEATURE = 5 //!< distance to the ball: < 2, < 5, < 10, < 20, otherwise
+    };
+
+    //! the number of the situations (= the combinations of all feature levels)
+    static const int SITUATION_SIZE = 2 * 3 * 4 * 5;
+
+private:
+
+    /*!
+      \brief table of one player category
+     */
+    struct Table {
+        int pos_count_size_;
+        int cycle_size_;
+        int rule_size_;
+        int step_size_;
+        std::vector< std::vector< double > > rules_; //!< rule header values
+        std::vector< double > values_; //!< [poscount][cycle - 1][rule][step - 1]
+        std::vector< int > rule_index_; //!< [situation]. the rule selected in each situation
+
+        //! the values in use. points to values_ or the shared memory.
+        const double * values_data_;
+
+        Table()
+            : pos_count_size_( 0 ),
+              cycle_size_( 0 ),
+              rule_size_( 0 ),
+              step_size_( 0 ),
+              values_data_( static_cast< const double * >( 0 ) )
+          { }
+    };
+
+    Table M_tables[TYPE_SIZE];
+
+    // private for singleton
+    InterceptProbability();
+
+    // not used
+    InterceptProbability( const InterceptProbability & );
+    InterceptProbability & operator=( const InterceptProbability & );
+
+    bool readTable( std::istream & is,
+                    Table & table );
+
+    static
+    void create_rule_index( Table & table );
+
+    int blockIndex( const Table & table,
+                    const int pos_count,
+                    const int intercept_cycle,
+                    int * step ) const;
+
+public:
+
+    static
+    InterceptProbability & instance();
+
+    static
+    const InterceptProbability & i()
+      {
+          return instance();
+      }
+
+    /*!
+      \brief read all table files
+      \param dir the directory that contains the table files
+      \return true if all files are successfully read.
+     */
+    bool read( const std::string & dir );
+
+    /*!
+      \brief get the paths of the table files
+      \param dir the directory that contains the table files
+      \param paths pointer to the result variable. the paths are appended.
+     */
+    static
+    void get_file_paths( const std::string & dir,
+                         std::vector< std::string > * paths );
+
+    /*!
+      \brief use the tables in the shared memory
+      \param store attached data store
+      \return true if all tables are found in the store.
+     */
+    bool attach( const SharedDataStore & store );
+
+    /*!
+      \brief register the tables to the data store to be published
+      \param store data store
+     */
+    void publish( SharedDataStore & store ) const;
+
+    /*!
+      \brief check if the tables are available
+      \return true if all tables have been read.
+     */
+    bool isValid() const;
+
+    /*!
+      \brief get the situation index from the feature values
+      \param body_angle angle between the body direction and the direction to the ball [0, 180]
+      \param ball_speed ball speed
+      \param ball_angle angle between the ball velocity and the direction from the ball to the player [0, 180]
+      \param ball_dist distance between the player and the ball
+      \return situation index [0, SITUATION_SIZE)
+     */
+    static
+    int get_situation( const double body_angle,
+                       const double ball_speed,
+                       const double ball_angle,
+                       const double ball_dist );
+
+    /*!
+      \brief get the probability that the player intercepts the ball
+      within the given cycles.
+      \param type table type
+      \param pos_count accuracy count of the player
+      \param intercept_cycle predicted intercept cycle
+      \param situation situation index given by get_situation()
+      \param step the number of cycles
+      \return probability [0, 1]
+     */
+    double probability( const Type type,
+                        const int pos_count,
+                        const int intercept_cycle,
+                        const int situation,
+                        const int step ) const;
+
+};
+
+#endif
@@ -0,0 +1,242 @@
+// -*-c++-*-
+
+/*!
+  \file intercept_scorer.cpp
+  \brief intercept candidate scoring engine Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "intercept_scorer.h"
+
+#include "intercept_evaluator2013.h"
+
+#include <rcsc/player/world_model.h>
+#include <rcsc/common/logger.h>
+
+// #define DEBUG_PRINT
+
+using namespace rcsc;
+
+namespace {
+
+char
+type_char( const InterceptInfo::ActionType t )
+{
+    switch ( t ) {
+    case InterceptInfo::OMNI_DASH:
+        return 'o';
+    case InterceptInfo::TURN_FORWARD_DASH:
+        return 'f';
+    case InterceptInfo::TURN_BACK_DASH:
+        return 'b';
+    default:
+        break;
+    }
+    return 'u';
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+InterceptScorer::InterceptScorer()
+    : M_update_time( -1, 0 ),
+      M_evaluator( new InterceptEvaluator2013() )
+{
+    M_best_index[0] = M_best_index[1] = -1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+InterceptScorer &
+InterceptScorer::instance()
+{
+    static InterceptScorer s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+InterceptScorer::setEvaluator( InterceptEvaluator::Ptr evaluator )
+{
+    M_evaluator = evaluator;
+    M_update_time = GameTime( -1, 0 );
+    M_best_index[0] = M_best_index[1] = -1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const InterceptInfo *
+InterceptScorer::getBest( const WorldModel & wm,
+                          const bool save_recovery )
+{
+    update( wm );
+
+    const int i = ( save_recovery ? 1 : 0 );
+    return ( M_best_index[i] >= 0
+             ? &M_best[i]
+             : static_cast< const InterceptInfo * >( 0 ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const std::vector< double > &
+InterceptScorer::values( const WorldModel & wm )
+{
+    update( wm );
+    return M_values;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+InterceptScorer::update( const WorldModel & wm )
+{
+    if ( M_update_time == wm.time() )
+    {
+        return;
+    }
+    M_update_time = wm.time();
+
+    M_best_index[0] = M_best_index[1] = -1;
+
+    const std::vector< InterceptInfo > & cache = wm.interceptTable()->selfCache();
+
+    M_values.resize( cache.size() );
+
+    if ( cache.empty()
+         || ! M_evaluator )
+    {
+        return;
+    }
+
+    M_ball_path.update( wm, cache );
+    M_evaluator->evaluateBatch( wm, M_ball_path, cache, &M_values[0] );
+
+    //
+    // the first candidate that has the maximum value
+    //
+    const int size = static_cast< int >( cache.size() );
+    for ( int i = 0; i < size; ++i )
+    {
+        if ( M_best_index[0] < 0
+             || M_values[i] > M_values[M_best_index[0]] )
+        {
+            M_best_index[0] = i;
+        }
+
+        if ( cache[i].staminaType() != InterceptInfo::NORMAL )
+        {
+            continue;
+        }
+
+        if ( M_best_index[1] < 0
+             || M_values[i] > M_values[M_best_index[1]] )
+        {
+            M_best_index[1] = i;
+        }
+    }
+
+    for ( int i = 0; i < 2; ++i )
+    {
+        if ( M_best_index[i] >= 0 )
+        {
+            M_best[i] = cache[M_best_index[i]];
+        }
+    }
+
+#ifdef DEBUG_PRINT
+    writeDebugLog( wm );
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+InterceptScorer::writeDebugLog( const WorldModel & wm ) const
+{
+    if ( ! dlog.isEnabled( Logger::INTERCEPT ) )
+    {
+        return;
+    }
+
+    const std::vector< InterceptInfo > & cache = wm.interceptTable()->selfCache();
+
+    dlog.addText( Logger::INTERCEPT, "==========" );
+    for ( size_t i = 0; i < cache.size(); ++i )
+    {
+        const InterceptInfo & info = cache[i];
+        dlog.addText( Logger::INTERCEPT,
+                      "%d: step=%d: type[%c] (t%d:d%d) turn=%.1f power=%.1f dir=%.1f -- value=%.4f%s",
+                      static_cast< int >( i + 1 ), info.reachCycle(),
+                      type_char( info.actionType() ),
+                      info.turnCycle(), info.dashCycle(),
+                      info.turnAngle(), info.dashPower(), info.dashDir(),
+                      M_values[i],
+                      ( info.staminaType() != InterceptInfo::NORMAL ? " (recovery)" : "" ) );
+    }
+
+    for ( int i = 1; i >= 0; --i )
+    {
+        if ( M_best_index[i] < 0 )
+        {
+            continue;
+        }
+
+        const InterceptInfo * best = &M_best[i];
+
+        dlog.addText( Logger::INTERCEPT, "==========" );
+        dlog.addText( Logger::INTERCEPT,
+                      "best%s: step=%d type[%c](t%d:d%d) power=%.1f dir=%.1f -- value=%.4f",
+                      ( i == 1 ? "(save recovery)" : "" ),
+                      best->reachCycle(),
+                      type_char( best->actionType() ),
+                      best->turnCycle(), best->dashCycle(),
+                      best->dashPower(), best->dashDir(),
+                      M_values[M_best_index[i]] );
+    }
+    dlog.addText( Logger::INTERCEPT, "==========" );
+}
@@ -0,0 +1,128 @@
+// -*-c++-*-
+
+/*!
+  \file intercept_scorer.h
+  \brief intercept candidate scoring engine Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+
+#ifndef INTERCEPT_SCORER_H
+#define INTERCEPT_SCORER_H
+
+#include "intercept_evaluator.h"
+
+#include <rcsc/player/intercept_table.h>
+#include <rcsc/game_time.h>
+
+#include <vector>
+
+namespace rcsc {
+class WorldModel;
+}
+
+/*!
+  \class InterceptScorer
+  \brief select the best self intercept candidate in InterceptTable::selfCache().
+
+  The ball path is computed once per cycle, and all candidates are
+  scored by one InterceptEvaluator::evaluateBatch() call. The results
+  for both save_recovery modes are cached until the next cycle, so the
+  behaviors that call Body_Intercept2013::get_best_intercept() in the
+  same cycle share them.
+
+  The evaluation function is replaceable. InterceptEvaluator2013 is
+  used by default.
+*/
+class InterceptScorer {
+private:
+
+    rcsc::GameTime M_update_time;
+
+    InterceptEvaluator::Ptr M_evaluator;
+
+    InterceptEvaluator::BallPath M_ball_path;
+
+    //! evaluation values. index = the index of selfCache()
+    std::vector< double > M_values;
+
+    //! the index of the best candidates. -1 if no candidate. index = save_recovery
+    int M_best_index[2];
+
+    //! copy of the best candidates. index = save_recovery
+    rcsc::InterceptInfo M_best[2];
+
+    // private for singleton
+    InterceptScorer();
+
+    // not used
+    InterceptScorer( const InterceptScorer & );
+    InterceptScorer & operator=( const InterceptScorer & );
+
+public:
+
+    static
+    InterceptScorer & instance();
+
+    /*!
+      \brief set the evaluation function. the cached result is cleared.
+      \param evaluator new evaluator
+     */
+    void setEvaluator( InterceptEvaluator::Ptr evaluator );
+
+    /*!
+      \brief get the evaluation function
+      \return evaluator pointer
+     */
+    const InterceptEvaluator::Ptr & evaluator() const
+      {
+          return M_evaluator;
+      }
+
+    /*!
+      \brief get the best candidate in this cycle
+      \param wm world model
+      \param save_recovery if true, the candidates that lose the recovery are ignored.
+      \return pointer to the copy of the best candidate. NULL if no candidate.
+     */
+    const rcsc::InterceptInfo * getBest( const rcsc::WorldModel & wm,
+                                         const bool save_recovery );
+
+    /*!
+      \brief get the evaluation values in this cycle
+      \param wm world model
+      \return the values. same order as selfCache().
+     */
+    const std::vector< double > & values( const rcsc::WorldModel & wm );
+
+private:
+
+    void update( const rcsc::WorldModel & wm );
+
+    void writeDebugLog( const rcsc::WorldModel & wm ) const;
+};
+
+#endif
@@ -0,0 +1,105 @@
+// -*-c++-*-
+
+/*!
+  \file main_chain_benchmark.cpp
+  \brief offline replay driver of the action chain search benchmark
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "helios_player.h"
+
+#include <rcsc/common/abstract_client.h>
+#include <rcsc/param/cmd_line_parser.h>
+
+#include <iostream>
+#include <vector>
+#include <cstdlib> // exit
+#include <cstring> // strcmp
+
+/*
+  The offline client log (<team>-<unum>.ocl in the log directory) recorded
+  by --offline_logging is replayed without the server. The world model is
+  rebuilt from the recorded messages, and all searchers of
+  ActionChainBenchmark are applied to the same root state in every cycle.
+  The summary is printed when the log ends.
+
+  usage:
+    helios_chain_benchmark --offline_client_number UNUM [player options]
+ */
+
+namespace {
+
+HeliosPlayer agent;
+boost::shared_ptr< rcsc::AbstractClient > client;
+
+}
+
+/*-------------------------------------------------------------------*/
+int
+main( int argc, char **argv )
+{
+    bool offline = false;
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( ! std::strcmp( argv[i], "--offline_client_number" ) )
+        {
+            offline = true;
+        }
+    }
+
+    if ( ! offline )
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " --offline_client_number UNUM [player options]\n"
+                  << "  replays the offline client log of the player UNUM"
+                  << " and compares all action chain search algorithms."
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector< char * > args( argv, argv + argc );
+    char benchmark_opt[] = "--chain-search-benchmark";
+    args.push_back( benchmark_opt );
+
+    {
+        rcsc::CmdLineParser cmd_parser( static_cast< int >( args.size() ), &args[0] );
+        if ( ! agent.init( cmd_parser ) )
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    client = agent.createConsoleClient();
+    agent.setClient( client );
+
+    client->run( &agent );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,105 @@
+// -*-c++-*-
+
+/*!
+  \file mutex.h
+  \brief pthread mutex wrapper Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+#ifndef HELIOS_MUTEX_H
+#define HELIOS_MUTEX_H
+
+#include <pthread.h>
+
+/*!
+  \class Mutex
+  \brief non-recursive mutex object
+*/
+class Mutex {
+private:
+
+    pthread_mutex_t M_mutex;
+
+    // not used
+    Mutex( const Mutex & );
+    Mutex & operator=( const Mutex & );
+
+public:
+
+    Mutex()
+      {
+          pthread_mutex_init( &M_mutex, NULL );
+      }
+
+    ~Mutex()
+      {
+          pthread_mutex_destroy( &M_mutex );
+      }
+
+    void lock()
+      {
+          pthread_mutex_lock( &M_mutex );
+      }
+
+    void unlock()
+      {
+          pthread_mutex_unlock( &M_mutex );
+      }
+
+    pthread_mutex_t * native()
+      {
+          return &M_mutex;
+      }
+};
+
+/*!
+  \class ScopedLock
+  \brief lock the mutex while this object is alive
+*/
+class ScopedLock {
+private:
+
+    Mutex & M_mutex;
+
+    // not used
+    ScopedLock( const ScopedLock & );
+    ScopedLock & operator=( const ScopedLock & );
+
+public:
+
+    explicit
+    ScopedLock( Mutex & m )
+        : M_mutex( m )
+      {
+          M_mutex.lock();
+      }
+
+    ~ScopedLock()
+      {
+          M_mutex.unlock();
+      }
+};
+
+#endif
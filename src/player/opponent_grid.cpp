@@ -0,0 +1,347 @@
+// -*-c++-*-
+
+/*!
+  \file opponent_grid.cpp
+  \brief uniform grid of the opponent players Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "opponent_grid.h"
+
+#include <rcsc/player/world_model.h>
+#include <rcsc/player/abstract_player_object.h>
+#include <rcsc/common/player_type.h>
+#include <rcsc/common/logger.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace rcsc;
+
+namespace {
+
+//
+// the grid covers the pitch and the area around it.
+// the players out of the area are registered to the border cells.
+//
+const double GRID_MIN_X = -60.0;
+const double GRID_MIN_Y = -40.0;
+const double CELL_SIZE = 10.0;
+const int GRID_COLUMNS = 12;
+const int GRID_ROWS = 8;
+
+// buffer for the rounding error of the trajectory accumulation
+const double DIST_BUF = 0.01;
+
+/*-------------------------------------------------------------------*/
+inline
+int
+cell_x( const double x )
+{
+    return std::min( GRID_COLUMNS - 1,
+                     std::max( 0, static_cast< int >( std::floor( ( x - GRID_MIN_X ) / CELL_SIZE ) ) ) );
+}
+
+/*-------------------------------------------------------------------*/
+inline
+int
+cell_y( const double y )
+{
+    return std::min( GRID_ROWS - 1,
+                     std::max( 0, static_cast< int >( std::floor( ( y - GRID_MIN_Y ) / CELL_SIZE ) ) ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \return squared distance from the point to the segment
+ */
+inline
+double
+segment_dist2( const Vector2D & start,
+               const Vector2D & end,
+               const Vector2D & point )
+{
+    const double dx = end.x - start.x;
+    const double dy = end.y - start.y;
+    const double len2 = dx * dx + dy * dy;
+
+    double t = 0.0;
+    if ( len2 > 1.0e-10 )
+    {
+        t = ( ( point.x - start.x ) * dx + ( point.y - start.y ) * dy ) / len2;
+        t = std::min( 1.0, std::max( 0.0, t ) );
+    }
+
+    const double px = start.x + dx * t - point.x;
+    const double py = start.y + dy * t - point.y;
+    return px * px + py * py;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+OpponentGrid::OpponentGrid()
+    : M_update_time( -1, 0 ),
+      M_overflow( false ),
+      M_max_speed( 0.0 ),
+      M_max_inertia_move( 0.0 ),
+      M_max_pos_count( 0 ),
+      M_max_kickable_area( 0.0 ),
+      M_cell_start( GRID_COLUMNS * GRID_ROWS + 1, 0 ),
+      M_query_count( 0 ),
+      M_check_count( 0 ),
+      M_skip_count( 0 )
+{
+    M_entries.reserve( MAX_ENTRY );
+    M_cell_items.reserve( MAX_ENTRY );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+OpponentGrid::update( const WorldModel & wm )
+{
+    M_update_time = wm.time();
+
+    M_entries.clear();
+    M_overflow = false;
+    M_max_speed = 0.0;
+    M_max_inertia_move = 0.0;
+    M_max_pos_count = 0;
+    M_max_kickable_area = 0.0;
+    M_query_count = 0;
+    M_check_count = 0;
+    M_skip_count = 0;
+
+    for ( AbstractPlayerObject::Cont::const_iterator p = wm.theirPlayers().begin(),
+              end = wm.theirPlayers().end();
+          p != end;
+          ++p )
+    {
+        if ( M_entries.size() >= MAX_ENTRY )
+        {
+            M_overflow = true;
+            break;
+        }
+
+        const AbstractPlayerObject * pl = *p;
+        const PlayerType * ptype = pl->playerTypePtr();
+
+        Entry e;
+        e.player_ = pl;
+        e.pos_ = pl->pos();
+        e.speed_ = ptype->realSpeedMax();
+        e.pos_count_ = pl->posCount();
+
+        //
+        // the generators use either pos() or the fresher seenPos() as
+        // the base point, and move it by vel() or seenVel().
+        // the movement by the inertia never exceeds speed / ( 1 - decay ).
+        //
+        double seen_move = 0.0;
+        if ( pl->seenPosCount() <= pl->posCount() )
+        {
+            e.pos_ = pl->seenPos();
+            seen_move = pl->seenPos().dist( pl->pos() );
+        }
+
+        double speed = pl->vel().r();
+        if ( pl->seenVelCount() <= pl->velCount() )
+        {
+            speed = std::max( speed, pl->seenVel().r() );
+        }
+
+        e.inertia_move_ = seen_move + speed / ( 1.0 - ptype->playerDecay() ) + DIST_BUF;
+
+        M_entries.push_back( e );
+
+        M_max_speed = std::max( M_max_speed, e.speed_ );
+        M_max_inertia_move = std::max( M_max_inertia_move, e.inertia_move_ );
+        M_max_pos_count = std::max( M_max_pos_count, e.pos_count_ );
+        M_max_kickable_area = std::max( M_max_kickable_area, ptype->kickableArea() );
+    }
+
+    //
+    // counting sort by cell
+    //
+    const int cell_size = GRID_COLUMNS * GRID_ROWS;
+    std::vector< int > cells( M_entries.size() );
+
+    std::fill( M_cell_start.begin(), M_cell_start.end(), 0 );
+    for ( size_t i = 0; i < M_entries.size(); ++i )
+    {
+        cells[i] = cell_x( M_entries[i].pos_.x ) * GRID_ROWS + cell_y( M_entries[i].pos_.y );
+        M_cell_start[cells[i] + 1] += 1;
+    }
+
+    for ( int c = 0; c < cell_size; ++c )
+    {
+        M_cell_start[c + 1] += M_cell_start[c];
+    }
+
+    std::vector< int > fill( M_cell_start.begin(), M_cell_start.end() - 1 );
+    M_cell_items.resize( M_entries.size() );
+    for ( size_t i = 0; i < M_entries.size(); ++i )
+    {
+        M_cell_items[ fill[cells[i]]++ ] = static_cast< int >( i );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+OpponentGrid::isValid( const WorldModel & wm ) const
+{
+    return M_update_time == wm.time();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+OpponentGrid::Mask
+OpponentGrid::query( const Vector2D & start,
+                     const Vector2D & end,
+                     const double step,
+                     const int count_cap,
+                     const double margin ) const
+{
+    if ( M_entries.empty() )
+    {
+        return 0;
+    }
+
+    //
+    // the cells overlapped with the bounding box expanded by the maximum radius
+    //
+    const double max_radius = margin
+        + M_max_inertia_move
+        + M_max_speed * ( step + std::min( M_max_pos_count, count_cap ) );
+
+    const int min_cx = cell_x( std::min( start.x, end.x ) - max_radius );
+    const int max_cx = cell_x( std::max( start.x, end.x ) + max_radius );
+    const int min_cy = cell_y( std::min( start.y, end.y ) - max_radius );
+    const int max_cy = cell_y( std::max( start.y, end.y ) + max_radius );
+
+    Mask mask = 0;
+
+    for ( int cx = min_cx; cx <= max_cx; ++cx )
+    {
+        for ( int cy = min_cy; cy <= max_cy; ++cy )
+        {
+            const int c = cx * GRID_ROWS + cy;
+            for ( int k = M_cell_start[c]; k < M_cell_start[c + 1]; ++k )
+            {
+                const int i = M_cell_items[k];
+                const Entry & e = M_entries[i];
+                const double radius = margin
+                    + e.inertia_move_
+                    + e.speed_ * ( step + std::min( e.pos_count_, count_cap ) );
+
+                if ( segment_dist2( start, end, e.pos_ ) <= radius * radius )
+                {
+                    mask |= ( static_cast< Mask >( 1 ) << i );
+                }
+            }
+        }
+    }
+
+    return mask;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+OpponentGrid::contains( const Mask mask,
+                        const AbstractPlayerObject * player ) const
+{
+    for ( size_t i = 0; i < M_entries.size(); ++i )
+    {
+        if ( M_entries[i].player_ == player )
+        {
+            return contains( mask, i );
+        }
+    }
+
+    // not registered
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+OpponentGrid::addSkipCount( const int check_count,
+                            const int skip_count ) const
+{
+    // the generators may run on the worker threads only if the debug
+    // log is disabled. the counters are updated only in the single
+    // thread mode.
+    if ( ! dlog.isEnabled( Logger::ANALYZER ) )
+    {
+        return;
+    }
+
+    M_query_count += 1;
+    M_check_count += check_count;
+    M_skip_count += skip_count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+OpponentGrid::writeDebugLog() const
+{
+    if ( M_query_count == 0 )
+    {
+        return;
+    }
+
+    dlog.addText( Logger::ANALYZER,
+                  "OpponentGrid: opponents=%d%s queries=%d checks=%d skipped=%d (%.1f%%)",
+                  static_cast< int >( M_entries.size() ),
+                  ( M_overflow ? "(overflow)" : "" ),
+                  M_query_count, M_check_count, M_skip_count,
+                  ( M_check_count > 0
+                    ? 100.0 * M_skip_count / M_check_count
+                    : 0.0 ) );
+}
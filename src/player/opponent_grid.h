@@ -0,0 +1,185 @@
+// -*-c++-*-
+
+/*!
+  \file opponent_grid.h
+  \brief uniform grid of the opponent players Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef OPPONENT_GRID_H
+#define OPPONENT_GRID_H
+
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/game_time.h>
+
+#include <boost/cstdint.hpp>
+
+#include <vector>
+
+namespace rcsc {
+class AbstractPlayerObject;
+class WorldModel;
+}
+
+/*!
+  \class OpponentGrid
+  \brief broad phase index of the opponent players.
+
+  The opponents in WorldModel::theirPlayers() are registered to the
+  uniform grid every cycle. The index of each opponent is same as the
+  order in WorldModel::theirPlayers().
+
+  The query returns the bit mask of the opponents that may reach the
+  swept capsule (the ball move segment with the radius) within the
+  given steps. The radius of each opponent is
+
+    margin + inertia_move + real_speed_max * ( step + min( pos_count, count_cap ) )
+
+  where inertia_move is the upper bound of the movement by the current
+  velocity. The caller gives the margin and the step such that the
+  opponents out of the radius are never considered in its own check.
+*/
+class OpponentGrid {
+public:
+
+    enum {
+        MAX_ENTRY = 32, //!< the maximum number of indexed opponents
+        NO_COUNT_CAP = 0x7fffffff //!< count_cap value for no limitation
+    };
+
+    typedef boost::uint32_t Mask; //!< candidate bit mask type
+
+private:
+
+    /*!
+      \brief opponent data
+     */
+    struct Entry {
+        const rcsc::AbstractPlayerObject * player_;
+        rcsc::Vector2D pos_;
+        double speed_; //!< real speed max
+        double inertia_move_; //!< upper bound of the inertia movement
+        int pos_count_;
+    };
+
+    rcsc::GameTime M_update_time;
+
+    std::vector< Entry > M_entries;
+    bool M_overflow; //!< true if the opponents more than MAX_ENTRY exist
+
+    double M_max_speed;
+    double M_max_inertia_move;
+    int M_max_pos_count;
+    double M_max_kickable_area;
+
+    //! indices of entries sorted by cell. (compressed row storage)
+    std::vector< int > M_cell_start;
+    std::vector< int > M_cell_items;
+
+    mutable int M_query_count; //!< the number of queries in this cycle
+    mutable int M_check_count; //!< the number of opponent checks requested in this cycle
+    mutable int M_skip_count; //!< the number of opponent checks skipped in this cycle
+
+    // not used
+    OpponentGrid( const OpponentGrid & );
+    OpponentGrid & operator=( const OpponentGrid & );
+
+public:
+
+    OpponentGrid();
+
+    /*!
+      \brief rebuild the grid
+      \param wm world model
+     */
+    void update( const rcsc::WorldModel & wm );
+
+    /*!
+      \brief check if the grid is built for the current cycle
+      \param wm world model
+      \return true if the query result can be used
+     */
+    bool isValid( const rcsc::WorldModel & wm ) const;
+
+    double maxKickableArea() const
+      {
+          return M_max_kickable_area;
+      }
+
+    /*!
+      \brief get the candidate opponents
+      \param start the start point of the ball move segment
+      \param end the end point of the ball move segment
+      \param step the number of steps the opponents can move
+      \param count_cap the maximum accuracy count added to the steps
+      \param margin distance added to the radius
+      \return the bit mask of the candidate opponents
+     */
+    Mask query( const rcsc::Vector2D & start,
+                const rcsc::Vector2D & end,
+                const double step,
+                const int count_cap,
+                const double margin ) const;
+
+    /*!
+      \brief check the result of query by the index of WorldModel::theirPlayers()
+      \param mask query result
+      \param index the index of the opponent
+      \return true if the opponent is a candidate
+     */
+    bool contains( const Mask mask,
+                   const size_t index ) const
+      {
+          return ( index >= MAX_ENTRY
+                   || ( mask & ( static_cast< Mask >( 1 ) << index ) ) != 0 );
+      }
+
+    /*!
+      \brief check the result of query by the player object
+      \param mask query result
+      \param player the opponent player
+      \return true if the opponent is a candidate or not registered in the grid
+     */
+    bool contains( const Mask mask,
+                   const rcsc::AbstractPlayerObject * player ) const;
+
+    /*!
+      \brief record one query and the number of the checked and skipped opponents.
+      the counters are updated only if the debug log is enabled.
+      \param check_count the number of opponents to be checked without the grid
+      \param skip_count the number of opponents skipped by the grid
+     */
+    void addSkipCount( const int check_count,
+                       const int skip_count ) const;
+
+    /*!
+      \brief write the counters of the current cycle
+     */
+    void writeDebugLog() const;
+
+};
+
+#endif
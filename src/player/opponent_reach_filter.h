@@ -0,0 +1,112 @@
+// -*-c++-*-
+
+/*!
+  \file opponent_reach_filter.h
+  \brief opponent reach filter shared by the pass and shoot generators
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef OPPONENT_REACH_FILTER_H
+#define OPPONENT_REACH_FILTER_H
+
+#include <rcsc/player/world_model.h>
+#include <rcsc/common/logger.h>
+
+#include <boost/cstdint.hpp>
+
+#include <iostream>
+
+//! if defined, the generators compare the elapsed time with and without the filter in every cycle.
+// #define DEBUG_PROFILE_OPPONENT_FILTER
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief mark the steps at which the opponent may reach the ball.
+  All arrays are indexed by the ball move step.
+  \param opponent_x opponent x coordinate after the inertia move
+  \param opponent_y opponent y coordinate after the inertia move
+  \param reach_dist2 squared reachable distance of the opponent
+  \param ball_x ball x coordinate
+  \param ball_y ball y coordinate
+  \param first_step the first step to be checked
+  \param last_step the last step to be checked (included)
+  \param reach pointer to the result flags. 1 if the opponent may reach the ball.
+  \return the number of marked steps
+ */
+inline
+int
+mark_opponent_reach_steps( const double * opponent_x,
+                           const double * opponent_y,
+                           const double * reach_dist2,
+                           const double * ball_x,
+                           const double * ball_y,
+                           const int first_step,
+                           const int last_step,
+                           unsigned char * reach )
+{
+    // no branch in the loop body, so that the compiler can vectorize it.
+    int count = 0;
+    for ( int step = first_step; step <= last_step; ++step )
+    {
+        const double dx = opponent_x[step] - ball_x[step];
+        const double dy = opponent_y[step] - ball_y[step];
+        const int flag = ( dx * dx + dy * dy <= reach_dist2[step] );
+        reach[step] = static_cast< unsigned char >( flag );
+        count += flag;
+    }
+    return count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief record the result of benchmarkOpponentFilter() in the generators.
+  \param generator_name name of the generator
+  \param log_level debug log level
+  \param wm world model
+  \param elapsed elapsed time without [0] and with [1] the filter
+  \param size the number of the created courses
+  \param same true if the filter did not change the result
+ */
+inline
+void
+print_opponent_filter_benchmark( const char * generator_name,
+                                 const boost::int32_t log_level,
+                                 const rcsc::WorldModel & wm,
+                                 const double * elapsed,
+                                 const size_t size,
+                                 const bool same )
+{
+    rcsc::dlog.addText( log_level,
+                        "(%s::benchmarkOpponentFilter) PROFILE scalar=%.3f [ms] filter=%.3f [ms] size=%zd same=%d",
+                        generator_name, elapsed[0], elapsed[1], size, ( same ? 1 : 0 ) );
+    if ( ! same )
+    {
+        std::cerr << wm.teamName() << ' ' << wm.self().unum() << ' ' << wm.time()
+                  << ": (" << generator_name << ") the opponent reach filter changed the result." << std::endl;
+    }
+}
+
+#endif
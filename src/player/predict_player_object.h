@@ -190,10 +190,10 @@ public:
       \brief set positon
       \param p new position
      */
-    // void setPos( const rcsc::Vector2D & p )
-    //   {
-    //       M_pos = p;
-    //   }
+    void setPos( const rcsc::Vector2D & p )
+      {
+          M_pos = p;
+      }
 
     // // ------------------------------------------
     // /*!
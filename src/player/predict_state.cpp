@@ -43,11 +43,47 @@
 #include <rcsc/common/server_param.h>
 
 #include <algorithm>
+#include <new>
 
 using namespace rcsc;
 
 const int PredictState::VALID_PLAYER_THRESHOLD = 8;
 
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief compare the accuracy of the player position
+ */
+struct PosCountCmp {
+    bool operator()( const AbstractPlayerObject * lhs,
+                     const AbstractPlayerObject * rhs ) const
+      {
+          return lhs->posCount() < rhs->posCount();
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief select the players stored in the state.
+  If the world model has more players than the capacity of the state,
+  the players with the older position information are dropped.
+ */
+void
+select_players( const AbstractPlayerObject::Cont & players,
+                AbstractPlayerObject::Cont & result )
+{
+    result = players;
+
+    if ( result.size() > static_cast< size_t >( PredictState::MAX_PLAYER_SIZE ) )
+    {
+        std::stable_sort( result.begin(), result.end(), PosCountCmp() );
+        result.resize( PredictState::MAX_PLAYER_SIZE );
+    }
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -57,10 +93,12 @@ PredictState::PredictState()
       M_current_time( 1, 0 ),
       M_spent_time( 0 ),
       M_ball(),
-      M_self( new PredictPlayerObject() ),
-      M_our_players(),
-      M_their_players(),
-      M_ball_holder( new PredictPlayerObject() ),
+      M_player_table( new std::vector< PredictPlayerObject >( 1 ) ),
+      M_self( &M_player_table->front() ),
+      M_our_players_size( 0 ),
+      M_their_players_size( 0 ),
+      M_ball_holder( M_self ),
+      M_moved_players_size( 0 ),
       M_offside_line_x( 0.0 ),
       M_our_defense_line_x( 0.0 ),
       M_our_offense_player_line_x( 0.0 ),
@@ -78,16 +116,18 @@ PredictState::PredictState( const PredictState & rhs )
       M_current_time( rhs.M_current_time ),
       M_spent_time( rhs.M_spent_time ),
       M_ball( rhs.M_ball ),
-      M_self( rhs.M_self ),
-      M_our_players( rhs.M_our_players ),
-      M_their_players( rhs.M_their_players ),
-      M_ball_holder( rhs.M_ball_holder ),
+      M_player_table(),
+      M_self( static_cast< const PredictPlayerObject * >( 0 ) ),
+      M_our_players_size( 0 ),
+      M_their_players_size( 0 ),
+      M_ball_holder( static_cast< const PredictPlayerObject * >( 0 ) ),
+      M_moved_players_size( 0 ),
       M_offside_line_x( 0.0 ),
       M_our_defense_line_x( 0.0 ),
       M_our_offense_player_line_x( 0.0 ),
       M_their_defense_player_line_x( 0.0 )
 {
-
+    copyPlayers( rhs );
 }
 
 /*-------------------------------------------------------------------*/
@@ -99,10 +139,12 @@ PredictState::PredictState( const WorldModel & wm )
       M_current_time( wm.time() ),
       M_spent_time( 0 ),
       M_ball( wm.ball().pos(), wm.ball().vel() ),
-      M_self(),
-      M_our_players(),
-      M_their_players(),
-      M_ball_holder(),
+      M_player_table(),
+      M_self( static_cast< const PredictPlayerObject * >( 0 ) ),
+      M_our_players_size( 0 ),
+      M_their_players_size( 0 ),
+      M_ball_holder( static_cast< const PredictPlayerObject * >( 0 ) ),
+      M_moved_players_size( 0 ),
       M_offside_line_x( 0.0 ),
       M_our_defense_line_x( 0.0 ),
       M_our_offense_player_line_x( 0.0 ),
@@ -122,16 +164,48 @@ PredictState::PredictState( const WorldModel & wm )
     }
 
     //
-    // initialize self, our players, ball holder
+    // create the player table.
+    // all player instances are allocated at once, and they are shared by all states in the search tree.
+    // the last element is used as self only if self is not found in our players.
     //
-    M_our_players.reserve( wm.ourPlayers().size() );
+    AbstractPlayerObject::Cont our_players;
+    AbstractPlayerObject::Cont their_players;
+    select_players( wm.ourPlayers(), our_players );
+    select_players( wm.theirPlayers(), their_players );
 
-    for ( AbstractPlayerObject::Cont::const_iterator p = wm.ourPlayers().begin(), end = wm.ourPlayers().end();
+    boost::shared_ptr< std::vector< PredictPlayerObject > > table( new std::vector< PredictPlayerObject >() );
+    table->reserve( our_players.size() + their_players.size() + 1 );
+
+    for ( AbstractPlayerObject::Cont::const_iterator p = our_players.begin(), end = our_players.end();
           p != end;
           ++p )
     {
-        PredictPlayerObject::Ptr ptr( new PredictPlayerObject( **p ) );
-        M_our_players.push_back( ptr );
+        table->push_back( PredictPlayerObject( **p ) );
+    }
+
+    for ( AbstractPlayerObject::Cont::const_iterator p = their_players.begin(), end = their_players.end();
+          p != end;
+          ++p )
+    {
+        table->push_back( PredictPlayerObject( **p ) );
+    }
+
+    table->push_back( PredictPlayerObject( wm.self() ) );
+
+    M_player_table = table;
+
+    //
+    // initialize self, our players, ball holder
+    //
+    const std::vector< PredictPlayerObject > & players = *M_player_table;
+    size_t index = 0;
+
+    for ( AbstractPlayerObject::Cont::const_iterator p = our_players.begin(), end = our_players.end();
+          p != end;
+          ++p, ++index )
+    {
+        const PredictPlayerObject * ptr = &players[index];
+        M_our_players[M_our_players_size++] = ptr;
 
         if ( holder == *p )
         {
@@ -146,7 +220,7 @@ PredictState::PredictState( const WorldModel & wm )
 
     if ( ! M_self )
     {
-        M_self = PredictPlayerObject::Ptr( new PredictPlayerObject( wm.self() ) );
+        M_self = &players.back();
     }
 
     if ( ! M_ball_holder )
@@ -157,12 +231,9 @@ PredictState::PredictState( const WorldModel & wm )
     //
     // initialize their players
     //
-    for ( AbstractPlayerObject::Cont::const_iterator p = wm.theirPlayers().begin(), end = wm.theirPlayers().end();
-          p != end;
-          ++p )
+    for ( size_t i = 0; i < their_players.size(); ++i, ++index )
     {
-        PredictPlayerObject::Ptr ptr( new PredictPlayerObject( **p ) );
-        M_their_players.push_back( ptr );
+        M_their_players[M_their_players_size++] = &players[index];
     }
 
     //
@@ -185,16 +256,18 @@ PredictState::PredictState( const PredictState & rhs,
       M_current_time( rhs.currentTime() ),
       M_spent_time( rhs.spentTime() + append_spent_time ),
       M_ball( rhs.M_ball ),
-      M_self( rhs.M_self ),
-      M_our_players( rhs.M_our_players ),
-      M_their_players( rhs.M_their_players ),
-      M_ball_holder( rhs.M_ball_holder ),
+      M_player_table(),
+      M_self( static_cast< const PredictPlayerObject * >( 0 ) ),
+      M_our_players_size( 0 ),
+      M_their_players_size( 0 ),
+      M_ball_holder( static_cast< const PredictPlayerObject * >( 0 ) ),
+      M_moved_players_size( 0 ),
       M_offside_line_x( rhs.M_offside_line_x ),
       M_our_defense_line_x( rhs.M_our_defense_line_x ),
       M_our_offense_player_line_x( rhs.M_our_offense_player_line_x ),
       M_their_defense_player_line_x( rhs.M_their_defense_player_line_x )
 {
-
+    copyPlayers( rhs );
 }
 
 /*-------------------------------------------------------------------*/
@@ -209,42 +282,32 @@ PredictState::PredictState( const PredictState & rhs,
       M_current_time( rhs.M_current_time ),
       M_spent_time( rhs.M_spent_time + append_spent_time ),
       M_ball( ball_and_holder_pos ),
-      M_self( rhs.M_self ),
-      M_our_players( rhs.M_our_players ),
-      M_their_players( rhs.M_their_players ),
-      M_ball_holder(),
+      M_player_table(),
+      M_self( static_cast< const PredictPlayerObject * >( 0 ) ),
+      M_our_players_size( 0 ),
+      M_their_players_size( 0 ),
+      M_ball_holder( static_cast< const PredictPlayerObject * >( 0 ) ),
+      M_moved_players_size( 0 ),
       M_offside_line_x( std::max( rhs.M_offside_line_x, ball_and_holder_pos.x ) ),
       M_our_defense_line_x( rhs.M_our_defense_line_x ),
       M_our_offense_player_line_x( std::max( rhs.M_our_offense_player_line_x,
                                              ball_and_holder_pos.x ) ),
       M_their_defense_player_line_x( rhs.M_their_defense_player_line_x )
 {
+    copyPlayers( rhs );
+
     if ( 1 <= ball_holder_unum && ball_holder_unum <= 11 )
     {
-        for ( PredictPlayerObject::Cont::iterator p = M_our_players.begin(), end = M_our_players.end();
-              p != end;
-              ++p )
+        for ( size_t i = 0; i < M_our_players_size; ++i )
         {
-            if ( (*p)->unum() == ball_holder_unum )
+            if ( M_our_players[i]->unum() == ball_holder_unum )
             {
-                PredictPlayerObject::Ptr ptr( new PredictPlayerObject( **p, ball_and_holder_pos ) );
-
-                *p = ptr;
-                M_ball_holder = ptr;
-                if ( M_self->unum() == ball_holder_unum )
-                {
-                    M_self = ptr;
-                }
+                M_ball_holder = movePlayer( M_our_players[i], ball_and_holder_pos );
                 break;
             }
         }
     }
 
-    if ( ! M_ball_holder )
-    {
-        M_ball_holder = rhs.M_ball_holder;
-    }
-
     predictPlayerPositions();
     updateLines();
 }
@@ -260,19 +323,223 @@ PredictState::PredictState( const PredictState & rhs,
       M_current_time( rhs.M_current_time ),
       M_spent_time( rhs.M_spent_time + append_spent_time ),
       M_ball( ball_pos ),
-      M_self( rhs.M_self ),
-      M_our_players( rhs.M_our_players ),
-      M_their_players( rhs.M_their_players ),
-      M_ball_holder( rhs.M_ball_holder ),
+      M_player_table(),
+      M_self( static_cast< const PredictPlayerObject * >( 0 ) ),
+      M_our_players_size( 0 ),
+      M_their_players_size( 0 ),
+      M_ball_holder( static_cast< const PredictPlayerObject * >( 0 ) ),
+      M_moved_players_size( 0 ),
       M_offside_line_x( std::max( rhs.M_offside_line_x, ball_pos.x ) ),
       M_our_defense_line_x( rhs.M_our_defense_line_x ),
       M_our_offense_player_line_x( rhs.M_our_offense_player_line_x ),
       M_their_defense_player_line_x( rhs.M_their_defense_player_line_x )
 {
+    copyPlayers( rhs );
+
     predictPlayerPositions();
     updateLines();
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+PredictState::~PredictState()
+{
+    clearMovedPlayers();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PredictState::copyPlayers( const PredictState & rhs )
+{
+    M_player_table = rhs.M_player_table;
+
+    for ( size_t i = 0; i < rhs.M_moved_players_size; ++i )
+    {
+        new ( &M_moved_players[i] ) PredictPlayerObject( *rhs.movedPlayer( i ) );
+    }
+    M_moved_players_size = rhs.M_moved_players_size;
+
+    M_self = relocate( rhs, rhs.M_self );
+    M_ball_holder = relocate( rhs, rhs.M_ball_holder );
+
+    M_our_players_size = rhs.M_our_players_size;
+    for ( size_t i = 0; i < M_our_players_size; ++i )
+    {
+        M_our_players[i] = relocate( rhs, rhs.M_our_players[i] );
+    }
+
+    M_their_players_size = rhs.M_their_players_size;
+    for ( size_t i = 0; i < M_their_players_size; ++i )
+    {
+        M_their_players[i] = relocate( rhs, rhs.M_their_players[i] );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const PredictPlayerObject *
+PredictState::relocate( const PredictState & rhs,
+                        const PredictPlayerObject * player ) const
+{
+    // the players in the overlay of rhs are replaced by the copied ones.
+    for ( size_t i = 0; i < rhs.M_moved_players_size; ++i )
+    {
+        if ( player == rhs.movedPlayer( i ) )
+        {
+            return movedPlayer( i );
+        }
+    }
+
+    return player;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const PredictPlayerObject *
+PredictState::movePlayer( const PredictPlayerObject * player,
+                          const Vector2D & pos )
+{
+    PredictPlayerObject * moved = static_cast< PredictPlayerObject * >( 0 );
+
+    for ( size_t i = 0; i < M_moved_players_size; ++i )
+    {
+        if ( player == movedPlayer( i ) )
+        {
+            moved = movedPlayer( i );
+            break;
+        }
+    }
+
+    if ( ! moved )
+    {
+        if ( M_moved_players_size >= static_cast< size_t >( MAX_MOVED_PLAYER_SIZE ) )
+        {
+            // no room in the overlay.
+            // the player table is copied, and the overlay is merged into the new table.
+            rebuildPlayerTable( &player );
+        }
+
+        moved = movedPlayer( M_moved_players_size );
+        new ( moved ) PredictPlayerObject( *player );
+        ++M_moved_players_size;
+    }
+
+    moved->setPos( pos );
+
+    for ( size_t i = 0; i < M_our_players_size; ++i )
+    {
+        if ( M_our_players[i] == player ) M_our_players[i] = moved;
+    }
+
+    for ( size_t i = 0; i < M_their_players_size; ++i )
+    {
+        if ( M_their_players[i] == player ) M_their_players[i] = moved;
+    }
+
+    if ( M_self == player ) M_self = moved;
+    if ( M_ball_holder == player ) M_ball_holder = moved;
+
+    return moved;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PredictState::rebuildPlayerTable( const PredictPlayerObject ** player )
+{
+    boost::shared_ptr< std::vector< PredictPlayerObject > > table( new std::vector< PredictPlayerObject >() );
+    table->reserve( M_our_players_size + M_their_players_size + 1 );
+
+    for ( size_t i = 0; i < M_our_players_size; ++i )
+    {
+        table->push_back( *M_our_players[i] );
+    }
+
+    for ( size_t i = 0; i < M_their_players_size; ++i )
+    {
+        table->push_back( *M_their_players[i] );
+    }
+
+    table->push_back( *M_self );
+
+    const std::vector< PredictPlayerObject > & players = *table;
+
+    const PredictPlayerObject * new_self = findInTable( players, M_self );
+    const PredictPlayerObject * new_ball_holder = findInTable( players, M_ball_holder );
+    const PredictPlayerObject * new_player = findInTable( players, *player );
+
+    for ( size_t i = 0; i < M_our_players_size; ++i )
+    {
+        M_our_players[i] = &players[i];
+    }
+
+    for ( size_t i = 0; i < M_their_players_size; ++i )
+    {
+        M_their_players[i] = &players[M_our_players_size + i];
+    }
+
+    M_self = new_self;
+    M_ball_holder = new_ball_holder;
+    *player = new_player;
+
+    clearMovedPlayers();
+    M_player_table = table;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const PredictPlayerObject *
+PredictState::findInTable( const std::vector< PredictPlayerObject > & table,
+                           const PredictPlayerObject * player ) const
+{
+    // the layout of the table is same as the one created by rebuildPlayerTable().
+    for ( size_t i = 0; i < M_our_players_size; ++i )
+    {
+        if ( M_our_players[i] == player )
+        {
+            return &table[i];
+        }
+    }
+
+    for ( size_t i = 0; i < M_their_players_size; ++i )
+    {
+        if ( M_their_players[i] == player )
+        {
+            return &table[M_our_players_size + i];
+        }
+    }
+
+    // self not in our players
+    return &table.back();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PredictState::clearMovedPlayers()
+{
+    for ( size_t i = 0; i < M_moved_players_size; ++i )
+    {
+        movedPlayer( i )->~PredictPlayerObject();
+    }
+    M_moved_players_size = 0;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -296,7 +563,7 @@ PredictState::updateBallHolder()
          || ! M_ball_holder->isValid() )
     {
         double min_dist2 = 1000000.0;
-        for ( PredictPlayerObject::Cont::const_iterator it = M_our_players.begin(), end = M_our_players.end();
+        for ( PlayerCont::const_iterator it = M_our_players, end = M_our_players + M_our_players_size;
               it != end;
               ++it )
         {
@@ -340,19 +607,12 @@ PredictState::predictPlayerPositions()
     const int ball_holder_unum = ( M_ball_holder
                                    ? M_ball_holder->unum()
                                    : Unum_Unknown );
-    for ( PredictPlayerObject::Cont::iterator p = M_our_players.begin(), end = M_our_players.end();
-              p != end;
-              ++p )
+    for ( size_t i = 0; i < M_our_players_size; ++i )
     {
-        if ( (*p)->unum() != ball_holder_unum )
+        if ( M_our_players[i]->unum() != ball_holder_unum )
         {
-            Vector2D new_pos = f->getPosition( (*p)->unum(), M_ball.pos() );
-            PredictPlayerObject::Ptr ptr( new PredictPlayerObject( **p, new_pos ) );
-            *p = ptr;
-            if ( (*p)->unum() == M_self->unum() )
-            {
-                M_self = ptr;
-            }
+            Vector2D new_pos = f->getPosition( M_our_players[i]->unum(), M_ball.pos() );
+            movePlayer( M_our_players[i], new_pos );
         }
     }
 #endif
@@ -369,7 +629,7 @@ PredictState::updateLines()
     {
         double first = -ServerParam::i().pitchHalfLength();
         double second = first;
-        for ( PredictPlayerObject::Cont::const_iterator p = M_their_players.begin(), end = M_their_players.end();
+        for ( PlayerCont::const_iterator p = M_their_players, end = M_their_players + M_their_players_size;
               p != end;
               ++p )
         {
@@ -392,7 +652,7 @@ PredictState::updateLines()
         double first_max = -ServerParam::i().pitchHalfLength();
         double first_min = ServerParam::i().pitchHalfLength();
         double second_min = first_min;
-        for ( PredictPlayerObject::Cont::const_iterator p = M_our_players.begin(), end = M_our_players.end();
+        for ( PlayerCont::const_iterator p = M_our_players, end = M_our_players + M_our_players_size;
               p != end;
               ++p )
         {
@@ -468,40 +728,6 @@ PredictState::setBall( const Vector2D & pos )
     M_ball.assign( pos ); // the velicity is set to 0.
 }
 
-/*-------------------------------------------------------------------*/
-/*!
-
- */
-void
-PredictState::setSelf( PredictPlayerObject::Ptr ptr )
-{
-    if ( ! ptr )
-    {
-        std::cerr << "(PredictState::setSelf) NULL pointer" << std::endl;
-        return;
-    }
-
-    M_self = ptr;
-
-    bool found = false;
-    for ( PredictPlayerObject::Cont::iterator p = M_our_players.begin(), end = M_our_players.end();
-          p != end;
-          ++p )
-    {
-        if ( (*p)->unum() == M_self->unum() )
-        {
-            *p = ptr;
-            found = true;
-            break;
-        }
-    }
-
-    if ( ! found )
-    {
-        M_our_players.push_back( ptr );
-    }
-}
-
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -509,122 +735,7 @@ PredictState::setSelf( PredictPlayerObject::Ptr ptr )
 void
 PredictState::setSelfPos( const Vector2D & pos )
 {
-    if ( ! M_self )
-    {
-        std::cerr << "(PredictState::setSelfPos) no self instance." << std::endl;
-        return;
-    }
-
-    PredictPlayerObject::Ptr ptr( new PredictPlayerObject( *M_self, pos ) );
-    M_self = ptr;
-
-    bool found = false;
-    for ( PredictPlayerObject::Cont::iterator p = M_our_players.begin(), end = M_our_players.end();
-          p != end;
-          ++p )
-    {
-        if ( (*p)->unum() == M_self->unum() )
-        {
-            *p = ptr;
-            found = true;
-            break;
-        }
-    }
-
-    if ( ! found )
-    {
-        M_our_players.push_back( ptr );
-    }
-}
-
-/*-------------------------------------------------------------------*/
-/*!
-
- */
-void
-PredictState::setPlayer( PredictPlayerObject::Ptr ptr )
-{
-    if ( ! ptr )
-    {
-        std::cerr << "(PredictState::setPlayer) NULL pointer." << std::endl;
-        return;
-    }
-
-    if ( ! M_self )
-    {
-        std::cerr << "(PredictState::setPlayer) no self instance." << std::endl;
-        return;
-    }
-
-    if ( ptr->side() == NEUTRAL )
-    {
-        setUnknownPlayer( ptr );
-    }
-    else if ( ptr->side() == M_self->side() )
-    {
-        setTeammate( ptr );
-    }
-    else
-    {
-        setOpponent( ptr );
-    }
-}
-
-/*-------------------------------------------------------------------*/
-/*!
-
- */
-void
-PredictState::setTeammate( PredictPlayerObject::Ptr ptr )
-{
-    bool found = false;
-    for ( PredictPlayerObject::Cont::iterator p = M_our_players.begin(), end = M_our_players.end();
-          p != end;
-          ++p )
-    {
-        if ( (*p)->unum() == ptr->unum() )
-        {
-            *p = ptr;
-            found = true;
-            break;
-        }
-    }
-
-    if ( ! found )
-    {
-        M_our_players.push_back( ptr );
-    }
-}
-
-/*-------------------------------------------------------------------*/
-/*!
-
- */
-void
-PredictState::setOpponent( PredictPlayerObject::Ptr ptr )
-{
-    for ( PredictPlayerObject::Cont::iterator p = M_their_players.begin(), end = M_their_players.end();
-          p != end;
-          ++p )
-    {
-        if ( (*p)->unum() == ptr->unum() )
-        {
-            *p = ptr;
-            return;
-        }
-    }
-
-    M_their_players.push_back( ptr );
-}
-
-/*-------------------------------------------------------------------*/
-/*!
-
- */
-void
-PredictState::setUnknownPlayer( PredictPlayerObject::Ptr ptr )
-{
-    M_their_players.push_back( ptr );
+    movePlayer( M_self, pos );
 }
 
 /*-------------------------------------------------------------------*/
@@ -636,44 +747,24 @@ PredictState::setPlayerPos( const SideID side,
                             const int unum,
                             const Vector2D & pos )
 {
-    if ( ! M_self )
-    {
-        return;
-    }
-
     if ( M_self->side() == side )
     {
-        for ( PredictPlayerObject::Cont::iterator p = M_our_players.begin(), end = M_our_players.end();
-              p != end;
-              ++p )
+        for ( size_t i = 0; i < M_our_players_size; ++i )
         {
-            if ( (*p)->unum() == unum )
+            if ( M_our_players[i]->unum() == unum )
             {
-                PredictPlayerObject::Ptr ptr( new PredictPlayerObject( **p, pos ) );
-                *p = ptr;
-                if ( M_self->unum() == unum )
-                {
-                    M_self = ptr;
-                }
-                if ( M_ball_holder
-                     && M_ball_holder->unum() == unum )
-                {
-                    M_ball_holder = ptr;
-                }
+                movePlayer( M_our_players[i], pos );
                 break;
             }
         }
     }
     else
     {
-        for ( PredictPlayerObject::Cont::iterator p = M_their_players.begin(), end = M_their_players.end();
-              p != end;
-              ++p )
+        for ( size_t i = 0; i < M_their_players_size; ++i )
         {
-            if ( (*p)->unum() == unum )
+            if ( M_their_players[i]->unum() == unum )
             {
-                PredictPlayerObject::Ptr ptr( new PredictPlayerObject( **p, pos ) );
-                *p = ptr;
+                movePlayer( M_their_players[i], pos );
                 break;
             }
         }
@@ -687,13 +778,11 @@ PredictState::setPlayerPos( const SideID side,
 void
 PredictState::setBallHolderUnum( const int ball_holder_unum )
 {
-    for ( PredictPlayerObject::Cont::iterator p = M_our_players.begin(), end = M_our_players.end();
-          p != end;
-          ++p )
+    for ( size_t i = 0; i < M_our_players_size; ++i )
     {
-        if ( (*p)->unum() == ball_holder_unum )
+        if ( M_our_players[i]->unum() == ball_holder_unum )
         {
-            M_ball_holder = *p;
+            M_ball_holder = M_our_players[i];
             break;
         }
     }
@@ -713,13 +802,13 @@ PredictState::ourPlayer( const int unum ) const
         return static_cast< const AbstractPlayerObject * >( 0 );
     }
 
-    for ( PredictPlayerObject::Cont::const_iterator p = M_our_players.begin(), end = M_our_players.end();
+    for ( PlayerCont::const_iterator p = M_our_players, end = M_our_players + M_our_players_size;
           p != end;
           ++p )
     {
         if ( (*p)->unum() == unum )
         {
-            return p->get();
+            return *p;
         }
     }
 
@@ -740,13 +829,13 @@ PredictState::theirPlayer( const int unum ) const
         return static_cast< const AbstractPlayerObject * >( 0 );
     }
 
-    for ( PredictPlayerObject::Cont::const_iterator p = M_their_players.begin(), end = M_their_players.end();
+    for ( PlayerCont::const_iterator p = M_their_players, end = M_their_players + M_their_players_size;
           p != end;
           ++p )
     {
         if ( (*p)->unum() == unum )
         {
-            return p->get();
+            return *p;
         }
     }
 
@@ -760,13 +849,13 @@ PredictState::theirPlayer( const int unum ) const
 const AbstractPlayerObject *
 PredictState::getOurGoalie() const
 {
-    for ( PredictPlayerObject::Cont::const_iterator p = M_our_players.begin(), end = M_our_players.end();
+    for ( PlayerCont::const_iterator p = M_our_players, end = M_our_players + M_our_players_size;
           p != end;
           ++p )
     {
         if ( (*p)->goalie() )
         {
-            return p->get();
+            return *p;
         }
     }
 
@@ -778,7 +867,7 @@ PredictState::getOurGoalie() const
 
  */
 const AbstractPlayerObject *
-PredictState::getPlayerNearestTo( const PredictPlayerObject::Cont & players,
+PredictState::getPlayerNearestTo( const PlayerCont & players,
                                   const Vector2D & point,
                                   const int count_thr,
                                   double * dist_to_point ) const
@@ -786,7 +875,7 @@ PredictState::getPlayerNearestTo( const PredictPlayerObject::Cont & players,
     const AbstractPlayerObject * nearest_player = static_cast< AbstractPlayerObject * >( 0 );
     double min_dist2 = 10000000.0;
 
-    for ( PredictPlayerObject::Cont::const_iterator it = players.begin(), end = players.end();
+    for ( PlayerCont::const_iterator it = players.begin(), end = players.end();
           it != end;
           ++ it )
     {
@@ -829,7 +918,7 @@ PredictState::getPlayers( const PlayerPredicate * predicate ) const
         return ret;
     }
 
-    for ( PredictPlayerObject::Cont::const_iterator it = M_our_players.begin(), end = M_our_players.end();
+    for ( PlayerCont::const_iterator it = M_our_players, end = M_our_players + M_our_players_size;
           it != end;
           ++it )
     {
@@ -839,7 +928,7 @@ PredictState::getPlayers( const PlayerPredicate * predicate ) const
         }
     }
 
-    for ( PredictPlayerObject::Cont::const_iterator it = M_their_players.begin(), end = M_their_players.end();
+    for ( PlayerCont::const_iterator it = M_their_players, end = M_their_players + M_their_players_size;
           it != end;
           ++it )
     {
@@ -866,7 +955,7 @@ PredictState::getPlayers( AbstractPlayerObject::Cont & cont,
         return;
     }
 
-    for ( PredictPlayerObject::Cont::const_iterator it = M_our_players.begin(), end = M_our_players.end();
+    for ( PlayerCont::const_iterator it = M_our_players, end = M_our_players + M_our_players_size;
           it != end;
           ++it )
     {
@@ -876,7 +965,7 @@ PredictState::getPlayers( AbstractPlayerObject::Cont & cont,
         }
     }
 
-    for ( PredictPlayerObject::Cont::const_iterator it = M_their_players.begin(), end = M_their_players.end();
+    for ( PlayerCont::const_iterator it = M_their_players, end = M_their_players + M_their_players_size;
           it != end;
           ++it )
     {
@@ -904,14 +993,14 @@ PredictState::print( std::ostream & os ) const
         os << " (self " << M_self->pos() << ')' << '\n';
     }
 
-    for ( PredictPlayerObject::Cont::const_iterator p = M_our_players.begin(), end = M_our_players.end();
+    for ( PlayerCont::const_iterator p = M_our_players, end = M_our_players + M_our_players_size;
           p != end;
           ++p )
     {
         os << " (our " << (*p)->unum() << ' ' << (*p)->pos() << ')' << '\n';
     }
 
-    for ( PredictPlayerObject::Cont::const_iterator p = M_their_players.begin(), end = M_their_players.end();
+    for ( PlayerCont::const_iterator p = M_their_players, end = M_their_players + M_their_players_size;
           p != end;
           ++p )
     {
@@ -42,9 +42,25 @@
 #include <rcsc/geom/vector_2d.h>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
 
 #include <algorithm>
+#include <vector>
+#include <cstddef>
 
+/*!
+  \class PredictState
+  \brief predicted field state used as the node of the action chain search.
+
+  The player instances created from the world model are stored in the
+  player table that is shared by all states in the search tree. Each
+  state only holds the fixed size arrays of pointers to the players
+  and the small overlay of the players moved from the table (e.g. the
+  pass receiver). Therefore, creating a child state does not allocate
+  any player instance and does not touch the reference counter of
+  each player.
+*/
 class PredictState {
 public:
     static const int VALID_PLAYER_THRESHOLD;
@@ -52,18 +68,67 @@ public:
     typedef boost::shared_ptr< PredictState > Ptr; //!< pointer type alias
     typedef boost::shared_ptr< const PredictState > ConstPtr; //!< const pointerp type alias
 
+    enum {
+        MAX_PLAYER_SIZE = 11, //!< the maximum number of players in each team
+        MAX_MOVED_PLAYER_SIZE = 4 //!< the capacity of the overlay
+    };
+
+    /*!
+      \class PlayerCont
+      \brief lightweight read-only view of the player array in the state.
+
+      The view refers the storage in the state. The state must outlive the view.
+    */
+    class PlayerCont {
+    public:
+        typedef const PredictPlayerObject * const * const_iterator; //!< iterator type alias
+    private:
+        const PredictPlayerObject * const * M_players;
+        size_t M_size;
+    public:
+        PlayerCont( const PredictPlayerObject * const * players,
+                    const size_t size )
+            : M_players( players ),
+              M_size( size )
+          { }
+
+        const_iterator begin() const { return M_players; }
+        const_iterator end() const { return M_players + M_size; }
+
+        bool empty() const { return M_size == 0; }
+        size_t size() const { return M_size; }
+
+        const PredictPlayerObject * operator[]( const size_t i ) const { return M_players[i]; }
+    };
+
 private:
+
+    //! the immutable player instances shared by the states in the search tree
+    typedef boost::shared_ptr< const std::vector< PredictPlayerObject > > PlayerTable;
+
+    //! raw storage for the overlay players
+    typedef boost::aligned_storage< sizeof( PredictPlayerObject ),
+                                    boost::alignment_of< PredictPlayerObject >::value >::type MovedPlayerStorage;
+
     rcsc::GameMode M_game_mode;
     rcsc::GameTime M_current_time;
     unsigned long M_spent_time;
 
     PredictBallObject M_ball;
 
-    PredictPlayerObject::ConstPtr M_self;
-    PredictPlayerObject::Cont M_our_players;
-    PredictPlayerObject::Cont M_their_players;
+    PlayerTable M_player_table;
+
+    const PredictPlayerObject * M_self;
+    const PredictPlayerObject * M_our_players[MAX_PLAYER_SIZE];
+    const PredictPlayerObject * M_their_players[MAX_PLAYER_SIZE];
+    size_t M_our_players_size;
+    size_t M_their_players_size;
 
-    PredictPlayerObject::ConstPtr M_ball_holder;
+    const PredictPlayerObject * M_ball_holder;
+
+    //! the players whose position is different from the player table
+    MovedPlayerStorage M_moved_players[MAX_MOVED_PLAYER_SIZE];
+    size_t M_moved_players_size;
 
     double M_offside_line_x;
     double M_our_defense_line_x;
@@ -128,6 +193,11 @@ public:
                   const unsigned long append_spent_time,
                   const rcsc::Vector2D & ball_pos );
 
+    /*!
+      \brief destruct the overlay players
+     */
+    ~PredictState();
+
     //
     //
     //
@@ -140,6 +210,25 @@ private:
     void updateBallHolder();
     void predictPlayerPositions();
     void updateLines();
+
+    PredictPlayerObject * movedPlayer( const size_t i )
+      {
+          return reinterpret_cast< PredictPlayerObject * >( &M_moved_players[i] );
+      }
+    const PredictPlayerObject * movedPlayer( const size_t i ) const
+      {
+          return reinterpret_cast< const PredictPlayerObject * >( &M_moved_players[i] );
+      }
+
+    void copyPlayers( const PredictState & rhs );
+    const PredictPlayerObject * relocate( const PredictState & rhs,
+                                          const PredictPlayerObject * player ) const;
+    const PredictPlayerObject * movePlayer( const PredictPlayerObject * player,
+                                            const rcsc::Vector2D & pos );
+    void rebuildPlayerTable( const PredictPlayerObject ** player );
+    const PredictPlayerObject * findInTable( const std::vector< PredictPlayerObject > & table,
+                                             const PredictPlayerObject * player ) const;
+    void clearMovedPlayers();
 public:
     void setGameMode( const rcsc::GameMode & mode );
     void setCurrentTime( const rcsc::GameTime & time );
@@ -149,15 +238,8 @@ public:
                   const rcsc::Vector2D & vel );
     void setBall( const rcsc::Vector2D & pos );
 
-    void setSelf( PredictPlayerObject::Ptr ptr );
     void setSelfPos( const rcsc::Vector2D & pos );
 
-    void setPlayer( PredictPlayerObject::Ptr ptr );
-private:
-    void setTeammate( PredictPlayerObject::Ptr ptr );
-    void setOpponent( PredictPlayerObject::Ptr ptr );
-    void setUnknownPlayer( PredictPlayerObject::Ptr ptr );
-public:
     void setPlayerPos( const rcsc::SideID side,
                        const int unum,
                        const rcsc::Vector2D & pos );
@@ -173,14 +255,14 @@ public:
 
     const PredictBallObject & ball() const { return M_ball; }
     const rcsc::AbstractPlayerObject & self() const { return *M_self; }
-    const PredictPlayerObject::Cont & ourPlayers() const { return M_our_players; }
-    const PredictPlayerObject::Cont & theirPlayers() const { return M_their_players; }
+    PlayerCont ourPlayers() const { return PlayerCont( M_our_players, M_our_players_size ); }
+    PlayerCont theirPlayers() const { return PlayerCont( M_their_players, M_their_players_size ); }
     const rcsc::AbstractPlayerObject & ballHolder() const { return *M_ball_holder; }
     const rcsc::AbstractPlayerObject * ourPlayer( const int unum ) const;
     const rcsc::AbstractPlayerObject * theirPlayer( const int unum ) const;
     const rcsc::AbstractPlayerObject * getOurGoalie() const;
 
-    const rcsc::AbstractPlayerObject * getPlayerNearestTo( const PredictPlayerObject::Cont & players,
+    const rcsc::AbstractPlayerObject * getPlayerNearestTo( const PlayerCont & players,
                                                            const rcsc::Vector2D & point,
                                                            const int count_thr,
                                                            double * dist_to_point ) const;
@@ -188,14 +270,14 @@ public:
                                                               const int count_thr,
                                                               double * dist_to_point ) const
       {
-          return getPlayerNearestTo( M_our_players, point, count_thr, dist_to_point );
+          return getPlayerNearestTo( ourPlayers(), point, count_thr, dist_to_point );
       }
 
     const rcsc::AbstractPlayerObject * getOpponentNearestTo( const rcsc::Vector2D & point,
                                                              const int count_thr,
                                                              double * dist_to_point ) const
       {
-          return getPlayerNearestTo( M_their_players, point, count_thr, dist_to_point );
+          return getPlayerNearestTo( theirPlayers(), point, count_thr, dist_to_point );
       }
 
     rcsc::AbstractPlayerObject::Cont getPlayers( const rcsc::PlayerPredicate * predicate ) const;
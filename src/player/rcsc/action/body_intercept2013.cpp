@@ -34,6 +34,8 @@
 
 #include "body_intercept2013.h"
 
+#include "intercept_scorer.h"
+
 #include <rcsc/action/basic_actions.h>
 #include <rcsc/action/body_go_to_point.h>
 
@@ -466,340 +468,10 @@ InterceptInfo
 Body_Intercept2013::get_best_intercept2013( const WorldModel & wm,
                                             const bool save_recovery )
 {
-    static GameTime s_time;
-    static InterceptInfo s_cached_best;
-
-    if ( s_time == wm.time() )
-    {
-        return s_cached_best;
-    }
-    s_time = wm.time();
-
-    const ServerParam & SP = ServerParam::i();
-
-    const double max_x = ( SP.keepawayMode()
-                           ? SP.keepawayLength() * 0.5 - 1.0
-                           : SP.pitchHalfLength() - 1.0 );
-    const double max_y = ( SP.keepawayMode()
-                           ? SP.keepawayWidth() * 0.5 - 1.0
-                           : SP.pitchHalfWidth() - 1.0 );
-    const double kickable_area = wm.self().playerType().kickableArea();
-    const double fast_speed_thr = wm.self().playerType().realSpeedMax() * 0.8;
-    const double slow_ball_speed_thr = 0.55;
-    const double first_ball_speed = wm.ball().vel().r();
-    const AngleDeg ball_vel_angle = wm.ball().vel().th();
-
-    const int opponent_step = wm.interceptTable()->opponentReachStep();
-    const int teammate_step = wm.interceptTable()->teammateReachStep();
-
-    std::vector< InterceptCandidate > candidates;
-    candidates.reserve( wm.interceptTable()->selfCache().size() );
-
-    int count = 1;
-    for ( std::vector< InterceptInfo >::const_iterator it = wm.interceptTable()->selfCache().begin(),
-              end = wm.interceptTable()->selfCache().end();
-          it != end;
-          ++it, ++count )
-    {
-        if ( save_recovery
-             && it->staminaType() != InterceptInfo::NORMAL )
-        {
-            continue;
-        }
-
-        const Vector2D ball_pos = wm.ball().inertiaPoint( it->reachCycle() );
-        const AngleDeg body_angle = wm.self().body() + it->turnAngle();
-        const double ball_speed = first_ball_speed * std::pow( SP.ballDecay(), it->reachStep() );
-#ifdef DEBUG_PRINT
-        dlog.addText( Logger::INTERCEPT, "----------" );
-        dlog.addText( Logger::INTERCEPT,
-                      "%d: intercept type[%c] step=%d(t%d:d%d) turn=%.1f power=%.1f dir=%.1f",
-                      count, type_char( it->actionType() ),
-                      it->reachCycle(), it->turnCycle(), it->dashCycle(),
-                      it->turnAngle(), it->turnAngle(), it->dashPower(), it->dashDir() );
-        dlog.addText( Logger::INTERCEPT,
-                      "%d: intercept bpos=(%.2f %.2f) speed=%.3f bdist=%.3f stamina=%.1f",
-                      count, ball_pos.x, ball_pos.y, ball_speed, it->ballDist(), it->stamina() );
-#endif
-        candidates.push_back( InterceptCandidate( &(*it), 0.0 ) );
-        InterceptCandidate & candidate = candidates.back();
-
-        //
-        // base value
-        //
-        // candidate.value_ = -it->reachCycle();
-
-        // dlog.addText( Logger::INTERCEPT,
-        //               "%d: (intercept eval) base value = %.3f",
-        //               count, candidate.value_ );
-
-        if ( ball_pos.absX() > max_x
-             || ball_pos.absY() > max_y )
-        {
-            candidate.value_ = -1000.0 - it->reachCycle();
-#ifdef DEBUG_PRINT
-            dlog.addText( Logger::INTERCEPT,
-                          "%d: (intercept eval) out of pitch = %.3f",
-                          count, candidate.value_ );
-#endif
-            continue;
-        }
-
-        double tmp_val;
-
-        //
-        //
-        //
-        {
-            double spot_x_dist = std::fabs( ball_pos.x - 44.0 );
-            double spot_y_dist = ball_pos.absY() * 0.5;
-            double spot_dist = std::sqrt( std::pow( spot_x_dist, 2 ) + std::pow( spot_y_dist, 2 ) );
-            tmp_val = spot_dist * -0.2;
-            candidate.value_ += tmp_val;
-#ifdef DEBUG_PRINT
-            dlog.addText( Logger::INTERCEPT,
-                          "%d: (intercept eval) shoot spot dist = %.3f (%.3f)",
-                          count, tmp_val, candidate.value_ );
-#endif
-        }
-
-        //
-        //
-        //
-//         if ( it->reachCycle() == 1
-//              && it->ballDist() < kickable_area - 0.3 )
-//         {
-//             tmp_val = 0.5;
-//             candidate.value_ += tmp_val;
-// #ifdef DEBUG_PRINT
-//             dlog.addText( Logger::INTERCEPT,
-//                           "%d: (intercept eval) 1 step = %.3f (%.3f)",
-//                           count, tmp_val, candidate.value_ );
-// #endif
-//         }
-
-        //
-        //
-        //
-        tmp_val = 0.0;
-        if ( wm.gameMode().type() == GameMode::GoalKick_
-             && wm.gameMode().side() == wm.ourSide()
-             && ball_pos.x < SP.ourPenaltyAreaLineX() - 2.0
-             && ball_pos.absY() < SP.penaltyAreaHalfWidth() - 2.0 )
-        {
-            // no penalty
-        }
-        else
-        {
-            if ( opponent_step <= it->reachCycle() + 3 )
-            {
-                tmp_val = ( opponent_step - ( it->reachCycle() + 3 ) ) * 5.0;
-            }
-        }
-        candidate.value_ += tmp_val;
-#ifdef DEBUG_PRINT
-        dlog.addText( Logger::INTERCEPT,
-                      "%d: (intercept eval) opponent diff = %.3f (%.3f)",
-                      count, tmp_val, candidate.value_ );
-#endif
-        //
-        //
-        //
-        tmp_val = 0.0;
-        if ( teammate_step <= it->reachCycle() + 3 )
-        {
-            tmp_val = ( teammate_step - ( it->reachCycle() + 3 ) ) * 0.5;
-        }
-        candidate.value_ += tmp_val;
-#ifdef DEBUG_PRINT
-        dlog.addText( Logger::INTERCEPT,
-                      "%d: (intercept eval) teammate diff = %.3f (%.3f)",
-                      count, tmp_val, candidate.value_ );
-#endif
-        //
-        //
-        //
-        if ( it->actionType() == InterceptInfo::TURN_FORWARD_DASH
-             || it->actionType() == InterceptInfo::TURN_BACK_DASH )
-        {
-            if ( it->ballDist() > kickable_area - 0.3
-                 && it->turnCycle() > 0 )
-            {
-                tmp_val = std::fabs( it->turnAngle() ) * -0.025;
-                candidate.value_ += tmp_val;
-#ifdef DEBUG_PRINT
-                dlog.addText( Logger::INTERCEPT,
-                              "%d: (intercept eval) turn penalty = %.3f (angle=%.1f) (%.3f)",
-                              count, tmp_val, it->turnAngle(), candidate.value_ );
-#endif
-            }
-        }
-
-        {
-            //
-            //
-            //
-            double move_dist = it->selfPos().dist( wm.self().pos() );
-            tmp_val = 0.0;
-            if ( ball_pos.x < wm.offsideLineX() )
-            {
-                tmp_val = move_dist * -0.3; //-0.1;
-            }
-            if ( it->ballDist() > kickable_area - 0.3 )
-            {
-                tmp_val += move_dist * -0.5; //-0.2;
-            }
-            candidate.value_ += tmp_val;
-#ifdef DEBUG_PRINT
-            dlog.addText( Logger::INTERCEPT,
-                          "%d: (intercept eval) move dist penalty = %.3f (%.3f)",
-                          count, tmp_val, candidate.value_ );
-#endif
-        }
-
-        //
-        //
-        //
-        if ( it->ballDist() > kickable_area - 0.4 )
-        {
-            //tmp_val = ( it->ballDist() - ( kickable_area - 0.4 ) ) * -5.0;
-            tmp_val = ( it->ballDist() - ( kickable_area - 0.4 ) ) * -3.0 - 0.5;
-            candidate.value_ += tmp_val;
-#ifdef DEBUG_PRINT
-            dlog.addText( Logger::INTERCEPT,
-                              "%d: (intercept eval) ball dist penalty(1) = %.3f (%.3f)",
-                          count, tmp_val, candidate.value_ );
-#endif
-        }
-
-        //
-        //
-        //
-        {
-            tmp_val = ( it->stamina() - wm.self().stamina() ) * 0.0001;
-            candidate.value_ += tmp_val;
-#ifdef DEBUG_PRINT
-            dlog.addText( Logger::INTERCEPT,
-                          "%d: (intercept eval) stamina penalty = %.3f (%.3f)",
-                          count, tmp_val, candidate.value_ );
-#endif
-        }
-
-        //
-        //
-        //
-        if ( it->turnStep() > 0 )
-        {
-            tmp_val = -0.01;
-            candidate.value_ += tmp_val;
-#ifdef DEBUG_PRINT
-            dlog.addText( Logger::INTERCEPT,
-                          "%d: (intercept eval) turn penalty = %.3f (%.3f)",
-                          count, tmp_val, candidate.value_ );
-#endif
-        }
-
-        if ( it->turnStep() > 0
-             && it->dashPower() < 0.0 )
-        {
-            tmp_val = std::max( 0.0, body_angle.abs() - 90.0 ) * -0.1;
-            candidate.value_ += tmp_val;
-            dlog.addText( Logger::INTERCEPT,
-                          "%d: (intercept eval) turn back penalty = %.3f (%.3f)",
-                          count, tmp_val, candidate.value_ );
-
-            if ( ( wm.self().body() - body_angle ).abs() > 90.0 )
-            {
-                tmp_val = -0.001;
-                candidate.value_ += tmp_val;
-#ifdef DEBUG_PRINT
-                dlog.addText( Logger::INTERCEPT,
-                              "%d: (intercept eval) turn back penalty(2) = %.3f (%.3f)",
-                              count, tmp_val, candidate.value_ );
-#endif
-            }
-        }
-
-        //
-        //
-        //
-        if ( ( body_angle - ball_vel_angle ).abs() < 30.0 //aligned_body_angle_to_ball_move_line
-             && Segment2D( wm.ball().pos(), ball_pos ).dist( wm.self().pos() ) < kickable_area - 0.3 )
-        {
-            if ( ball_speed < fast_speed_thr )
-            {
-                tmp_val = ( fast_speed_thr - ball_speed ) * -20.0;
-                candidate.value_ += tmp_val;
-#ifdef DEBUG_PRINT
-                dlog.addText( Logger::INTERCEPT,
-                              "%d: (intercept eval) ball speed penalty(1) = %.3f (%.3f)",
-                              count, tmp_val, candidate.value_ );
-#endif
-            }
-        }
-        else
-        {
-            if ( ball_speed < slow_ball_speed_thr ) // magic number
-            {
-                //tmp_val = ( slow_ball_speed_thr - ball_speed ) * -20.0;
-                tmp_val = std::pow( slow_ball_speed_thr - ball_speed, 2 ) * -70.0;
-                candidate.value_ += tmp_val;
-#ifdef DEBUG_PRINT
-                dlog.addText( Logger::INTERCEPT,
-                              "%d: (intercept eval) ball speed penalty(2) = %.3f (%.3f)",
-                              count, tmp_val, candidate.value_ );
-#endif
-            }
-        }
-    }
-
-#ifdef DEBUG_PRINT
-    dlog.addText( Logger::INTERCEPT, "==========" );
-    count = 1;
-    for ( std::vector< InterceptCandidate >::const_iterator it = candidates.begin();
-          it != candidates.end();
-          ++it, ++count )
-    {
-        dlog.addText( Logger::INTERCEPT,
-                      "%d: step=%d: type[%c] (t%d:d%d) turn=%.1f power=%.1f dir=%.1f -- value=%.4f",
-                      count, it->info_->reachCycle(),
-                      type_char( it->info_->actionType() ),
-                      it->info_->turnCycle(), it->info_->dashCycle(),
-                      it->info_->turnAngle(), it->info_->dashPower(), it->info_->dashDir(),
-                      it->value_ );
-    }
-#endif
-
-    std::vector< InterceptCandidate >::const_iterator best = std::min_element( candidates.begin(),
-                                                                               candidates.end(),
-                                                                               InterceptCandidateSorter() );
-    if ( best != candidates.end() )
-    {
-#ifdef DEBUG_PRINT
-        dlog.addText( Logger::INTERCEPT, "==========" );
-        dlog.addText( Logger::INTERCEPT,
-                      "best: step=%d type[%c](t%d:d%d) power=%.1f dir=%.1f -- value=%.4f",
-                      best->info_->reachCycle(),
-                      type_char( best->info_->actionType() ),
-                      best->info_->turnCycle(), best->info_->dashCycle(),
-                      best->info_->dashPower(), best->info_->dashDir(),
-                      best->value_ );
-        dlog.addText( Logger::INTERCEPT, "==========" );
-#endif
-        s_cached_best = *(best->info_);
-        return s_cached_best;
-    }
-
-    if ( candidates.empty() )
-    {
-        s_cached_best = InterceptInfo();
-    }
-    else
-    {
-        s_cached_best = *(candidates.front().info_);
-    }
-
-    return s_cached_best;
+    const InterceptInfo * best = ::InterceptScorer::instance().getBest( wm, save_recovery );
+    return ( best
+             ? *best
+             : InterceptInfo() );
 }
 
 
@@ -0,0 +1,294 @@
+// -*-c++-*-
+
+/*!
+  \file reach_cycle_table.cpp
+  \brief per player type turn cycle table Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "reach_cycle_table.h"
+
+#include <rcsc/common/player_type.h>
+#include <rcsc/common/server_param.h>
+
+#include <boost/random.hpp>
+
+#include <iostream>
+#include <cmath>
+
+using namespace rcsc;
+
+namespace {
+
+//! the maximum speed stored in the table
+const double MAX_SPEED = 1.5;
+
+//! margin for the rounding error of the accumulation [degree]
+const double ANGLE_EPS = 1.0e-6;
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ReachCycleTable::ReachCycleTable()
+    : M_speed_step( MAX_SPEED / SPEED_DIVS )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ReachCycleTable &
+ReachCycleTable::instance()
+{
+    static ReachCycleTable s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ReachCycleTable::create()
+{
+    const ServerParam & SP = ServerParam::i();
+    const PlayerTypeSet::Map & types = PlayerTypeSet::i().playerTypeMap();
+
+    M_tables.clear();
+
+    for ( PlayerTypeSet::Map::const_iterator it = types.begin(), end = types.end();
+          it != end;
+          ++it )
+    {
+        if ( it->first < 0 )
+        {
+            continue;
+        }
+
+        if ( static_cast< int >( M_tables.size() ) <= it->first )
+        {
+            M_tables.resize( it->first + 1 );
+        }
+
+        const PlayerType * ptype = &(it->second);
+        TypeTable & table = M_tables[it->first];
+
+        table.player_type_ = ptype;
+        table.inertia_moment_ = ptype->inertiaMoment();
+        table.player_decay_ = ptype->playerDecay();
+        table.cumulative_turn_.resize( ( SPEED_DIVS + 1 ) * ( MAX_TURN + 1 ) );
+
+        for ( int s = 0; s <= SPEED_DIVS; ++s )
+        {
+            double * row = &table.cumulative_turn_[s * ( MAX_TURN + 1 )];
+            double speed = M_speed_step * s;
+
+            row[0] = 0.0;
+            for ( int n = 1; n <= MAX_TURN; ++n )
+            {
+                row[n] = row[n - 1] + ptype->effectiveTurn( SP.maxMoment(), speed );
+                speed *= ptype->playerDecay();
+            }
+        }
+    }
+
+    return ! M_tables.empty();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+ReachCycleTable::size() const
+{
+    int count = 0;
+    for ( std::vector< TypeTable >::const_iterator t = M_tables.begin(), end = M_tables.end();
+          t != end;
+          ++t )
+    {
+        if ( t->player_type_ )
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+ReachCycleTable::turnCycle( const PlayerType * ptype,
+                            const double angle_diff,
+                            const double turn_margin,
+                            const double speed ) const
+{
+    if ( angle_diff <= turn_margin )
+    {
+        return 0;
+    }
+
+    const int id = ptype->id();
+    if ( id < 0
+         || static_cast< int >( M_tables.size() ) <= id )
+    {
+        return -1;
+    }
+
+    const TypeTable & table = M_tables[id];
+    if ( table.player_type_ != ptype
+         || table.inertia_moment_ != ptype->inertiaMoment()
+         || table.player_decay_ != ptype->playerDecay() )
+    {
+        return -1;
+    }
+
+    if ( speed < 0.0
+         || speed >= M_speed_step * SPEED_DIVS )
+    {
+        return -1;
+    }
+
+    const int s = static_cast< int >( std::floor( speed / M_speed_step ) );
+    // the slower speed gives the larger turn angle.
+    const double * upper_row = &table.cumulative_turn_[s * ( MAX_TURN + 1 )];
+    const double * lower_row = &table.cumulative_turn_[( s + 1 ) * ( MAX_TURN + 1 )];
+
+    const double required = angle_diff - turn_margin;
+
+    for ( int n = 1; n <= MAX_TURN; ++n )
+    {
+        if ( lower_row[n] >= required + ANGLE_EPS )
+        {
+            // the required angle is certainly reached by n turns.
+            // the result is exact only if it is certainly not reached by n-1 turns.
+            return ( upper_row[n - 1] < required - ANGLE_EPS
+                     ? n
+                     : -1 );
+        }
+    }
+
+    return -1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+ReachCycleTable::simulate_turn_cycle( const PlayerType * ptype,
+                                      double angle_diff,
+                                      const double turn_margin,
+                                      double speed )
+{
+    const ServerParam & SP = ServerParam::i();
+
+    int n_turn = 0;
+    while ( angle_diff > turn_margin )
+    {
+        angle_diff -= ptype->effectiveTurn( SP.maxMoment(), speed );
+        speed *= ptype->playerDecay();
+        ++n_turn;
+    }
+
+    return n_turn;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ReachCycleTable::validate( const int n_samples ) const
+{
+    boost::mt19937 gen( 19937 );
+    boost::uniform_real<> angle_dst( 0.0, 180.0 );
+    boost::uniform_real<> margin_dst( 15.0, 90.0 );
+    boost::uniform_real<> speed_dst( 0.0, MAX_SPEED * 1.1 );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > angle_rng( gen, angle_dst );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > margin_rng( gen, margin_dst );
+    boost::variate_generator< boost::mt19937 &, boost::uniform_real<> > speed_rng( gen, speed_dst );
+
+    int total_mismatch = 0;
+
+    for ( size_t id = 0; id < M_tables.size(); ++id )
+    {
+        const PlayerType * ptype = M_tables[id].player_type_;
+        if ( ! ptype )
+        {
+            continue;
+        }
+
+        int hit = 0;
+        int mismatch = 0;
+
+        for ( int i = 0; i < n_samples; ++i )
+        {
+            const double angle_diff = angle_rng();
+            const double turn_margin = margin_rng();
+            const double speed = speed_rng();
+
+            const int table_turn = turnCycle( ptype, angle_diff, turn_margin, speed );
+            if ( table_turn < 0 )
+            {
+                continue;
+            }
+
+            ++hit;
+            const int exact_turn = simulate_turn_cycle( ptype, angle_diff, turn_margin, speed );
+            if ( table_turn != exact_turn )
+            {
+                ++mismatch;
+                std::cerr << "(ReachCycleTable::validate) type=" << id
+                          << " angle_diff=" << angle_diff
+                          << " turn_margin=" << turn_margin
+                          << " speed=" << speed
+                          << " table=" << table_turn
+                          << " exact=" << exact_turn << std::endl;
+            }
+        }
+
+        std::cerr << "(ReachCycleTable::validate) type=" << id
+                  << " samples=" << n_samples
+                  << " table_hit=" << hit
+                  << " mismatch=" << mismatch << std::endl;
+
+        total_mismatch += mismatch;
+    }
+
+    return total_mismatch == 0;
+}
@@ -0,0 +1,153 @@
+// -*-c++-*-
+
+/*!
+  \file reach_cycle_table.h
+  \brief per player type turn cycle table Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef REACH_CYCLE_TABLE_H
+#define REACH_CYCLE_TABLE_H
+
+#include <vector>
+
+namespace rcsc {
+class PlayerType;
+}
+
+/*!
+  \class ReachCycleTable
+  \brief the cumulative turn angles for each player type and the quantized speed.
+
+  FieldAnalyzer::predict_player_turn_cycle() simulates the turn actions
+  with the decaying speed. The table holds the cumulative turn angle
+  after n turns for the speed on the grid. Since the effective turn
+  angle decreases as the speed increases, the two adjacent rows give the
+  lower and the upper bound of the cumulative turn angle for any speed
+  between them. If both bounds give the same turn cycle, it is the
+  exact result. Otherwise, the caller falls back to the simulation.
+
+  The dash cycles are already given by PlayerType::cyclesToReachDistance(),
+  which uses the dash distance table of rcsc.
+*/
+class ReachCycleTable {
+public:
+
+    enum {
+        SPEED_DIVS = 150, //!< the number of speed steps
+        MAX_TURN = 15 //!< the maximum turn cycle stored in the table
+    };
+
+private:
+
+    /*!
+      \brief table of one player type
+     */
+    struct TypeTable {
+        const rcsc::PlayerType * player_type_;
+        double inertia_moment_;
+        double player_decay_;
+        //! cumulative turn angle. index = speed_index * ( MAX_TURN + 1 ) + n_turn
+        std::vector< double > cumulative_turn_;
+
+        TypeTable()
+            : player_type_( static_cast< const rcsc::PlayerType * >( 0 ) ),
+              inertia_moment_( 0.0 ),
+              player_decay_( 0.0 )
+          { }
+    };
+
+    double M_speed_step; //!< speed resolution of the table
+    std::vector< TypeTable > M_tables; //!< index = player type id
+
+    // private for singleton
+    ReachCycleTable();
+
+    // not used
+    ReachCycleTable( const ReachCycleTable & );
+    ReachCycleTable & operator=( const ReachCycleTable & );
+
+public:
+
+    static
+    ReachCycleTable & instance();
+
+    static
+    const ReachCycleTable & i()
+      {
+          return instance();
+      }
+
+    /*!
+      \brief create the tables for all player types in PlayerTypeSet
+      \return true if at least one table is created.
+     */
+    bool create();
+
+    /*!
+      \brief get the number of the player types that have the table
+      \return the number of the player types
+     */
+    int size() const;
+
+    /*!
+      \brief get the turn cycle from the table
+      \param ptype player type
+      \param angle_diff the angle difference between the body and the target [degree]
+      \param turn_margin the angle that the turn is not required [degree]
+      \param speed the first player speed
+      \return the number of turns. -1 if the table cannot decide the result.
+     */
+    int turnCycle( const rcsc::PlayerType * ptype,
+                   const double angle_diff,
+                   const double turn_margin,
+                   const double speed ) const;
+
+    /*!
+      \brief simulate the turn actions. same as the original loop in
+      FieldAnalyzer::predict_player_turn_cycle().
+      \param ptype player type
+      \param angle_diff the angle difference between the body and the target [degree]
+      \param turn_margin the angle that the turn is not required [degree]
+      \param speed the first player speed
+      \return the number of turns
+     */
+    static
+    int simulate_turn_cycle( const rcsc::PlayerType * ptype,
+                             double angle_diff,
+                             const double turn_margin,
+                             double speed );
+
+    /*!
+      \brief compare the table results with the simulation over random samples
+      \param n_samples the number of samples for each player type
+      \return true if no mismatch is found.
+     */
+    bool validate( const int n_samples ) const;
+
+};
+
+#endif
@@ -268,7 +268,7 @@ SimplePassChecker::check( const PredictState & state,
                       pass_angle.degree() );
 #endif
 
-    for ( PredictPlayerObject::Cont::const_iterator o = state.theirPlayers().begin(),
+    for ( PredictState::PlayerCont::const_iterator o = state.theirPlayers().begin(),
               end = state.theirPlayers().end();
           o != end;
           ++o )
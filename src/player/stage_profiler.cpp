@@ -0,0 +1,333 @@
+// -*-c++-*-
+
+/*!
+  \file stage_profiler.cpp
+  \brief per-cycle profiler of the decision stages Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "stage_profiler.h"
+
+#include <rcsc/game_time.h>
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const boost::uint32_t TRACE_VERSION = 1;
+
+//
+// log-linear bucket: the values less than 16 [usec] have their own bucket.
+// the larger values are divided into 8 sub-buckets per power of two.
+//
+const int LINEAR_BUCKET_SIZE = 16;
+const int SUB_BUCKET_BITS = 3;
+const int SUB_BUCKET_SIZE = 1 << SUB_BUCKET_BITS;
+const int BUCKET_SIZE = LINEAR_BUCKET_SIZE + ( 32 - 4 ) * SUB_BUCKET_SIZE;
+
+/*-------------------------------------------------------------------*/
+inline
+boost::uint32_t
+to_usec( const double msec )
+{
+    if ( msec <= 0.0 ) return 0;
+    if ( msec >= 4294967.0 ) return 0xffffffffu;
+    return static_cast< boost::uint32_t >( msec * 1000.0 + 0.5 );
+}
+
+/*-------------------------------------------------------------------*/
+inline
+int
+bucket_index( const boost::uint32_t usec )
+{
+    if ( usec < static_cast< boost::uint32_t >( LINEAR_BUCKET_SIZE ) )
+    {
+        return static_cast< int >( usec );
+    }
+
+    int exponent = 4;
+    while ( exponent < 31
+            && ( usec >> ( exponent + 1 ) ) != 0 )
+    {
+        ++exponent;
+    }
+
+    return LINEAR_BUCKET_SIZE
+        + ( exponent - 4 ) * SUB_BUCKET_SIZE
+        + static_cast< int >( ( usec >> ( exponent - SUB_BUCKET_BITS ) ) & ( SUB_BUCKET_SIZE - 1 ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \return the upper bound [usec] of the bucket
+ */
+inline
+double
+bucket_upper_bound( const int index )
+{
+    if ( index < LINEAR_BUCKET_SIZE )
+    {
+        return index + 1;
+    }
+
+    const int exponent = ( index - LINEAR_BUCKET_SIZE ) / SUB_BUCKET_SIZE + 4;
+    const int sub = ( index - LINEAR_BUCKET_SIZE ) % SUB_BUCKET_SIZE;
+
+    return std::ldexp( static_cast< double >( SUB_BUCKET_SIZE + sub + 1 ),
+                       exponent - SUB_BUCKET_BITS );
+}
+
+/*-------------------------------------------------------------------*/
+template < typename T >
+void
+write_value( std::ostream & os,
+             const T & value )
+{
+    os.write( reinterpret_cast< const char * >( &value ), sizeof( T ) );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+StageProfiler::Histogram::Histogram()
+    : counts_( BUCKET_SIZE, 0 ),
+      total_count_( 0 ),
+      total_msec_( 0.0 ),
+      max_msec_( 0.0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+StageProfiler::Histogram::add( const double msec )
+{
+    counts_[ bucket_index( to_usec( msec ) ) ] += 1;
+    total_count_ += 1;
+    total_msec_ += msec;
+    if ( max_msec_ < msec )
+    {
+        max_msec_ = msec;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \return the upper bound of the bucket that contains the rank [ms]
+ */
+double
+StageProfiler::Histogram::percentile( const double rate ) const
+{
+    if ( total_count_ == 0 )
+    {
+        return 0.0;
+    }
+
+    const boost::int64_t rank
+        = std::max( static_cast< boost::int64_t >( 1 ),
+                    static_cast< boost::int64_t >( std::ceil( rate * total_count_ ) ) );
+
+    boost::int64_t count = 0;
+    for ( int i = 0; i < BUCKET_SIZE; ++i )
+    {
+        count += counts_[i];
+        if ( count >= rank )
+        {
+            return std::min( bucket_upper_bound( i ) * 0.001, max_msec_ );
+        }
+    }
+
+    return max_msec_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+StageProfiler::StageProfiler()
+    : M_enabled( false ),
+      M_cycle_mask( 0 )
+{
+    std::fill( M_cycle_usec, M_cycle_usec + STAGE_SIZE, 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+StageProfiler &
+StageProfiler::instance()
+{
+    static StageProfiler s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const char *
+StageProfiler::stage_name( const Stage stage )
+{
+    static const char * s_names[STAGE_SIZE] = {
+        "Strategy",
+        "MarkAnalyzer",
+        "FieldAnalyzer",
+        "ActionChain",
+        "GeneratorClear",
+        "RoleExecute",
+        "Total"
+    };
+
+    if ( stage < 0 || STAGE_SIZE <= stage )
+    {
+        return "Unknown";
+    }
+
+    return s_names[stage];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+StageProfiler::openTrace( const std::string & path )
+{
+    M_trace.open( path.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc );
+    if ( ! M_trace.is_open() )
+    {
+        std::cerr << "(StageProfiler::openTrace) could not open the file [" << path << "]"
+                  << std::endl;
+        return false;
+    }
+
+    M_enabled = true;
+
+    M_trace.write( "HPRF", 4 );
+    write_value( M_trace, TRACE_VERSION );
+    write_value( M_trace, static_cast< boost::uint32_t >( STAGE_SIZE ) );
+    for ( int i = 0; i < STAGE_SIZE; ++i )
+    {
+        const char * name = stage_name( static_cast< Stage >( i ) );
+        M_trace.write( name, std::strlen( name ) + 1 );
+    }
+
+    return M_trace.good();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+StageProfiler::record( const Stage stage,
+                       const double msec )
+{
+    if ( stage < 0 || STAGE_SIZE <= stage )
+    {
+        return;
+    }
+
+    M_histograms[stage].add( msec );
+
+    // the stage may be executed several times in one cycle
+    M_cycle_usec[stage] += to_usec( msec );
+    M_cycle_mask |= ( 1u << stage );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+StageProfiler::endCycle( const rcsc::GameTime & current )
+{
+    if ( M_cycle_mask == 0 )
+    {
+        return;
+    }
+
+    if ( M_trace.is_open() )
+    {
+        write_value( M_trace, static_cast< boost::int32_t >( current.cycle() ) );
+        write_value( M_trace, static_cast< boost::int32_t >( current.stopped() ) );
+        write_value( M_trace, M_cycle_mask );
+        M_trace.write( reinterpret_cast< const char * >( M_cycle_usec ),
+                       sizeof( M_cycle_usec ) );
+    }
+
+    std::fill( M_cycle_usec, M_cycle_usec + STAGE_SIZE, 0 );
+    M_cycle_mask = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+StageProfiler::print( std::ostream & os ) const
+{
+    os << "stage profile:\n";
+    os << std::setw( 16 ) << std::left << " stage"
+       << std::right
+       << std::setw( 8 ) << "count"
+       << std::setw( 10 ) << "ave_ms"
+       << std::setw( 10 ) << "p50_ms"
+       << std::setw( 10 ) << "p99_ms"
+       << std::setw( 10 ) << "max_ms"
+       << '\n';
+
+    for ( int i = 0; i < STAGE_SIZE; ++i )
+    {
+        const Histogram & h = M_histograms[i];
+
+        os << ' ' << std::setw( 15 ) << std::left << stage_name( static_cast< Stage >( i ) )
+           << std::right << std::fixed << std::setprecision( 3 )
+           << std::setw( 8 ) << h.total_count_
+           << std::setw( 10 ) << ( h.total_count_ > 0 ? h.total_msec_ / h.total_count_ : 0.0 )
+           << std::setw( 10 ) << h.percentile( 0.5 )
+           << std::setw( 10 ) << h.percentile( 0.99 )
+           << std::setw( 10 ) << h.max_msec_
+           << '\n';
+    }
+
+    return os << std::flush;
+}
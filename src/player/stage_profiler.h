@@ -0,0 +1,191 @@
+// -*-c++-*-
+
+/*!
+  \file stage_profiler.h
+  \brief per-cycle profiler of the decision stages Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef STAGE_PROFILER_H
+#define STAGE_PROFILER_H
+
+#include <rcsc/time/timer.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/optional.hpp>
+
+#include <iosfwd>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace rcsc {
+class GameTime;
+}
+
+/*!
+  \class StageProfiler
+  \brief elapsed time recorder for each stage of HeliosPlayer::actionImpl().
+
+  The elapsed time of each stage is accumulated into a log-linear
+  histogram (8 sub-buckets per power of two, microsecond resolution),
+  from which p50, p99 and max are reported at the end of the match.
+  The measured values of each cycle can also be written into the
+  binary trace file.
+
+  Trace file format (host byte order):
+  - header: "HPRF", uint32 version, uint32 stage size,
+            the stage names separated by '\0'
+  - record: int32 cycle, int32 stopped, uint32 stage mask,
+            uint32 elapsed [usec] x stage size
+*/
+class StageProfiler {
+public:
+
+    /*!
+      \brief measured stages
+     */
+    enum Stage {
+        STRATEGY_UPDATE,
+        MARK_ANALYZER_UPDATE,
+        FIELD_ANALYZER_UPDATE,
+        ACTION_CHAIN_UPDATE,
+        GENERATOR_CLEAR,
+        ROLE_EXECUTE,
+        ACTION_TOTAL,
+        STAGE_SIZE
+    };
+
+    /*!
+      \class Scope
+      \brief RAII timer. the elapsed time is recorded when this object is destructed.
+      The timer is not started if the profiler is disabled.
+     */
+    class Scope {
+    private:
+        Stage M_stage;
+        boost::optional< rcsc::Timer > M_timer;
+
+        // not used
+        Scope( const Scope & );
+        Scope & operator=( const Scope & );
+    public:
+        explicit
+        Scope( const Stage stage )
+            : M_stage( stage )
+          {
+              if ( StageProfiler::instance().isEnabled() )
+              {
+                  M_timer = rcsc::Timer();
+              }
+          }
+
+        ~Scope()
+          {
+              if ( M_timer )
+              {
+                  StageProfiler::instance().record( M_stage, M_timer->elapsedReal() );
+              }
+          }
+    };
+
+private:
+
+    /*!
+      \brief elapsed time histogram of one stage
+     */
+    struct Histogram {
+        std::vector< boost::int64_t > counts_;
+        boost::int64_t total_count_;
+        double total_msec_;
+        double max_msec_;
+
+        Histogram();
+
+        void add( const double msec );
+        double percentile( const double rate ) const;
+    };
+
+    bool M_enabled;
+
+    Histogram M_histograms[STAGE_SIZE];
+
+    //! elapsed time in the current cycle [usec]
+    boost::uint32_t M_cycle_usec[STAGE_SIZE];
+    //! bit mask of the stages measured in the current cycle
+    boost::uint32_t M_cycle_mask;
+
+    std::ofstream M_trace;
+
+    // not used
+    StageProfiler( const StageProfiler & );
+    StageProfiler & operator=( const StageProfiler & );
+
+    // private for singleton
+    StageProfiler();
+
+public:
+
+    static
+    StageProfiler & instance();
+
+    static
+    const char * stage_name( const Stage stage );
+
+    void setEnabled( const bool on ) { M_enabled = on; }
+    bool isEnabled() const { return M_enabled; }
+
+    /*!
+      \brief open the binary trace file. the profiler is also enabled.
+      \param path output file path
+      \return result of file open
+     */
+    bool openTrace( const std::string & path );
+
+    /*!
+      \brief add the elapsed time of the stage
+      \param stage measured stage
+      \param msec elapsed real time [ms]
+     */
+    void record( const Stage stage,
+                 const double msec );
+
+    /*!
+      \brief finish the current cycle. the trace record is written if the trace file is opened.
+      \param current current game time
+     */
+    void endCycle( const rcsc::GameTime & current );
+
+    /*!
+      \brief print the summary of all stages
+      \param os reference to the output stream
+      \return reference to the output stream
+     */
+    std::ostream & print( std::ostream & os ) const;
+
+};
+
+#endif
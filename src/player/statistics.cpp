@@ -46,7 +46,14 @@ Statistics::Statistics()
       M_max_action_evaluate_size( 0 ),
       M_min_action_evaluate_size( 10000000 ),
       M_total_action_search_msec( 0.0 ),
-      M_max_action_search_msec( 0.0 )
+      M_max_action_search_msec( 0.0 ),
+      M_action_search_time_over_count( 0 ),
+      M_transposition_lookup_count( 0 ),
+      M_transposition_hit_count( 0 ),
+      M_transposition_cut_count( 0 ),
+      M_transposition_memory_size( 0 ),
+      M_warm_start_count( 0 ),
+      M_warm_start_hit_count( 0 )
 {
 
 }
@@ -120,7 +127,8 @@ Statistics::processPostActionCallbacks()
  */
 void
 Statistics::setActionSearchData( const int evaluate_size,
-                                 const double elapsed_msec )
+                                 const double elapsed_msec,
+                                 const bool time_over )
 {
     M_total_action_search_count += 1;
     M_total_action_evaluate_size += evaluate_size;
@@ -140,6 +148,11 @@ Statistics::setActionSearchData( const int evaluate_size,
         M_max_action_search_msec = elapsed_msec;
     }
 
+    if ( time_over )
+    {
+        M_action_search_time_over_count += 1;
+    }
+
     // double r
     //     = static_cast< double >( M_total_action_search_count - 1 )
     //     / static_cast< double >( M_total_action_search_count );
@@ -148,3 +161,33 @@ Statistics::setActionSearchData( const int evaluate_size,
     //     = r * M_average_action_search_size
     //     + size / static_cast< double >( M_total_action_search_count );
 }
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Statistics::setTranspositionData( const int lookup_count,
+                                  const int hit_count,
+                                  const int cut_count,
+                                  const size_t memory_size )
+{
+    M_transposition_lookup_count += lookup_count;
+    M_transposition_hit_count += hit_count;
+    M_transposition_cut_count += cut_count;
+    M_transposition_memory_size = std::max( M_transposition_memory_size, memory_size );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Statistics::setWarmStartData( const bool hit )
+{
+    M_warm_start_count += 1;
+    if ( hit )
+    {
+        M_warm_start_hit_count += 1;
+    }
+}
@@ -36,6 +36,8 @@
 
 #include <boost/cstdint.hpp>
 
+#include <cstddef>
+
 class Statistics {
 private:
 
@@ -45,6 +47,15 @@ private:
     int M_min_action_evaluate_size;
     double M_total_action_search_msec;
     double M_max_action_search_msec;
+    int M_action_search_time_over_count;
+
+    boost::int64_t M_transposition_lookup_count;
+    boost::int64_t M_transposition_hit_count;
+    boost::int64_t M_transposition_cut_count;
+    size_t M_transposition_memory_size;
+
+    int M_warm_start_count;
+    int M_warm_start_hit_count;
 
     //! callback functions called in handleActionStart()
     PeriodicCallback::Cont M_pre_action_callbacks;
@@ -87,9 +98,33 @@ public:
     //
     //
 
+    /*!
+      \brief record the result of one action search
+      \param evaluate_size the number of evaluated nodes
+      \param elapsed_msec elapsed real time [ms]
+      \param time_over true if the search was stopped by the time budget
+     */
     void setActionSearchData( const int evaluate_size,
-                              const double elapsed_msec );
+                              const double elapsed_msec,
+                              const bool time_over = false );
+
+    /*!
+      \brief record the transposition table usage of one action search
+      \param lookup_count the number of table lookups
+      \param hit_count the number of lookups that found the same state
+      \param cut_count the number of dominated duplicates not expanded
+      \param memory_size allocated table size [bytes]
+     */
+    void setTranspositionData( const int lookup_count,
+                               const int hit_count,
+                               const int cut_count,
+                               const size_t memory_size );
 
+    /*!
+      \brief record the warm start result of one action search
+      \param hit true if the first action of the last best chain was generated again
+     */
+    void setWarmStartData( const bool hit );
 
     int totalActionSearchCount() const { return M_total_action_search_count; }
     boost::int64_t totalActionSearchSize() const { return M_total_action_evaluate_size; }
@@ -106,6 +141,29 @@ public:
       {
           return M_total_action_search_msec / M_total_action_search_count;
       }
+    int actionSearchTimeOverCount() const { return M_action_search_time_over_count; }
+
+    boost::int64_t transpositionLookupCount() const { return M_transposition_lookup_count; }
+    boost::int64_t transpositionHitCount() const { return M_transposition_hit_count; }
+    boost::int64_t transpositionCutCount() const { return M_transposition_cut_count; }
+    double transpositionHitRate() const
+      {
+          return ( M_transposition_lookup_count > 0
+                   ? static_cast< double >( M_transposition_hit_count )
+                   / static_cast< double >( M_transposition_lookup_count )
+                   : 0.0 );
+      }
+    size_t transpositionMemorySize() const { return M_transposition_memory_size; }
+
+    int warmStartCount() const { return M_warm_start_count; }
+    int warmStartHitCount() const { return M_warm_start_hit_count; }
+    double warmStartHitRate() const
+      {
+          return ( M_warm_start_count > 0
+                   ? static_cast< double >( M_warm_start_hit_count )
+                   / static_cast< double >( M_warm_start_count )
+                   : 0.0 );
+      }
 
 };
 
@@ -155,14 +155,14 @@ Strategy::init()
     // check role availability
     //
 
-    for ( FormationFactory::Map::const_iterator it = M_formation_factory.allFormationMap().begin(),
-              end = M_formation_factory.allFormationMap().end();
+    for ( FormationFactory::RoleNameMap::const_iterator it = M_formation_factory.roleNameMap().begin(),
+              end = M_formation_factory.roleNameMap().end();
           it != end;
           ++it )
     {
         for ( int unum = 1; unum < 11; ++unum )
         {
-            const std::string role_name = it->second->getRoleName( unum );
+            const std::string & role_name = it->second[unum - 1];
 
             if ( M_role_factory.find( role_name ) == M_role_factory.end() )
             {
@@ -451,7 +451,7 @@ Strategy::updateFormation( const WorldModel & wm )
     //
     {
         std::vector< Vector2D > positions;
-        f->getPositions( ball_pos, positions );
+        M_formation_factory.getPositions( f, ball_pos, positions );
 
         if ( positions.size() != 11 )
         {
@@ -477,7 +477,7 @@ Strategy::updateFormation( const WorldModel & wm )
         //const Vector2D opponent_ball_pos = wm.ball().inertiaPoint( opponent_step );
         const Vector2D opponent_ball_pos = FieldAnalyzer::get_field_bound_opponent_ball_pos( wm );
 
-        Vector2D goalie_position = gf->getPosition( goalie_unum, opponent_ball_pos );
+        Vector2D goalie_position = M_formation_factory.getPosition( gf, goalie_unum, opponent_ball_pos );
 
         if ( ! goalie_position.isValid() )
         {
@@ -164,6 +164,21 @@ public:
     PositionType getPositionType( const int unum ) const;
     rcsc::Vector2D getPosition( const int unum ) const;
 
+    /*!
+      \brief get the position of the player in the formation for the given ball position.
+      the precomputed grid is used if available.
+      \param f formation object
+      \param unum uniform number
+      \param ball_pos ball position
+      \return the position of the player
+     */
+    rcsc::Vector2D getFormationPosition( const rcsc::Formation::ConstPtr & f,
+                                         const int unum,
+                                         const rcsc::Vector2D & ball_pos ) const
+      {
+          return M_formation_factory.getPosition( f, unum, ball_pos );
+      }
+
     rcsc::Formation::ConstPtr getCornerKickPreFormation( const std::string & teamname ) const;
     rcsc::Formation::ConstPtr getCornerKickPostFormation( const std::string & teamname,
                                                           const std::string & cornerkick_type ) const;
@@ -0,0 +1,3 @@
+#!/bin/sh
+
+exec ./start.sh --offline-client-mode --chain-search-benchmark ${1+"$@"}
@@ -0,0 +1,782 @@
+#include "linear_rank_scorer.h"
+
+#include <svmrank/svm_struct_api.h>
+
+#include <rcsc/timer.h>
+
+#include <boost/cstdint.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+
+#include <pthread.h>
+#include <sys/types.h> // fstat
+#include <sys/stat.h> // fstat
+#include <sys/mman.h> // mmap, munmap, madvise
+#include <fcntl.h> // open
+#include <unistd.h> // close, sysconf
+
+/*
+  Binary rank data format. All values are little endian.
+
+    file header: magic "HRNK", uint32 version
+    record: float64 value,
+            uint16 qid length, qid characters,
+            uint32 feature size,
+            (uint32 feature number, float32 feature value) * feature size
+
+  The feature values are stored as float, because svmrank reads them as
+  float. The text converted from the binary file is the same as the
+  output of dlog_rank_extract except the comment lines.
+*/
+
+namespace {
+
+const char MAGIC[4] = { 'H', 'R', 'N', 'K' };
+const boost::uint32_t VERSION = 1;
+
+//! the number of finished files kept in memory per thread
+const size_t PENDING_PER_THREAD = 2;
+
+}
+
+void usage()
+{
+    std::cerr << "dlog_rank_pipeline [-j THREADS] [-m MODEL] -o OUTPUT LOG...\n"
+              << "  extract the rank data from the debug logs into the binary file.\n"
+              << "  if the linear svmrank model is given, the values are replaced by the model scores.\n"
+              << "dlog_rank_pipeline --to-text INPUT\n"
+              << "  print the binary rank data as the svmrank text format." << std::endl;
+}
+
+/*-------------------------------------------------------------------*/
+/*
+  binary writer/reader
+*/
+
+inline
+void
+put_u16( std::string & buf,
+         const boost::uint16_t v )
+{
+    buf += static_cast< char >( v & 0xff );
+    buf += static_cast< char >( ( v >> 8 ) & 0xff );
+}
+
+inline
+void
+put_u32( std::string & buf,
+         const boost::uint32_t v )
+{
+    buf += static_cast< char >( v & 0xff );
+    buf += static_cast< char >( ( v >> 8 ) & 0xff );
+    buf += static_cast< char >( ( v >> 16 ) & 0xff );
+    buf += static_cast< char >( ( v >> 24 ) & 0xff );
+}
+
+inline
+void
+put_u64( std::string & buf,
+         const boost::uint64_t v )
+{
+    put_u32( buf, static_cast< boost::uint32_t >( v & 0xffffffff ) );
+    put_u32( buf, static_cast< boost::uint32_t >( v >> 32 ) );
+}
+
+inline
+void
+put_f32( std::string & buf,
+         const float v )
+{
+    boost::uint32_t u;
+    std::memcpy( &u, &v, sizeof( u ) );
+    put_u32( buf, u );
+}
+
+inline
+void
+put_f64( std::string & buf,
+         const double v )
+{
+    boost::uint64_t u;
+    std::memcpy( &u, &v, sizeof( u ) );
+    put_u64( buf, u );
+}
+
+inline
+bool
+get_bytes( std::istream & is,
+           unsigned char * bytes,
+           const size_t n )
+{
+    return static_cast< bool >( is.read( reinterpret_cast< char * >( bytes ), n ) );
+}
+
+inline
+bool
+get_u16( std::istream & is,
+         boost::uint16_t * v )
+{
+    unsigned char b[2];
+    if ( ! get_bytes( is, b, 2 ) ) return false;
+    *v = static_cast< boost::uint16_t >( b[0] | ( b[1] << 8 ) );
+    return true;
+}
+
+inline
+bool
+get_u32( std::istream & is,
+         boost::uint32_t * v )
+{
+    unsigned char b[4];
+    if ( ! get_bytes( is, b, 4 ) ) return false;
+    *v = ( static_cast< boost::uint32_t >( b[0] )
+           | ( static_cast< boost::uint32_t >( b[1] ) << 8 )
+           | ( static_cast< boost::uint32_t >( b[2] ) << 16 )
+           | ( static_cast< boost::uint32_t >( b[3] ) << 24 ) );
+    return true;
+}
+
+inline
+bool
+get_f32( std::istream & is,
+         float * v )
+{
+    boost::uint32_t u;
+    if ( ! get_u32( is, &u ) ) return false;
+    std::memcpy( v, &u, sizeof( u ) );
+    return true;
+}
+
+inline
+bool
+get_f64( std::istream & is,
+         double * v )
+{
+    boost::uint32_t lo, hi;
+    if ( ! get_u32( is, &lo ) || ! get_u32( is, &hi ) ) return false;
+    const boost::uint64_t u = ( static_cast< boost::uint64_t >( hi ) << 32 ) | lo;
+    std::memcpy( v, &u, sizeof( u ) );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*
+  debug log parser
+*/
+
+/*!
+  parse the integer in [p, end). the pointer is moved to the next character.
+ */
+inline
+bool
+parse_int( const char ** p,
+           const char * end )
+{
+    const char * s = *p;
+    if ( s < end && ( *s == '-' || *s == '+' ) ) ++s;
+    const char * digits = s;
+    while ( s < end && '0' <= *s && *s <= '9' ) ++s;
+    if ( s == digits )
+    {
+        return false;
+    }
+    *p = s;
+    return true;
+}
+
+/*!
+  skip the line header "CYCLE,STOPPED LEVEL TYPE " of the debug log.
+  \return the start of the message. NULL if illegal format.
+ */
+inline
+const char *
+skip_line_header( const char * p,
+                  const char * end )
+{
+    if ( ! parse_int( &p, end ) || p == end || *p != ',' ) return 0;
+    ++p;
+    if ( ! parse_int( &p, end ) ) return 0;
+    while ( p < end && *p == ' ' ) ++p;
+    if ( ! parse_int( &p, end ) ) return 0;
+    while ( p < end && *p == ' ' ) ++p;
+    if ( p == end ) return 0;
+    ++p; // type character
+    while ( p < end && *p == ' ' ) ++p;
+    return p;
+}
+
+/*!
+  \brief worker-local buffers. reused for all lines to avoid the allocation.
+ */
+struct RankLine {
+    std::vector< char > text_; //!< null terminated copy of the rank data
+    std::vector< boost::uint32_t > ids_;
+    std::vector< float > values_;
+};
+
+/*!
+  parse "VALUE qid:QID FID:FVAL ..." and append the record to the output.
+  \return true if the record is appended.
+ */
+bool
+append_record( const char * begin,
+               const char * end,
+               const LinearRankScorer & scorer,
+               RankLine & line,
+               std::string & out )
+{
+    // strtod requires the null terminated string.
+    line.text_.assign( begin, end );
+    line.text_.push_back( '\0' );
+
+    char * p = &line.text_[0];
+    char * next = p;
+
+    const double value = std::strtod( p, &next );
+    if ( next == p ) return false;
+    p = next;
+
+    while ( *p == ' ' ) ++p;
+    if ( std::strncmp( p, "qid:", 4 ) != 0 ) return false;
+    p += 4;
+    const char * qid = p;
+    while ( *p != '\0' && *p != ' ' ) ++p;
+    const size_t qid_len = p - qid;
+    if ( qid_len == 0 || qid_len > 0xffff ) return false;
+
+    line.ids_.clear();
+    line.values_.clear();
+
+    while ( *p != '\0' )
+    {
+        while ( *p == ' ' ) ++p;
+        if ( *p == '\0' || *p == '#' ) break; // trailing comment
+
+        const long fid = std::strtol( p, &next, 10 );
+        if ( next == p || *next != ':' || fid <= 0 ) return false;
+        p = next + 1;
+
+        const double fval = std::strtod( p, &next );
+        if ( next == p ) return false;
+        p = next;
+
+        line.ids_.push_back( static_cast< boost::uint32_t >( fid ) );
+        line.values_.push_back( static_cast< float >( fval ) );
+    }
+
+    if ( line.ids_.empty() ) return false;
+
+    const double new_value = ( scorer.isValid()
+                               ? scorer.score( &line.ids_[0], &line.values_[0], line.ids_.size() )
+                               : value );
+
+    put_f64( out, new_value );
+    put_u16( out, static_cast< boost::uint16_t >( qid_len ) );
+    out.append( qid, qid_len );
+    put_u32( out, static_cast< boost::uint32_t >( line.ids_.size() ) );
+    for ( size_t i = 0; i < line.ids_.size(); ++i )
+    {
+        put_u32( out, line.ids_[i] );
+        put_f32( out, line.values_[i] );
+    }
+
+    return true;
+}
+
+/*!
+  extract all rank records of the mapped debug log.
+  \return the number of records
+ */
+size_t
+extract_rank_records( const std::string & filepath,
+                      const char * data,
+                      const size_t size,
+                      const LinearRankScorer & scorer,
+                      RankLine & line,
+                      std::string & out )
+{
+    size_t count = 0;
+    size_t n_line = 0;
+
+    const char * p = data;
+    const char * const data_end = data + size;
+
+    while ( p < data_end )
+    {
+        const char * eol = static_cast< const char * >( std::memchr( p, '\n', data_end - p ) );
+        const char * end = ( eol ? eol : data_end );
+        if ( end > p && *( end - 1 ) == '\r' ) --end;
+
+        ++n_line;
+
+        if ( end > p )
+        {
+            const char * msg = skip_line_header( p, end );
+            if ( ! msg )
+            {
+                std::cerr << filepath << ':' << n_line << ": Illegal Line ["
+                          << std::string( p, end ) << "]" << std::endl;
+            }
+            else if ( end - msg > 7
+                      && msg[0] == '('
+                      && ! std::strncmp( msg, "(rank) ", 7 )
+                      && msg[7] != '#' )
+            {
+                if ( append_record( msg + 7, end, scorer, line, out ) )
+                {
+                    ++count;
+                }
+                else
+                {
+                    std::cerr << filepath << ':' << n_line << ": Illegal rank data ["
+                              << std::string( msg + 7, end ) << "]" << std::endl;
+                }
+            }
+        }
+
+        p = ( eol ? eol + 1 : data_end );
+    }
+
+    return count;
+}
+
+/*!
+  map the debug log and extract the rank records.
+ */
+bool
+process_file( const std::string & filepath,
+              const LinearRankScorer & scorer,
+              RankLine & line,
+              std::string & out,
+              size_t * count )
+{
+    *count = 0;
+
+    int fd = ::open( filepath.c_str(), O_RDONLY );
+    if ( fd < 0 )
+    {
+        std::cerr << "ERROR: Could not open the file ["
+                  << filepath << "]" << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    if ( ::fstat( fd, &st ) != 0 )
+    {
+        ::close( fd );
+        return false;
+    }
+
+    if ( st.st_size == 0 )
+    {
+        ::close( fd );
+        return true;
+    }
+
+    void * addr = ::mmap( 0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    ::close( fd );
+
+    if ( addr == MAP_FAILED )
+    {
+        std::cerr << "ERROR: Could not map the file ["
+                  << filepath << "]" << std::endl;
+        return false;
+    }
+
+    ::madvise( addr, st.st_size, MADV_SEQUENTIAL );
+
+    *count = extract_rank_records( filepath,
+                                   static_cast< const char * >( addr ),
+                                   static_cast< size_t >( st.st_size ),
+                                   scorer, line, out );
+
+    ::munmap( addr, st.st_size );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*
+  parallel pipeline
+*/
+
+/*!
+  \brief shared state of the pipeline.
+
+  The worker threads take the files in the input order. The main thread
+  writes the finished buffers in the same order, so the output does not
+  depend on the number of threads. A worker waits before taking a new
+  file while too many finished buffers are waiting to be written, so
+  the memory usage is bounded by the window size.
+ */
+struct Pipeline {
+    const std::vector< std::string > * files_;
+    const LinearRankScorer * scorer_;
+
+    pthread_mutex_t mutex_;
+    pthread_cond_t done_cond_; //!< notify the writer of the finished file
+    pthread_cond_t space_cond_; //!< notify the workers of the written file
+
+    size_t window_; //!< the maximum number of files being processed or waiting
+    size_t next_file_; //!< index of the file to be taken next
+    size_t next_write_; //!< index of the file to be written next
+
+    std::vector< std::string > buffers_;
+    std::vector< size_t > counts_;
+    std::vector< char > done_;
+};
+
+void *
+worker_main( void * arg )
+{
+    Pipeline * pl = static_cast< Pipeline * >( arg );
+    RankLine line;
+
+    while ( true )
+    {
+        pthread_mutex_lock( &pl->mutex_ );
+        while ( pl->next_file_ < pl->files_->size()
+                && pl->next_file_ >= pl->next_write_ + pl->window_ )
+        {
+            pthread_cond_wait( &pl->space_cond_, &pl->mutex_ );
+        }
+
+        if ( pl->next_file_ >= pl->files_->size() )
+        {
+            pthread_mutex_unlock( &pl->mutex_ );
+            break;
+        }
+
+        const size_t index = pl->next_file_++;
+        pthread_mutex_unlock( &pl->mutex_ );
+
+        std::string out;
+        size_t count = 0;
+        process_file( (*pl->files_)[index], *pl->scorer_, line, out, &count );
+
+        pthread_mutex_lock( &pl->mutex_ );
+        pl->buffers_[index].swap( out );
+        pl->counts_[index] = count;
+        pl->done_[index] = 1;
+        pthread_cond_signal( &pl->done_cond_ );
+        pthread_mutex_unlock( &pl->mutex_ );
+    }
+
+    return static_cast< void * >( 0 );
+}
+
+/*!
+  process all files and write the records.
+  \return the number of records. -1 if error.
+ */
+long
+run_pipeline( const std::vector< std::string > & files,
+              const LinearRankScorer & scorer,
+              const size_t thread_size,
+              std::ostream & os )
+{
+    Pipeline pl;
+    pl.files_ = &files;
+    pl.scorer_ = &scorer;
+    pthread_mutex_init( &pl.mutex_, NULL );
+    pthread_cond_init( &pl.done_cond_, NULL );
+    pthread_cond_init( &pl.space_cond_, NULL );
+    pl.window_ = thread_size * PENDING_PER_THREAD;
+    pl.next_file_ = 0;
+    pl.next_write_ = 0;
+    pl.buffers_.resize( files.size() );
+    pl.counts_.resize( files.size(), 0 );
+    pl.done_.resize( files.size(), 0 );
+
+    std::vector< pthread_t > threads;
+    for ( size_t i = 0; i < thread_size; ++i )
+    {
+        pthread_t thread;
+        if ( pthread_create( &thread, NULL, &worker_main, &pl ) != 0 )
+        {
+            std::cerr << "ERROR: Could not create the thread." << std::endl;
+            break;
+        }
+        threads.push_back( thread );
+    }
+
+    if ( threads.empty() )
+    {
+        // process the files in this thread.
+        pl.window_ = files.size() + 1;
+        worker_main( &pl );
+    }
+
+    long total = 0;
+
+    pthread_mutex_lock( &pl.mutex_ );
+    while ( pl.next_write_ < files.size() )
+    {
+        while ( ! pl.done_[pl.next_write_] )
+        {
+            pthread_cond_wait( &pl.done_cond_, &pl.mutex_ );
+        }
+
+        std::string buf;
+        buf.swap( pl.buffers_[pl.next_write_] );
+        total += pl.counts_[pl.next_write_];
+        pthread_mutex_unlock( &pl.mutex_ );
+
+        os.write( buf.data(), buf.size() );
+        std::cerr << files[pl.next_write_] << ": " << pl.counts_[pl.next_write_]
+                  << " records" << std::endl;
+
+        pthread_mutex_lock( &pl.mutex_ );
+        ++pl.next_write_;
+        pthread_cond_broadcast( &pl.space_cond_ );
+    }
+    pthread_mutex_unlock( &pl.mutex_ );
+
+    for ( std::vector< pthread_t >::iterator it = threads.begin(), end = threads.end();
+          it != end;
+          ++it )
+    {
+        pthread_join( *it, NULL );
+    }
+
+    pthread_cond_destroy( &pl.done_cond_ );
+    pthread_cond_destroy( &pl.space_cond_ );
+    pthread_mutex_destroy( &pl.mutex_ );
+
+    return ( os ? total : -1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*
+  converter
+*/
+
+bool
+print_text( const std::string & infile,
+            std::ostream & os )
+{
+    std::ifstream fin( infile.c_str(), std::ios_base::in | std::ios_base::binary );
+    if ( ! fin.is_open() )
+    {
+        std::cerr << "ERROR: Could not open the file ["
+                  << infile << "]" << std::endl;
+        return false;
+    }
+
+    char magic[4];
+    boost::uint32_t version = 0;
+    if ( ! fin.read( magic, sizeof( magic ) )
+         || std::memcmp( magic, MAGIC, sizeof( MAGIC ) ) != 0
+         || ! get_u32( fin, &version )
+         || version != VERSION )
+    {
+        std::cerr << "ERROR: Illegal binary rank data ["
+                  << infile << "]" << std::endl;
+        return false;
+    }
+
+    std::string qid;
+
+    while ( fin.peek() != std::char_traits< char >::eof() )
+    {
+        double value;
+        boost::uint16_t qid_len;
+        boost::uint32_t size;
+
+        if ( ! get_f64( fin, &value )
+             || ! get_u16( fin, &qid_len ) )
+        {
+            std::cerr << "ERROR: Truncated record in [" << infile << "]" << std::endl;
+            return false;
+        }
+
+        qid.resize( qid_len );
+        if ( ! fin.read( &qid[0], qid_len )
+             || ! get_u32( fin, &size ) )
+        {
+            std::cerr << "ERROR: Truncated record in [" << infile << "]" << std::endl;
+            return false;
+        }
+
+        os << value << " qid:" << qid;
+
+        for ( boost::uint32_t i = 0; i < size; ++i )
+        {
+            boost::uint32_t fid;
+            float fval;
+            if ( ! get_u32( fin, &fid )
+                 || ! get_f32( fin, &fval ) )
+            {
+                os << '\n';
+                std::cerr << "ERROR: Truncated record in [" << infile << "]" << std::endl;
+                return false;
+            }
+
+            os << ' ' << fid << ':' << fval;
+        }
+        os << '\n';
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*
+  model
+*/
+
+/*!
+  \brief svmrank model holder
+ */
+class Model {
+private:
+    svmrank::STRUCTMODEL M_model;
+    svmrank::STRUCT_LEARN_PARM M_learn_param;
+
+    // not used
+    Model( const Model & );
+    Model & operator=( const Model & );
+
+public:
+
+    Model()
+      {
+          M_model.svm_model = NULL;
+      }
+
+    ~Model()
+      {
+          if ( M_model.svm_model != NULL )
+          {
+              svmrank::free_struct_model( M_model );
+          }
+      }
+
+    bool read( const std::string & modelfile,
+               LinearRankScorer * scorer )
+      {
+          M_model = svmrank::read_struct_model( modelfile.c_str(), &M_learn_param );
+          if ( M_model.svm_model == NULL )
+          {
+              std::cerr << "ERROR: failed to read svmrank model file ["
+                        << modelfile << "]" << std::endl;
+              return false;
+          }
+
+          if ( M_model.svm_model->kernel_parm.kernel_type != svmrank::LINEAR )
+          {
+              std::cerr << "ERROR: only the linear kernel is supported."
+                        << " use dlog_evaluator_svmrank for the kernel model." << std::endl;
+              return false;
+          }
+
+          svmrank::add_weight_vector_to_linear_model( M_model.svm_model );
+          M_model.w = M_model.svm_model->lin_weights;
+
+          return scorer->assign( M_model.svm_model, 0 );
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+main( int argc, char **argv )
+{
+    std::string modelfile;
+    std::string outfile;
+    std::string textfile;
+    long thread_size = ::sysconf( _SC_NPROCESSORS_ONLN );
+    std::vector< std::string > files;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( ! std::strcmp( argv[i], "-j" ) && i + 1 < argc )
+        {
+            thread_size = std::atol( argv[++i] );
+        }
+        else if ( ! std::strcmp( argv[i], "-m" ) && i + 1 < argc )
+        {
+            modelfile = argv[++i];
+        }
+        else if ( ! std::strcmp( argv[i], "-o" ) && i + 1 < argc )
+        {
+            outfile = argv[++i];
+        }
+        else if ( ! std::strcmp( argv[i], "--to-text" ) && i + 1 < argc )
+        {
+            textfile = argv[++i];
+        }
+        else if ( argv[i][0] == '-' )
+        {
+            usage();
+            return 1;
+        }
+        else
+        {
+            files.push_back( argv[i] );
+        }
+    }
+
+    if ( ! textfile.empty() )
+    {
+        return ( print_text( textfile, std::cout ) ? 0 : 1 );
+    }
+
+    if ( outfile.empty()
+         || files.empty() )
+    {
+        usage();
+        return 1;
+    }
+
+    if ( thread_size < 1 )
+    {
+        thread_size = 1;
+    }
+
+    Model model;
+    LinearRankScorer scorer;
+    if ( ! modelfile.empty()
+         && ! model.read( modelfile, &scorer ) )
+    {
+        return 1;
+    }
+
+    std::ofstream fout( outfile.c_str(), std::ios_base::out | std::ios_base::binary );
+    if ( ! fout.is_open() )
+    {
+        std::cerr << "ERROR: Could not open the file ["
+                  << outfile << "]" << std::endl;
+        return 1;
+    }
+
+    {
+        std::string header( MAGIC, sizeof( MAGIC ) );
+        put_u32( header, VERSION );
+        fout.write( header.data(), header.size() );
+    }
+
+    rcsc::Timer timer;
+
+    const long total = run_pipeline( files, scorer, static_cast< size_t >( thread_size ), fout );
+    fout.flush();
+
+    if ( total < 0
+         || ! fout )
+    {
+        std::cerr << "ERROR: Could not write the file ["
+                  << outfile << "]" << std::endl;
+        return 1;
+    }
+
+    std::cerr << "wrote " << total << " records from " << files.size() << " files to ["
+              << outfile << "] " << timer.elapsedReal() << " [ms]" << std::endl;
+
+    return 0;
+}
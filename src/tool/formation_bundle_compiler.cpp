@@ -0,0 +1,236 @@
+#include "formation_bundle.h"
+
+#include <rcsc/formation/formation.h>
+#include <rcsc/timer.h>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+#include <sys/types.h> // opendir, readdir, closedir
+#include <dirent.h> // opendir, readdir, closedir
+
+void usage()
+{
+    std::cerr << "formation_bundle_compiler [--benchmark] FORMATION_DIR BUNDLE_FILE" << std::endl;
+}
+
+std::string
+append_last_separator( std::string dir )
+{
+    if ( dir.empty() )
+    {
+        dir = "./";
+    }
+    else if ( *dir.rbegin() != '/' )
+    {
+        dir += '/';
+    }
+    return dir;
+}
+
+bool
+list_formation_files( const std::string & dir,
+                      std::vector< std::string > * filenames )
+{
+    DIR * dp = opendir( dir.c_str() );
+    if ( ! dp )
+    {
+        std::cerr << "ERROR: Could not open the directory ["
+                  << dir << "]" << std::endl;
+        return false;
+    }
+
+    struct dirent * dent;
+    while ( ( dent = readdir( dp ) ) != NULL )
+    {
+        std::string filename = dent->d_name;
+        if ( filename.length() > 5
+             && filename.compare( filename.length() - 5, 5, ".conf" ) == 0 )
+        {
+            filenames->push_back( filename );
+        }
+    }
+    closedir( dp );
+
+    std::sort( filenames->begin(), filenames->end() );
+    return true;
+}
+
+rcsc::Formation::Ptr
+read_formation( std::istream & is )
+{
+    rcsc::Formation::Ptr f = rcsc::Formation::create( is );
+    if ( f
+         && ! f->read( is ) )
+    {
+        f.reset();
+    }
+    return f;
+}
+
+bool
+read_file( const std::string & filepath,
+           std::string * text )
+{
+    std::ifstream fin( filepath.c_str() );
+    if ( ! fin.is_open() )
+    {
+        return false;
+    }
+
+    std::ostringstream ostr;
+    ostr << fin.rdbuf();
+    *text = ostr.str();
+    return true;
+}
+
+/*!
+  compare the startup cost of the formation files and the bundle.
+ */
+void
+benchmark( const std::string & dir,
+           const std::vector< std::string > & filenames,
+           const std::string & bundle_file )
+{
+    {
+        rcsc::Timer timer;
+        int count = 0;
+        for ( std::vector< std::string >::const_iterator it = filenames.begin();
+              it != filenames.end();
+              ++it )
+        {
+            std::ifstream fin( ( dir + *it ).c_str() );
+            if ( read_formation( fin ) )
+            {
+                ++count;
+            }
+        }
+        std::cout << "text files: read " << count << " formations "
+                  << timer.elapsedReal() << " [ms]" << std::endl;
+    }
+
+    {
+        rcsc::Timer timer;
+        FormationBundle bundle;
+        if ( ! bundle.open( bundle_file ) )
+        {
+            std::cerr << "ERROR: Could not open the bundle ["
+                      << bundle_file << "]" << std::endl;
+            return;
+        }
+        std::cout << "bundle: open index " << bundle.entries().size() << " formations "
+                  << timer.elapsedReal() << " [ms]" << std::endl;
+
+        int count = 0;
+        std::string text;
+        for ( FormationBundle::Map::const_iterator it = bundle.entries().begin();
+              it != bundle.entries().end();
+              ++it )
+        {
+            if ( bundle.getText( it->first, &text ) )
+            {
+                std::istringstream istr( text );
+                if ( read_formation( istr ) )
+                {
+                    ++count;
+                }
+            }
+        }
+        std::cout << "bundle: open and create " << count << " formations "
+                  << timer.elapsedReal() << " [ms]" << std::endl;
+    }
+}
+
+int
+main( int argc, char **argv )
+{
+    bool do_benchmark = false;
+    std::vector< std::string > args;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( ! std::strcmp( argv[i], "--benchmark" ) )
+        {
+            do_benchmark = true;
+        }
+        else
+        {
+            args.push_back( argv[i] );
+        }
+    }
+
+    if ( args.size() != 2 )
+    {
+        usage();
+        return 1;
+    }
+
+    const std::string dir = append_last_separator( args[0] );
+    const std::string bundle_file = args[1];
+
+    std::vector< std::string > filenames;
+    if ( ! list_formation_files( dir, &filenames ) )
+    {
+        return 1;
+    }
+
+    std::vector< FormationBundle::Entry > entries;
+    std::vector< std::string > texts;
+
+    for ( std::vector< std::string >::const_iterator it = filenames.begin();
+          it != filenames.end();
+          ++it )
+    {
+        std::string text;
+        if ( ! read_file( dir + *it, &text ) )
+        {
+            std::cerr << "ERROR: Could not open the file ["
+                      << *it << "]" << std::endl;
+            return 1;
+        }
+
+        // validate the formation before it is packed.
+        std::istringstream istr( text );
+        rcsc::Formation::Ptr f = read_formation( istr );
+        if ( ! f )
+        {
+            std::cerr << "ERROR: Illegal formation file ["
+                      << *it << "]" << std::endl;
+            return 1;
+        }
+
+        FormationBundle::Entry entry;
+        entry.name_ = *it;
+        for ( int unum = 1; unum <= 11; ++unum )
+        {
+            entry.role_names_.push_back( f->getRoleName( unum ) );
+        }
+        entry.offset_ = 0;
+        entry.size_ = 0;
+
+        entries.push_back( entry );
+        texts.push_back( text );
+    }
+
+    if ( ! FormationBundle::write( bundle_file, entries, texts ) )
+    {
+        std::cerr << "ERROR: Could not write the bundle ["
+                  << bundle_file << "]" << std::endl;
+        return 1;
+    }
+
+    std::cout << "wrote " << entries.size() << " formations to ["
+              << bundle_file << "]" << std::endl;
+
+    if ( do_benchmark )
+    {
+        benchmark( dir, filenames, bundle_file );
+    }
+
+    return 0;
+}